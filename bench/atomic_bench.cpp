@@ -0,0 +1,128 @@
+#include <gflags/gflags.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "bench/common/harness.h"
+#include "core/util/atomic.h"
+#include "core/util/logging.h"
+
+DEFINE_string(threads, "1,2,4,8", "comma separated thread counts");
+DEFINE_uint64(n, 1 << 22, "operations per thread");
+DEFINE_uint32(hot, 16, "number of contended slots");
+
+namespace legacy {
+
+// The `__sync` based helpers that `core/util/atomic.h` used to provide, kept
+// here as the baseline.
+template <class ET>
+inline bool CAS(ET* ptr, ET oldv, ET newv) {
+  if (sizeof(ET) == 8) {
+    return __sync_bool_compare_and_swap((long*)ptr, *((long*)&oldv),
+                                        *((long*)&newv));
+  } else if (sizeof(ET) == 4) {
+    return __sync_bool_compare_and_swap((int*)ptr, *((int*)&oldv),
+                                        *((int*)&newv));
+  } else {
+    return __sync_bool_compare_and_swap((unsigned short*)ptr,
+                                        *((unsigned short*)&oldv),
+                                        *((unsigned short*)&newv));
+  }
+}
+
+template <class ET>
+inline bool WriteMin(ET* a, ET b) {
+  ET c;
+  bool r = 0;
+  do c = *a;
+  while (c > b && !(r = CAS(a, c, b)));
+  return r;
+}
+
+template <class ET>
+inline void WriteAdd(ET* a, ET b) {
+  volatile ET newV, oldV;
+  do {
+    oldV = *a;
+    newV = oldV + b;
+  } while (!CAS(a, oldV, newV));
+}
+
+}  // namespace legacy
+
+namespace {
+
+namespace bench = sics::graph::bench;
+
+// Run `op(slots, thread_id, i)` FLAGS_n times on each thread, for every
+// thread count of FLAGS_threads, over FLAGS_hot contended slots.
+template <typename T, typename Op>
+void Run(const std::string& name, T init, Op op) {
+  for (auto num_threads : bench::ParseUintList(FLAGS_threads)) {
+    std::vector<T> slots(FLAGS_hot, init);
+    auto seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      for (uint64_t i = 0; i < FLAGS_n; i++) {
+        op(slots.data(), t, i);
+      }
+    });
+    bench::Report(name, num_threads, num_threads * FLAGS_n, seconds);
+  }
+}
+
+// Cheap per-thread value stream, so that only a fraction of WriteMin calls
+// can win, as in SSSP relaxation.
+inline uint32_t Value(uint32_t t, uint64_t i) {
+  return (uint32_t)((i * 2654435761u) ^ (t * 40503u)) | 1u;
+}
+
+}  // namespace
+
+using namespace sics::graph::core::util;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_hot == 0) FLAGS_hot = 1;
+  auto hot = FLAGS_hot;
+
+  Run<uint32_t>("legacy WriteMin<u32>", std::numeric_limits<uint32_t>::max(),
+                [hot](uint32_t* s, uint32_t t, uint64_t i) {
+                  legacy::WriteMin(s + i % hot, Value(t, i));
+                });
+  Run<uint32_t>("atomic WriteMin<u32>", std::numeric_limits<uint32_t>::max(),
+                [hot](uint32_t* s, uint32_t t, uint64_t i) {
+                  atomic::WriteMin(s + i % hot, Value(t, i));
+                });
+  Run<uint64_t>("atomic WriteMin<u64>", std::numeric_limits<uint64_t>::max(),
+                [hot](uint64_t* s, uint32_t t, uint64_t i) {
+                  atomic::WriteMin(s + i % hot, (uint64_t)Value(t, i));
+                });
+  Run<uint16_t>("atomic WriteMin<u16>", std::numeric_limits<uint16_t>::max(),
+                [hot](uint16_t* s, uint32_t t, uint64_t i) {
+                  atomic::WriteMin(s + i % hot, (uint16_t)Value(t, i));
+                });
+
+  Run<uint32_t>("legacy WriteAdd<u32>", 0,
+                [hot](uint32_t* s, uint32_t t, uint64_t i) {
+                  legacy::WriteAdd(s + i % hot, 1u);
+                });
+  Run<uint32_t>("atomic WriteAdd<u32>", 0,
+                [hot](uint32_t* s, uint32_t t, uint64_t i) {
+                  atomic::WriteAdd(s + i % hot, 1u);
+                });
+  Run<uint64_t>("atomic WriteAdd<u64>", 0,
+                [hot](uint64_t* s, uint32_t t, uint64_t i) {
+                  atomic::WriteAdd(s + i % hot, (uint64_t)1);
+                });
+
+  Run<float>("legacy WriteAdd<float>", 0,
+             [hot](float* s, uint32_t t, uint64_t i) {
+               legacy::WriteAdd(s + i % hot, 0.5f);
+             });
+  Run<float>("atomic WriteAdd<float>", 0,
+             [hot](float* s, uint32_t t, uint64_t i) {
+               atomic::WriteAdd(s + i % hot, 0.5f);
+             });
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include <gflags/gflags.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "bench/common/harness.h"
+#include "core/common/bitmap.h"
+
+DEFINE_string(threads, "1,2,4,8", "comma separated thread counts");
+DEFINE_uint64(size, 1 << 26, "number of bits in the bitmap");
+DEFINE_uint64(n, 1 << 22, "operations per thread");
+DEFINE_uint32(count_rounds, 8, "full Count() passes per thread");
+
+using namespace sics::graph;
+using core::common::Bitmap;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  auto size = FLAGS_size;
+  auto n = FLAGS_n;
+
+  for (auto num_threads : bench::ParseUintList(FLAGS_threads)) {
+    Bitmap bitmap(size);
+    auto seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      for (uint64_t i = 0; i < n; i++) bitmap.SetBit(bench::Hash(t, i) % size);
+    });
+    bench::Report("Bitmap::SetBit random", num_threads, num_threads * n,
+                  seconds);
+
+    // Each thread sets bits of its own range, as a partitioned vertex loop
+    // does; only the words at the range borders are shared.
+    bitmap.Clear();
+    seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      uint64_t range = size / num_threads;
+      for (uint64_t i = 0; i < n; i++) bitmap.SetBit(t * range + i % range);
+    });
+    bench::Report("Bitmap::SetBit sequential", num_threads, num_threads * n,
+                  seconds);
+
+    std::vector<uint64_t> hits(num_threads, 0);
+    seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      uint64_t hit = 0;
+      for (uint64_t i = 0; i < n; i++) {
+        hit += bitmap.GetBit(bench::Hash(t, i) % size);
+      }
+      hits[t] = hit;
+    });
+    bench::Report("Bitmap::GetBit random", num_threads, num_threads * n,
+                  seconds);
+
+    // Count() is sequential, so measure it in words scanned.
+    seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      for (uint32_t r = 0; r < FLAGS_count_rounds; r++) {
+        hits[t] += bitmap.Count();
+      }
+    });
+    bench::Report("Bitmap::Count (per word)", num_threads,
+                  num_threads * FLAGS_count_rounds * ((size + 63) / 64),
+                  seconds);
+  }
+  return 0;
+}
@@ -0,0 +1,171 @@
+// @DESCRIPTION: microbenchmarks of the block graph: the MutableBlockCSRGraph
+// accessors over a generated graph held in memory, per thread count, and the
+// io_uring read throughput of CSREdgeBlockReader2 per sub-block size. The
+// graph is generated into `work_dir` once per sub-block size.
+
+#include <fcntl.h>
+#include <gflags/gflags.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "bench/common/graph_generator.h"
+#include "bench/common/harness.h"
+#include "core/data_structures/graph/mutable_block_csr_graph.h"
+#include "core/io/csr_edge_block_reader2.h"
+#include "core/scheduler/edge_buffer2.h"
+
+DEFINE_string(threads, "1,2,4,8", "comma separated thread counts");
+DEFINE_string(work_dir, "/tmp/block_bench/", "directory for the graphs");
+DEFINE_uint32(scale, 20, "log2 of the number of vertices of the rmat graph");
+DEFINE_uint32(edge_factor, 16, "number of generated edges per vertex");
+DEFINE_uint32(offset_ratio, 64, "offset compress ratio");
+DEFINE_string(cut_v, "16384,131072,1048576",
+              "comma separated vertices per sub-block to read with");
+DEFINE_uint64(n, 1 << 22, "accessor calls per thread");
+DEFINE_bool(drop_cache, true,
+            "evict the sub-block files from the page cache before reading");
+
+using namespace sics::graph;
+using core::data_structures::TwoDMetadata;
+using core::data_structures::graph::MutableBlockCSRGraph;
+
+namespace {
+
+void InitGraphs(const std::string& root_path, TwoDMetadata* meta,
+                std::vector<MutableBlockCSRGraph>* graphs) {
+  graphs->resize(meta->num_blocks);
+  for (uint32_t i = 0; i < meta->num_blocks; i++) {
+    graphs->at(i).Init(root_path, &meta->blocks.at(i));
+  }
+}
+
+// Read every sub-block of block 0 into memory with plain reads.
+void LoadSubBlocks(const std::string& root_path, TwoDMetadata* meta,
+                   MutableBlockCSRGraph* graph) {
+  auto& block = meta->blocks.at(0);
+  for (auto& sub_block : block.sub_blocks) {
+    auto path = root_path + "graphs/0_blocks/" + std::to_string(sub_block.id) +
+                ".bin";
+    std::ifstream file(path, std::ios::binary);
+    file.read((char*)graph->ApplySubBlockBuffer(sub_block.id),
+              sub_block.num_edges * sizeof(bench::VertexID));
+  }
+}
+
+void BenchAccessors(const std::string& root_path) {
+  TwoDMetadata meta(root_path);
+  std::vector<MutableBlockCSRGraph> graphs;
+  InitGraphs(root_path, &meta, &graphs);
+  auto& graph = graphs.at(0);
+  LoadSubBlocks(root_path, &meta, &graph);
+  auto num_vertices = meta.blocks.at(0).num_vertices;
+  auto n = FLAGS_n;
+
+  for (auto num_threads : bench::ParseUintList(FLAGS_threads)) {
+    std::vector<uint64_t> sums(num_threads, 0);
+    auto seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      uint64_t sum = 0;
+      for (uint64_t i = 0; i < n; i++) {
+        sum += graph.GetOutOffset(bench::Hash(t, i) % num_vertices);
+      }
+      sums[t] = sum;
+    });
+    bench::Report("GetOutOffset random", num_threads, num_threads * n,
+                  seconds);
+
+    // Each thread scans the neighbors of its own vertex range, as
+    // ParallelVertexDoWithEdges does, counted in edges.
+    std::vector<uint64_t> edges(num_threads, 0);
+    seconds = bench::RunOnThreads(num_threads, [&](uint32_t t) {
+      uint64_t sum = 0, num_edges = 0;
+      uint64_t range = (num_vertices + num_threads - 1) / num_threads;
+      uint64_t end = std::min((t + 1) * range, (uint64_t)num_vertices);
+      for (uint64_t v = t * range; v < end; v++) {
+        auto degree = graph.GetOutDegree(v);
+        auto neighbors = graph.GetOutEdges(v);
+        for (uint32_t j = 0; j < degree; j++) sum += neighbors[j];
+        num_edges += degree;
+      }
+      sums[t] = sum;
+      edges[t] = num_edges;
+    });
+    uint64_t total_edges = 0;
+    for (auto e : edges) total_edges += e;
+    bench::Report("GetOutEdges scan (per edge)", num_threads, total_edges,
+                  seconds);
+  }
+  graph.ReleaseAllSubBlocks();
+}
+
+void DropCache(const std::string& root_path, const TwoDMetadata& meta) {
+  for (auto& sub_block : meta.blocks.at(0).sub_blocks) {
+    auto path = root_path + "graphs/0_blocks/" + std::to_string(sub_block.id) +
+                ".bin";
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) continue;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+}
+
+// Read all sub-blocks of block 0 through CSREdgeBlockReader2, keeping QD
+// requests in flight as LoaderOp2 does.
+void BenchReader(const std::string& root_path, uint32_t cut_v) {
+  TwoDMetadata meta(root_path);
+  std::vector<MutableBlockCSRGraph> graphs;
+  InitGraphs(root_path, &meta, &graphs);
+  core::scheduler::EdgeBuffer2 buffer(&meta, &graphs);
+  core::io::CSREdgeBlockReader2 reader;
+  reader.Init(root_path, &meta, &buffer, &graphs);
+  if (FLAGS_drop_cache) DropCache(root_path, meta);
+
+  auto num_sub_blocks = meta.blocks.at(0).num_sub_blocks;
+  size_t submitted = 0, received = 0;
+  auto begin = std::chrono::steady_clock::now();
+  while (received < num_sub_blocks) {
+    std::vector<core::common::BlockID> reqs;
+    while (submitted < num_sub_blocks && submitted - received < QD) {
+      reqs.push_back(submitted++);
+    }
+    if (!reqs.empty()) reader.Read(0, reqs);
+    received += reader.GetBlockReady();
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<double>(end - begin).count();
+  auto bytes = meta.blocks.at(0).num_edges * sizeof(bench::VertexID);
+  LOGF_INFO(
+      "{:<32} cut_v: {:>8} sub-blocks: {:>5} time: {:.3f} s, {:.1f} MB/s, "
+      "{:.1f} us/sub-block",
+      "CSREdgeBlockReader2 read", cut_v, num_sub_blocks, seconds,
+      bytes / seconds / 1024 / 1024, seconds * 1e6 / num_sub_blocks);
+  graphs.at(0).ReleaseAllSubBlocks();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  core::common::ThreadPool thread_pool(std::thread::hardware_concurrency());
+  bench::VertexID num_vertices = (bench::VertexID)1 << FLAGS_scale;
+  auto edges = bench::GenerateRMAT(FLAGS_scale, FLAGS_edge_factor, 0.57, 0.19,
+                                   0.19, 1, &thread_pool);
+  bench::ScrambleIDs(num_vertices, 1, &thread_pool, &edges);
+  auto graph = bench::BuildCSR(num_vertices, edges, true, &thread_pool);
+  std::vector<bench::Edge>().swap(edges);
+  thread_pool.StopAndJoin();
+
+  auto cut_vs = bench::ParseUintList(FLAGS_cut_v);
+  for (size_t i = 0; i < cut_vs.size(); i++) {
+    auto root_path = FLAGS_work_dir + "cut_" + std::to_string(cut_vs[i]) + "/";
+    bench::WriteBlocks(root_path, graph, 1, cut_vs[i], FLAGS_offset_ratio);
+    if (i == 0) BenchAccessors(root_path);
+    BenchReader(root_path, cut_vs[i]);
+    std::filesystem::remove_all(root_path);
+  }
+  return 0;
+}
@@ -0,0 +1,438 @@
+#ifndef BENCH_COMMON_GRAPH_GENERATOR_H_
+#define BENCH_COMMON_GRAPH_GENERATOR_H_
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/common/multithreading/thread_pool.h"
+#include "core/common/types.h"
+#include "core/data_structures/graph_metadata.h"
+#include "core/util/atomic.h"
+#include "core/util/logging.h"
+#include "tools/common/data_structures.h"
+
+namespace sics::graph::bench {
+
+using core::common::EdgeIndex;
+using core::common::EdgeWeight;
+using core::common::VertexDegree;
+using core::common::VertexID;
+using tools::common::Edge;
+
+// A whole graph in CSR, laid out as the block files expect it: `offset` has
+// one entry per vertex and the degree of the last vertex closes the range.
+struct GeneratedGraph {
+  EdgeIndex GetNumEdges() const { return edges.size(); }
+
+  VertexID num_vertices = 0;
+  std::vector<VertexDegree> degree;
+  std::vector<EdgeIndex> offset;
+  std::vector<VertexID> edges;
+  // parallel to `edges`, empty for an unweighted graph.
+  std::vector<EdgeWeight> weights;
+  // The transpose, in the same layout, empty unless built by BuildInEdges.
+  std::vector<VertexDegree> in_degree;
+  std::vector<EdgeIndex> in_offset;
+  std::vector<VertexID> in_edges;
+};
+
+// Edges are generated in chunks of this size, each chunk with its own random
+// engine seeded from the global seed and the chunk index, so the output only
+// depends on the seed and not on the number of threads.
+inline constexpr EdgeIndex kGenerateChunkSize = 1 << 16;
+
+// Run `func(begin, end)` over [0, num_items) in parallel, in ranges of at
+// least `min_range` items.
+template <typename Func>
+void ParallelFor(size_t num_items, size_t min_range,
+                 core::common::ThreadPool* thread_pool, Func&& func) {
+  size_t num_tasks = thread_pool->GetParallelism() * 4;
+  size_t range = std::max((num_items + num_tasks - 1) / num_tasks, min_range);
+  core::common::TaskPackage tasks;
+  for (size_t begin = 0; begin < num_items; begin += range) {
+    size_t end = std::min(begin + range, num_items);
+    tasks.push_back([&func, begin, end]() { func(begin, end); });
+  }
+  thread_pool->SubmitSync(tasks);
+}
+
+template <typename EdgeFunc>
+std::vector<Edge> GenerateEdges(EdgeIndex num_edges, uint64_t seed,
+                                core::common::ThreadPool* thread_pool,
+                                EdgeFunc&& edge_func) {
+  std::vector<Edge> edges(num_edges);
+  EdgeIndex num_chunks = (num_edges + kGenerateChunkSize - 1) /
+                         kGenerateChunkSize;
+  ParallelFor(num_chunks, 1, thread_pool, [&](size_t begin, size_t end) {
+    for (size_t chunk = begin; chunk < end; chunk++) {
+      std::mt19937_64 rng(seed * 0x9E3779B97F4A7C15ULL + chunk);
+      EdgeIndex chunk_end =
+          std::min((chunk + 1) * kGenerateChunkSize, num_edges);
+      for (EdgeIndex i = chunk * kGenerateChunkSize; i < chunk_end; i++) {
+        edges[i] = edge_func(rng);
+      }
+    }
+  });
+  return edges;
+}
+
+// @DESCRIPTION: generate edge_factor * 2^scale edges of an RMAT (Kronecker)
+// graph over 2^scale vertices. Each edge picks one quadrant of the adjacency
+// matrix per level with probabilities a, b, c and 1 - a - b - c, which gives
+// the skewed degree distribution of real world graphs.
+inline std::vector<Edge> GenerateRMAT(uint32_t scale, uint32_t edge_factor,
+                                      double a, double b, double c,
+                                      uint64_t seed,
+                                      core::common::ThreadPool* thread_pool) {
+  if (scale >= 32) LOG_FATAL("RMAT scale must be less than 32");
+  if (a + b + c >= 1) LOG_FATAL("RMAT requires a + b + c < 1");
+  EdgeIndex num_edges = ((EdgeIndex)edge_factor) << scale;
+  double ab = a + b, abc = a + b + c;
+  return GenerateEdges(num_edges, seed, thread_pool, [=](auto& rng) {
+    std::uniform_real_distribution<double> dist(0, 1);
+    VertexID src = 0, dst = 0;
+    for (uint32_t level = 0; level < scale; level++) {
+      double r = dist(rng);
+      src <<= 1;
+      dst <<= 1;
+      if (r >= abc) {
+        src |= 1;
+        dst |= 1;
+      } else if (r >= ab) {
+        src |= 1;
+      } else if (r >= a) {
+        dst |= 1;
+      }
+    }
+    return Edge(src, dst);
+  });
+}
+
+// @DESCRIPTION: generate `num_edges` edges with uniformly random endpoints in
+// [0, num_vertices), i.e. an Erdos-Renyi like graph.
+inline std::vector<Edge> GenerateUniform(
+    VertexID num_vertices, EdgeIndex num_edges, uint64_t seed,
+    core::common::ThreadPool* thread_pool) {
+  return GenerateEdges(num_edges, seed, thread_pool, [=](auto& rng) {
+    std::uniform_int_distribution<VertexID> dist(0, num_vertices - 1);
+    VertexID src = dist(rng);
+    return Edge(src, dist(rng));
+  });
+}
+
+// @DESCRIPTION: relabel all vertices with a random permutation. RMAT puts
+// the hubs at small IDs, which would otherwise make the benchmark depend on
+// an ordering that real inputs do not have.
+inline void ScrambleIDs(VertexID num_vertices, uint64_t seed,
+                        core::common::ThreadPool* thread_pool,
+                        std::vector<Edge>* edges) {
+  std::vector<VertexID> new_id(num_vertices);
+  std::iota(new_id.begin(), new_id.end(), 0);
+  std::shuffle(new_id.begin(), new_id.end(), std::mt19937_64(seed));
+  ParallelFor(edges->size(), 1 << 16, thread_pool,
+              [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                  auto& edge = edges->at(i);
+                  edge = Edge(new_id[edge.src], new_id[edge.dst]);
+                }
+              });
+}
+
+// @DESCRIPTION: build the CSR of the edges over [0, num_vertices) in
+// parallel. Self loops and duplicate edges are dropped, and with `symmetric`
+// the reverse of every edge is added. Adjacency lists are sorted.
+inline GeneratedGraph BuildCSR(VertexID num_vertices,
+                               const std::vector<Edge>& edges, bool symmetric,
+                               core::common::ThreadPool* thread_pool) {
+  namespace atomic = core::util::atomic;
+  std::vector<EdgeIndex> count(num_vertices, 0);
+  auto for_each_edge = [&](auto&& func) {
+    ParallelFor(edges.size(), 1 << 16, thread_pool,
+                [&](size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; i++) {
+                    auto& edge = edges[i];
+                    if (edge.src == edge.dst) continue;
+                    func(edge.src, edge.dst);
+                    if (symmetric) func(edge.dst, edge.src);
+                  }
+                });
+  };
+  for_each_edge([&](VertexID src, VertexID) {
+    atomic::WriteAdd(&count[src], (EdgeIndex)1);
+  });
+
+  // Scatter the edges into their adjacency lists.
+  std::vector<EdgeIndex> cursor(num_vertices + 1, 0);
+  for (VertexID v = 0; v < num_vertices; v++) {
+    cursor[v + 1] = cursor[v] + count[v];
+  }
+  std::vector<VertexID> scattered(cursor[num_vertices]);
+  std::vector<EdgeIndex> begin_of(cursor.begin(), cursor.end() - 1);
+  for_each_edge([&](VertexID src, VertexID dst) {
+    scattered[atomic::FetchAdd(&begin_of[src], (EdgeIndex)1)] = dst;
+  });
+
+  // Sort and deduplicate each list, then compact.
+  GeneratedGraph graph;
+  graph.num_vertices = num_vertices;
+  graph.degree.resize(num_vertices);
+  graph.offset.resize(num_vertices);
+  ParallelFor(num_vertices, 1 << 10, thread_pool,
+              [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                  auto first = scattered.begin() + cursor[v];
+                  auto last = scattered.begin() + cursor[v + 1];
+                  std::sort(first, last);
+                  graph.degree[v] = std::unique(first, last) - first;
+                }
+              });
+  EdgeIndex num_edges = 0;
+  for (VertexID v = 0; v < num_vertices; v++) {
+    graph.offset[v] = num_edges;
+    num_edges += graph.degree[v];
+  }
+  graph.edges.resize(num_edges);
+  ParallelFor(num_vertices, 1 << 10, thread_pool,
+              [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                  std::copy_n(scattered.begin() + cursor[v], graph.degree[v],
+                              graph.edges.begin() + graph.offset[v]);
+                }
+              });
+  return graph;
+}
+
+// @DESCRIPTION: give every edge a weight in [1, max_weight]. The weight is a
+// hash of the seed and the two endpoints, so both directions of an edge get
+// the same weight and the output does not depend on the number of threads.
+inline void AssignWeights(EdgeWeight max_weight, uint64_t seed,
+                          core::common::ThreadPool* thread_pool,
+                          GeneratedGraph* graph) {
+  if (max_weight == 0) LOG_FATAL("max_weight must be positive");
+  graph->weights.resize(graph->GetNumEdges());
+  ParallelFor(graph->num_vertices, 1 << 10, thread_pool,
+              [&](size_t begin, size_t end) {
+                for (VertexID src = begin; src < end; src++) {
+                  auto offset = graph->offset[src];
+                  for (VertexDegree i = 0; i < graph->degree[src]; i++) {
+                    VertexID dst = graph->edges[offset + i];
+                    uint64_t x = ((uint64_t)std::min(src, dst) << 32 |
+                                  std::max(src, dst)) ^
+                                 (seed * 0x9E3779B97F4A7C15ULL);
+                    // splitmix64 finalizer.
+                    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+                    x ^= x >> 31;
+                    graph->weights[offset + i] = 1 + x % max_weight;
+                  }
+                }
+              });
+}
+
+// @DESCRIPTION: build the in edges of `graph`, its transpose, with sorted
+// adjacency lists, for the apps that traverse edges backward.
+inline void BuildInEdges(core::common::ThreadPool* thread_pool,
+                         GeneratedGraph* graph) {
+  namespace atomic = core::util::atomic;
+  auto num_vertices = graph->num_vertices;
+  graph->in_degree.assign(num_vertices, 0);
+  auto for_each_edge = [&](auto&& func) {
+    ParallelFor(num_vertices, 1 << 10, thread_pool,
+                [&](size_t begin, size_t end) {
+                  for (VertexID src = begin; src < end; src++) {
+                    auto offset = graph->offset[src];
+                    for (VertexDegree i = 0; i < graph->degree[src]; i++) {
+                      func(src, graph->edges[offset + i]);
+                    }
+                  }
+                });
+  };
+  for_each_edge([&](VertexID, VertexID dst) {
+    atomic::WriteAdd(&graph->in_degree[dst], (VertexDegree)1);
+  });
+  graph->in_offset.resize(num_vertices);
+  EdgeIndex num_edges = 0;
+  for (VertexID v = 0; v < num_vertices; v++) {
+    graph->in_offset[v] = num_edges;
+    num_edges += graph->in_degree[v];
+  }
+  graph->in_edges.resize(num_edges);
+  std::vector<EdgeIndex> cursor(graph->in_offset);
+  for_each_edge([&](VertexID src, VertexID dst) {
+    graph->in_edges[atomic::FetchAdd(&cursor[dst], (EdgeIndex)1)] = src;
+  });
+  ParallelFor(num_vertices, 1 << 10, thread_pool,
+              [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                  auto first = graph->in_edges.begin() + graph->in_offset[v];
+                  std::sort(first, first + graph->in_degree[v]);
+                }
+              });
+}
+
+// @DESCRIPTION: write `graph` to `root_path` in the layout the planar system
+// loads, as planar/partitioner.cpp would produce it: `meta.yaml`, and under
+// `graphs/` the file `blocks_meta.yaml` with the TwoDMetadata, and per block
+// a `<gid>_blocks/` directory with `index.bin` (sparse offsets and degrees)
+// and one `<i>.bin` edge file per sub-block. The edge files of a weighted
+// graph hold the weights after the edges, see `Block::weighted`, and if
+// the in edges of `graph` are built, the files and index end with them, see
+// `Block::in_edges`.
+//
+// The graph is split into `num_blocks` blocks with about the same number of
+// edges, and each block into sub-blocks of at most `cut_v` vertices.
+inline void WriteBlocks(const std::string& root_path,
+                        const GeneratedGraph& graph, uint32_t num_blocks,
+                        uint32_t cut_v, uint32_t offset_ratio) {
+  namespace fs = std::filesystem;
+  using core::data_structures::Block;
+  using core::data_structures::SubBlock;
+  auto num_vertices = graph.num_vertices;
+  auto num_edges = graph.GetNumEdges();
+  if (num_vertices == 0) LOG_FATAL("Can not write an empty graph");
+  num_blocks = std::max(std::min(num_blocks, num_vertices), (uint32_t)1);
+
+  // Cut the blocks where the edge offset crosses a multiple of the share.
+  std::vector<VertexID> bounds = {0};
+  EdgeIndex share = (num_edges + num_blocks - 1) / num_blocks;
+  for (VertexID v = 1; v < num_vertices && bounds.size() < num_blocks; v++) {
+    if (graph.offset[v] >= share * bounds.size()) bounds.push_back(v);
+  }
+  bounds.push_back(num_vertices);
+  num_blocks = bounds.size() - 1;
+
+  fs::create_directories(root_path + "graphs");
+  core::data_structures::TwoDMetadata metadata;
+  metadata.num_vertices = num_vertices;
+  metadata.num_edges = num_edges;
+  metadata.num_blocks = num_blocks;
+  std::vector<core::data_structures::BlockMetadata> block_metadata_vec;
+  for (uint32_t gid = 0; gid < num_blocks; gid++) {
+    VertexID bid = bounds[gid], eid = bounds[gid + 1];
+    VertexID block_vertices = eid - bid;
+    EdgeIndex base = graph.offset[bid];
+    EdgeIndex block_edges =
+        graph.offset[eid - 1] + graph.degree[eid - 1] - base;
+    auto offset = [&](VertexID idx) { return graph.offset[bid + idx] - base; };
+    bool in_edges = !graph.in_offset.empty();
+    EdgeIndex in_base = in_edges ? graph.in_offset[bid] : 0;
+    auto in_offset = [&](VertexID idx) {
+      return graph.in_offset[bid + idx] - in_base;
+    };
+
+    std::string dir = root_path + "graphs/" + std::to_string(gid) + "_blocks";
+    fs::create_directories(dir);
+    auto num_offsets = ((block_vertices - 1) / offset_ratio) + 1;
+    std::vector<EdgeIndex> offset_reduce(num_offsets);
+    for (uint32_t i = 0; i < num_offsets; i++) {
+      offset_reduce[i] = offset(i * offset_ratio);
+    }
+    std::ofstream index_file(dir + "/index.bin", std::ios::binary);
+    index_file.write((char*)offset_reduce.data(),
+                     num_offsets * sizeof(EdgeIndex));
+    index_file.write((char*)(graph.degree.data() + bid),
+                     block_vertices * sizeof(VertexDegree));
+    if (in_edges) {
+      for (uint32_t i = 0; i < num_offsets; i++) {
+        offset_reduce[i] = in_offset(i * offset_ratio);
+      }
+      index_file.write((char*)offset_reduce.data(),
+                       num_offsets * sizeof(EdgeIndex));
+      index_file.write((char*)(graph.in_degree.data() + bid),
+                       block_vertices * sizeof(VertexDegree));
+    }
+    index_file.close();
+
+    uint32_t p = ((block_vertices - 1) / cut_v) + 1;
+    uint32_t size = (block_vertices + p - 1) / p;
+    Block block;
+    block.id = gid;
+    block.num_vertices = block_vertices;
+    block.num_edges = block_edges;
+    block.offset_ratio = offset_ratio;
+    block.begin_id = bid;
+    block.end_id = eid;
+    block.vertex_offset = size;
+    block.weighted = !graph.weights.empty();
+    block.in_edges = in_edges;
+    for (uint32_t i = 0; i * size < block_vertices; i++) {
+      VertexID begin_id = i * size;
+      VertexID end_id = std::min(begin_id + size, block_vertices);
+      EdgeIndex sub_block_edges = offset(end_id - 1) +
+                                  graph.degree[bid + end_id - 1] -
+                                  offset(begin_id);
+      if (sub_block_edges > UINT32_MAX) {
+        LOGF_FATAL("Sub-block {} of block {} has {} edges, reduce --cut_v", i,
+                   gid, sub_block_edges);
+      }
+      SubBlock sub_block;
+      sub_block.id = i;
+      sub_block.begin_id = begin_id + bid;
+      sub_block.end_id = end_id + bid;
+      sub_block.num_edges = sub_block_edges;
+      sub_block.num_vertices = end_id - begin_id;
+      sub_block.begin_offset = offset(begin_id);
+      if (in_edges) {
+        sub_block.num_in_edges = in_offset(end_id - 1) +
+                                 graph.in_degree[bid + end_id - 1] -
+                                 in_offset(begin_id);
+        sub_block.in_begin_offset = in_offset(begin_id);
+      }
+      block.sub_blocks.push_back(sub_block);
+      std::ofstream out_file(dir + "/" + std::to_string(i) + ".bin",
+                             std::ios::binary);
+      out_file.write((char*)(graph.edges.data() + base + offset(begin_id)),
+                     sub_block_edges * sizeof(VertexID));
+      if (block.weighted) {
+        out_file.write(
+            (char*)(graph.weights.data() + base + offset(begin_id)),
+            sub_block_edges * sizeof(EdgeWeight));
+      }
+      if (in_edges) {
+        out_file.write((char*)(graph.in_edges.data() + in_base +
+                               sub_block.in_begin_offset),
+                       sub_block.num_in_edges * sizeof(VertexID));
+      }
+      out_file.close();
+    }
+    block.num_sub_blocks = block.sub_blocks.size();
+    metadata.blocks.push_back(block);
+
+    core::data_structures::BlockMetadata block_metadata;
+    block_metadata.bid = gid;
+    block_metadata.begin_id = bid;
+    block_metadata.end_id = eid;
+    block_metadata.num_vertices = block_vertices;
+    block_metadata.num_outgoing_edges = block_edges;
+    block_metadata_vec.push_back(block_metadata);
+  }
+
+  YAML::Node blocks_meta;
+  blocks_meta["GraphMetadata"] = metadata;
+  std::ofstream blocks_meta_file(root_path + "graphs/blocks_meta.yaml");
+  blocks_meta_file << blocks_meta;
+  blocks_meta_file.close();
+
+  core::data_structures::GraphMetadata graph_metadata;
+  graph_metadata.set_type("block");
+  graph_metadata.set_num_vertices(num_vertices);
+  graph_metadata.set_num_edges(num_edges);
+  graph_metadata.set_min_vid(0);
+  graph_metadata.set_max_vid(num_vertices - 1);
+  graph_metadata.set_num_subgraphs(num_blocks);
+  graph_metadata.set_block_metadata_vec(block_metadata_vec);
+  YAML::Node meta;
+  meta["GraphMetadata"] = graph_metadata;
+  std::ofstream meta_file(root_path + "meta.yaml");
+  meta_file << meta;
+  meta_file.close();
+}
+
+}  // namespace sics::graph::bench
+
+#endif  // BENCH_COMMON_GRAPH_GENERATOR_H_
@@ -0,0 +1,74 @@
+#ifndef BENCH_COMMON_HARNESS_H_
+#define BENCH_COMMON_HARNESS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/logging.h"
+
+namespace sics::graph::bench {
+
+// A minimal harness for the microbenchmarks: every benchmark runs a body on
+// each thread count of a list, with all threads released together, and logs
+// the aggregated throughput.
+
+// Parse a comma separated list of positive numbers, e.g. the thread counts
+// "1,2,4,8".
+inline std::vector<uint32_t> ParseUintList(const std::string& list) {
+  std::vector<uint32_t> counts;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) counts.push_back(std::max(std::stoul(item), 1ul));
+  }
+  return counts;
+}
+
+// Run `body(thread_id)` on `num_threads` threads and return the seconds from
+// their common start until the last one is done.
+template <typename Func>
+double RunOnThreads(uint32_t num_threads, Func&& body) {
+  std::atomic<uint32_t> ready = 0;
+  std::atomic<bool> go = false;
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      body(t);
+    });
+  }
+  while (ready.load() != num_threads) std::this_thread::yield();
+  auto begin = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& thread : threads) thread.join();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+// Log the throughput of `num_ops` operations done in `seconds` in total, and
+// the latency of one operation as seen by one thread.
+inline void Report(const std::string& name, uint32_t num_threads,
+                   uint64_t num_ops, double seconds) {
+  LOGF_INFO("{:<32} threads: {:>3} time: {:.3f} s, {:.2f} Mops/s, {:.1f} ns/op",
+            name, num_threads, seconds, num_ops / seconds / 1e6,
+            seconds * 1e9 * num_threads / num_ops);
+}
+
+// Cheap deterministic index stream, so that random access patterns do not
+// pay for a random engine.
+inline uint64_t Hash(uint64_t t, uint64_t i) {
+  uint64_t x =
+      (i + 1) * 0x9E3779B97F4A7C15ULL ^ (t + 1) * 0xC2B2AE3D27D4EB4FULL;
+  return x ^ (x >> 31);
+}
+
+}  // namespace sics::graph::bench
+
+#endif  // BENCH_COMMON_HARNESS_H_
@@ -0,0 +1,77 @@
+// @DESCRIPTION: generate a synthetic graph directly in the block format the
+// planar system loads, see bench/common/graph_generator.h. The output only
+// depends on the flags, not on the number of threads, so runs against the
+// same flags are comparable.
+//
+//  graph_gen_exec -o /data/rmat20/ -generator rmat -scale 20 -edge_factor 16
+
+#include <gflags/gflags.h>
+
+#include <chrono>
+
+#include "bench/common/graph_generator.h"
+
+DEFINE_string(o, "/output/", "output root path");
+DEFINE_string(generator, "rmat", "rmat or uniform");
+DEFINE_uint32(scale, 20, "log2 of the number of vertices");
+DEFINE_uint32(edge_factor, 16, "number of generated edges per vertex");
+DEFINE_double(a, 0.57, "rmat probability of the top left quadrant");
+DEFINE_double(b, 0.19, "rmat probability of the top right quadrant");
+DEFINE_double(c, 0.19, "rmat probability of the bottom left quadrant");
+DEFINE_uint64(seed, 1, "random seed");
+DEFINE_bool(symmetric, true, "add the reverse of every edge");
+DEFINE_bool(scramble, true, "randomly relabel the vertices");
+DEFINE_uint32(max_weight, 0,
+              "give every edge a random weight in [1, max_weight], 0 for an "
+              "unweighted graph");
+DEFINE_bool(in_edges, false,
+            "also write the in edges of every sub-block, e.g. for scc");
+DEFINE_uint32(p, 8, "parallelism");
+DEFINE_uint32(blocks, 1, "number of blocks (subgraphs)");
+DEFINE_uint32(cut_v, 500000, "max vertices per sub-block");
+DEFINE_uint32(offset_ratio, 64, "offset compress ratio");
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  std::string root_path = FLAGS_o;
+  if (root_path.back() != '/') root_path += "/";
+  core::common::ThreadPool thread_pool(FLAGS_p);
+  bench::VertexID num_vertices = (bench::VertexID)1 << FLAGS_scale;
+  auto begin = std::chrono::system_clock::now();
+
+  std::vector<bench::Edge> edges;
+  if (FLAGS_generator == "rmat") {
+    edges = bench::GenerateRMAT(FLAGS_scale, FLAGS_edge_factor, FLAGS_a,
+                                FLAGS_b, FLAGS_c, FLAGS_seed, &thread_pool);
+  } else if (FLAGS_generator == "uniform") {
+    edges = bench::GenerateUniform(
+        num_vertices, (bench::EdgeIndex)FLAGS_edge_factor * num_vertices,
+        FLAGS_seed, &thread_pool);
+  } else {
+    LOGF_FATAL("Unknown generator: {}", FLAGS_generator);
+  }
+  if (FLAGS_scramble) {
+    bench::ScrambleIDs(num_vertices, FLAGS_seed, &thread_pool, &edges);
+  }
+  LOGF_INFO("Generated {} edges", edges.size());
+
+  auto graph =
+      bench::BuildCSR(num_vertices, edges, FLAGS_symmetric, &thread_pool);
+  std::vector<bench::Edge>().swap(edges);
+  LOGF_INFO("Built CSR with {} vertices and {} edges", graph.num_vertices,
+            graph.GetNumEdges());
+  if (FLAGS_max_weight != 0) {
+    bench::AssignWeights(FLAGS_max_weight, FLAGS_seed, &thread_pool, &graph);
+  }
+  if (FLAGS_in_edges) bench::BuildInEdges(&thread_pool, &graph);
+
+  bench::WriteBlocks(root_path, graph, FLAGS_blocks, FLAGS_cut_v,
+                     FLAGS_offset_ratio);
+  auto end = std::chrono::system_clock::now();
+  LOGF_INFO("Wrote graph to {} in {:.3f} s", root_path,
+            std::chrono::duration<double>(end - begin).count());
+  thread_pool.StopAndJoin();
+  return 0;
+}
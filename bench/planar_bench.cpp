@@ -0,0 +1,175 @@
+// @DESCRIPTION: run the planar apps over a graph in every requested mode and
+// thread count, and report one CSV row per run with the throughput in edges
+// per second, the bytes read, the peak RSS and the time of the main phases.
+//
+// Each run is a separate process of the app executable (e.g.
+// bin/planar/wcc_exec), so that peak RSS and the profile are per run. Phase
+// times and bytes read come from the profile the app writes with --profile,
+// see core/util/profiler.h.
+//
+//  planar_bench_exec -i /data/rmat20/ -threads 1,8 -modes in_memory,normal
+
+#include <fcntl.h>
+#include <gflags/gflags.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/data_structures/graph_metadata.h"
+#include "core/util/logging.h"
+
+DEFINE_string(i, "/testfile/", "graph root path, e.g. written by graph_gen");
+DEFINE_string(bin_dir, "./bin/planar/", "directory of the app executables");
+DEFINE_string(apps, "wcc,sssp,mst,color,pagerank,random_walk",
+              "comma separated apps to run");
+DEFINE_string(modes, "in_memory,normal,static,random",
+              "comma separated modes to run");
+DEFINE_string(threads, "8", "comma separated thread counts to run");
+DEFINE_uint32(repeat, 1, "runs of every configuration");
+DEFINE_string(work_dir, "/tmp/", "directory for the logs and profiles");
+DEFINE_string(o, "", "output csv path, stdout if empty");
+
+namespace {
+
+// Phases of the profile reported as columns, see core/util/profiler.h.
+const std::vector<std::string> kPhases = {
+    "executor.deserialize", "executor.peval", "executor.inceval",
+    "executor.serialize",   "app.sync",       "io.read_submit",
+    "io.cqe_wait",          "task.submit_sync"};
+
+std::vector<std::string> Split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+struct RunResult {
+  int status = -1;
+  double wall_s = 0;
+  long peak_rss_kb = 0;
+  int64_t bytes_read = 0;
+  std::vector<double> phase_ms;
+};
+
+// Run `args` as a child process with its output in `log_path`, and wait for
+// it.
+RunResult RunProcess(const std::vector<std::string>& args,
+                     const std::string& log_path) {
+  RunResult result;
+  auto begin = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0) LOG_FATAL("fork failed");
+  if (pid == 0) {
+    int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    std::vector<char*> argv;
+    for (auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+  int status = 0;
+  struct rusage usage;
+  wait4(pid, &status, 0, &usage);
+  auto end = std::chrono::steady_clock::now();
+  result.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  result.wall_s = std::chrono::duration<double>(end - begin).count();
+  result.peak_rss_kb = usage.ru_maxrss;
+  return result;
+}
+
+// Read the phase times and bytes read from the JSON profile of a run.
+void ReadProfile(const std::string& path, RunResult* result) {
+  result->phase_ms.assign(kPhases.size(), 0);
+  YAML::Node profile;
+  try {
+    profile = YAML::LoadFile(path);
+  } catch (YAML::Exception& e) {
+    LOGF_WARN("No profile at {}: {}", path, e.what());
+    return;
+  }
+  for (size_t i = 0; i < kPhases.size(); i++) {
+    auto phase = profile["phases"][kPhases[i]];
+    if (phase) result->phase_ms[i] = phase["total_ms"].as<double>();
+  }
+  auto bytes = profile["counters"]["io.read_bytes"];
+  if (bytes) result->bytes_read = bytes.as<int64_t>();
+}
+
+}  // namespace
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  core::data_structures::TwoDMetadata meta(FLAGS_i);
+  LOGF_INFO("Benchmarking {} with {} vertices and {} edges", FLAGS_i,
+            meta.num_vertices, meta.num_edges);
+
+  std::ofstream out_file;
+  if (!FLAGS_o.empty()) out_file.open(FLAGS_o);
+  std::ostream& out = FLAGS_o.empty() ? std::cout : out_file;
+  out << "app,mode,threads,run,status,num_vertices,num_edges,wall_s,"
+         "edges_per_s,bytes_read,peak_rss_mb";
+  for (auto& phase : kPhases) out << "," << phase << "_ms";
+  out << std::endl;
+
+  for (auto& app : Split(FLAGS_apps)) {
+    for (auto& mode : Split(FLAGS_modes)) {
+      if (mode != "in_memory" && mode != "normal" && mode != "static" &&
+          mode != "random") {
+        LOGF_FATAL("Unknown mode: {}", mode);
+      }
+      // random_walk only runs in the normal mode.
+      if (app == "random_walk" && (mode == "static" || mode == "random")) {
+        continue;
+      }
+      for (auto& threads : Split(FLAGS_threads)) {
+        for (uint32_t run = 0; run < FLAGS_repeat; run++) {
+          std::string name =
+              app + "_" + mode + "_" + threads + "_" + std::to_string(run);
+          std::string profile_path = FLAGS_work_dir + name + ".json";
+          std::remove(profile_path.c_str());
+          std::vector<std::string> args = {
+              FLAGS_bin_dir + app + "_exec",
+              "-i=" + FLAGS_i,
+              "-p=" + threads,
+              std::string("-in_memory=") +
+                  (mode == "in_memory" ? "true" : "false"),
+              "-mode=" + (mode == "in_memory" ? "normal" : mode),
+              "-profile=" + profile_path,
+              "-profile_format=json"};
+          LOGF_INFO("Running {}", name);
+          auto result = RunProcess(args, FLAGS_work_dir + name + ".log");
+          ReadProfile(profile_path, &result);
+          out << app << "," << mode << "," << threads << "," << run << ","
+              << (result.status == 0 ? "ok" : "failed") << ","
+              << meta.num_vertices << "," << meta.num_edges << ","
+              << result.wall_s << "," << meta.num_edges / result.wall_s
+              << "," << result.bytes_read << ","
+              << result.peak_rss_kb / 1024.0;
+          for (auto ms : result.phase_ms) out << "," << ms;
+          out << std::endl;
+        }
+      }
+    }
+  }
+  return 0;
+}
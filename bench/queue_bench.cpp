@@ -0,0 +1,48 @@
+#include <gflags/gflags.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "bench/common/harness.h"
+#include "core/common/blocking_queue.h"
+
+DEFINE_string(threads, "1,2,4,8", "comma separated producer thread counts");
+DEFINE_uint64(n, 1 << 20, "items pushed per producer");
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  auto n = FLAGS_n;
+
+  // Single thread round trip: push then pop, the queue never blocks.
+  {
+    core::common::BlockingQueue<uint64_t> queue;
+    auto seconds = bench::RunOnThreads(1, [&](uint32_t) {
+      for (uint64_t i = 0; i < n; i++) {
+        queue.Push(i);
+        queue.PopOrWait();
+      }
+    });
+    bench::Report("BlockingQueue push+pop", 1, n, seconds);
+  }
+
+  // `num_threads` producers against as many consumers.
+  for (auto num_threads : bench::ParseUintList(FLAGS_threads)) {
+    core::common::BlockingQueue<uint64_t> queue;
+    std::vector<uint64_t> sums(num_threads, 0);
+    auto seconds = bench::RunOnThreads(2 * num_threads, [&](uint32_t t) {
+      if (t < num_threads) {
+        for (uint64_t i = 0; i < n; i++) queue.Push(i);
+      } else {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < n; i++) sum += queue.PopOrWait();
+        sums[t - num_threads] = sum;
+      }
+    });
+    bench::Report("BlockingQueue producer/consumer", num_threads,
+                  num_threads * n, seconds);
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "bench/common/harness.h"
+#include "core/common/multithreading/thread_pool.h"
+
+DEFINE_string(threads, "1,2,4,8", "comma separated pool sizes");
+DEFINE_uint64(n, 1 << 20, "tasks in total");
+DEFINE_string(package_sizes, "1,16,256,4096",
+              "comma separated numbers of tasks per SubmitSync");
+DEFINE_uint32(work, 0, "loop iterations of busy work per task");
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  auto work = FLAGS_work;
+
+  for (auto num_threads : bench::ParseUintList(FLAGS_threads)) {
+    core::common::ThreadPool pool(num_threads);
+    for (auto package_size : bench::ParseUintList(FLAGS_package_sizes)) {
+      std::atomic<uint64_t> done = 0;
+      core::common::TaskPackage tasks(package_size, [&done, work]() {
+        volatile uint64_t x = 0;
+        for (uint32_t i = 0; i < work; i++) x = x + i;
+        done.fetch_add(1, std::memory_order_relaxed);
+      });
+      uint64_t rounds = std::max(FLAGS_n / package_size, (uint64_t)1);
+      // Measured on the submitting thread, so the time per task is the whole
+      // dispatch plus completion overhead that a parallel loop pays.
+      auto seconds = bench::RunOnThreads(1, [&](uint32_t) {
+        for (uint64_t r = 0; r < rounds; r++) pool.SubmitSync(tasks);
+      });
+      LOGF_INFO(
+          "{:<32} threads: {:>3} time: {:.3f} s, {:.2f} Mtasks/s, "
+          "{:.1f} ns/task, {:.2f} us/SubmitSync",
+          "ThreadPool::SubmitSync x" + std::to_string(package_size),
+          num_threads, seconds, done.load() / seconds / 1e6,
+          seconds * 1e9 / done.load(), seconds * 1e6 / rounds);
+    }
+    pool.StopAndJoin();
+  }
+  return 0;
+}
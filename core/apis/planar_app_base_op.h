@@ -1,13 +1,17 @@
 #ifndef GRAPH_SYSTEMS_PLANAR_APP_BASE_OP_H
 #define GRAPH_SYSTEMS_PLANAR_APP_BASE_OP_H
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <fstream>
 #include <functional>
 #include <mutex>
 #include <type_traits>
 #include <vector>
 
 #include "apis/pie.h"
+#include "common/bitmap.h"
 #include "common/blocking_queue.h"
 #include "common/config.h"
 #include "common/multithreading/task_runner.h"
@@ -18,6 +22,8 @@
 #include "scheduler/message_hub.h"
 #include "update_stores/bsp_update_store.h"
 #include "util/logging.h"
+#include "util/profiler.h"
+#include "util/task_partition.h"
 
 namespace sics::graph::core::apis {
 
@@ -77,7 +83,8 @@ class PlanarAppBaseOp : public PIE {
       write_ = new VertexData[meta_->num_vertices];
     }
 
-    if (app_type_ == common::Sssp) {
+    if (app_type_ == common::Sssp || app_type_ == common::Bfs ||
+        app_type_ == common::KCore || app_type_ == common::Scc) {
       for (int i = 0; i < meta->num_blocks; i++) {
         auto block_meta = meta->blocks.at(i);
         actives_.emplace_back(block_meta.num_vertices);
@@ -86,6 +93,13 @@ class PlanarAppBaseOp : public PIE {
     }
 
     mode_ = common::Configurations::Get()->mode;
+    hub_degree_ = common::Configurations::Get()->hub_degree;
+    edge_tasks_.resize(meta_->num_blocks);
+    block_ends_.clear();
+    for (auto& block : meta_->blocks) block_ends_.push_back(block.end_id);
+
+    auto& permutation_path = common::Configurations::Get()->permutation_path;
+    if (!permutation_path.empty()) LoadPermutation(permutation_path);
   }
 
  protected:
@@ -202,147 +216,164 @@ class PlanarAppBaseOp : public PIE {
     }
   }
 
+  // Parallel execute vertex_func on every vertex of the current subgraph, with
+  // the vertices split into edge balanced tasks (see `GetEdgeTasks`). In
+  // Normal mode, the sub-blocks not to read are skipped.
   void ParallelVertexDoWithEdges(
       const std::function<void(VertexID)>& vertex_func) {
     LOG_DEBUG("ParallelVertexDoWithEdges is begin");
+    // Hubs are not split for a per vertex function, so only the first chunk
+    // of a hub runs, covering the whole vertex.
+    auto range_func = [&vertex_func](BlockID bid, const util::TaskRange& range,
+                                     size_t slot) {
+      for (VertexID id = range.begin; id < range.end; id++) {
+        vertex_func(id);
+      }
+    };
     if (mode_ != common::Normal) {
       auto load = state_->IsEdgesLoaded(static_gid_);
       auto block_meta = meta_->blocks.at(0);
-      if (!load) {
-        int size_num = state_->GetSubBlockNum(static_gid_);
-        scheduler::ReadMessage read;
-        read.graph_id = current_gid_;
-        hub_->get_reader_queue()->Push(read);
-        auto queue = buffer_->GetQueue();
-        while (true) {
-          auto bid = queue->PopOrWait();
-          if (bid == MAX_VERTEX_ID) break;
-          auto sub_block_meta = block_meta.sub_blocks.at(bid);
-          if (mode_ == common::Static) {
-            auto task_size =
-                (sub_block_meta.num_vertices + parallelism_ - 1) / parallelism_;
-            uint32_t b = sub_block_meta.begin_id, e = sub_block_meta.begin_id;
-            common::TaskPackage tasks;
-            for (int i = 0; i < parallelism_; i++) {
-              e += task_size;
-              if (e >= sub_block_meta.end_id) e = sub_block_meta.end_id;
-              auto task = [&vertex_func, b, e] {
-                for (VertexID id = b; id < e; id++) {
-                  vertex_func(id);
-                }
-              };
-              tasks.push_back(task);
-              b = e;
-            }
-            runner_->SubmitSync(tasks);
+      if (mode_ == common::Static) {
+        if (!load) {
+          int size_num = state_->GetSubBlockNum(static_gid_);
+          scheduler::ReadMessage read;
+          read.graph_id = current_gid_;
+          hub_->get_reader_queue()->Push(read);
+          auto queue = buffer_->GetQueue();
+          while (true) {
+            auto bid = queue->PopOrWait();
+            if (bid == MAX_VERTEX_ID) break;
+            runner_->SubmitSync(
+                GetStaticTasks(block_meta.sub_blocks.at(bid), vertex_func));
             size_num = 0;
-          } else {
-            auto task = [&vertex_func, &size_num, this, sub_block_meta]() {
-              auto begin_id = sub_block_meta.begin_id;
-              auto end_id = sub_block_meta.end_id;
-              for (VertexID id = begin_id; id < end_id; id++) {
-                vertex_func(id);
-              }
-              std::lock_guard<std::mutex> lock(mtx_);
-              size_num -= 1;
-              cv_.notify_all();
-            };
-            runner_->SubmitAsync(task);
-            //            LOGF_INFO("Submit task {}", bid);
           }
-        }
-        std::unique_lock<std::mutex> lock(mtx_);
-        if (size_num != 0) {
-          cv_.wait(lock, [&size_num]() { return size_num == 0; });
-        }
-      } else {
-        common::TaskPackage tasks;
-        auto sub_ids = state_->GetSubBlockIDs(static_gid_);
-        if (mode_ == common::Static) {
-          assert(sub_ids.size() == 1);
-          auto sub_block_meta = block_meta.sub_blocks.at(sub_ids.at(0));
-          auto task_size =
-              (sub_block_meta.num_vertices + parallelism_ - 1) / parallelism_;
-          uint32_t b = sub_block_meta.begin_id, e = sub_block_meta.begin_id;
-          for (int i = 0; i < parallelism_; i++) {
-            e += task_size;
-            if (e >= sub_block_meta.end_id) e = sub_block_meta.end_id;
-            auto task = [&vertex_func, b, e] {
-              for (VertexID id = b; id < e; id++) {
-                vertex_func(id);
-              }
-            };
-            tasks.push_back(task);
-            b = e;
-          }
-          runner_->SubmitSync(tasks);
         } else {
-          for (int i = 0; i < sub_ids.size(); i++) {
-            auto id = sub_ids.at(i);
-            auto sub_block_meta = block_meta.sub_blocks.at(id);
-            auto task = [&vertex_func, sub_block_meta]() {
-              auto begin_id = sub_block_meta.begin_id;
-              auto end_id = sub_block_meta.end_id;
-              for (VertexID id = begin_id; id < end_id; id++) {
-                vertex_func(id);
-              }
-            };
-            tasks.emplace_back(task);
-          }
-          runner_->SubmitSync(tasks);
+          auto sub_ids = state_->GetSubBlockIDs(static_gid_);
+          assert(sub_ids.size() == 1);
+          runner_->SubmitSync(GetStaticTasks(
+              block_meta.sub_blocks.at(sub_ids.at(0)), vertex_func));
         }
+      } else {
+        RunEdgeTasks(load, state_->GetSubBlockIDs(static_gid_), range_func,
+                     true);
       }
       LOG_INFO("task finished");
       Sync(use_readdata_only_);
       return;
     }
-    auto load = graphs_->at(current_gid_).IsEdgesLoaded();
-    auto block_meta = meta_->blocks.at(current_gid_);
-    if (!load) {
-      int size_num = block_meta.num_sub_blocks;
-      scheduler::ReadMessage read;
-      read.graph_id = current_gid_;
-      hub_->get_reader_queue()->Push(read);
-      auto queue = buffer_->GetQueue();
-      while (true) {
-        auto bid = queue->PopOrWait();
-        if (bid == MAX_VERTEX_ID) break;
-        auto sub_block_meta = block_meta.sub_blocks.at(bid);
-        auto task = [&vertex_func, &size_num, this, sub_block_meta]() {
-          auto begin_id = sub_block_meta.begin_id;
-          auto end_id = sub_block_meta.end_id;
-          for (VertexID id = begin_id; id < end_id; id++) {
-            vertex_func(id);
-          }
-          std::lock_guard<std::mutex> lock(mtx_);
-          size_num -= 1;
-          cv_.notify_all();
-        };
-        runner_->SubmitAsync(task);
-        //        LOGF_INFO("Submit task {}", bid);
+    RunEdgeTasks(graphs_->at(current_gid_).IsEdgesLoaded(),
+                 GetSubBlockIDsToRead(), range_func, true);
+    LOG_INFO("task finished");
+    Sync(use_readdata_only_);
+    //    LOG_INFO("ParallelVertexDoWithEdges is done");
+  }
+
+  // As above, but only on the vertices set in `bitmap`, indexed from the
+  // begin_id of the current subgraph. Words of `bitmap` without any are
+  // skipped whole, so a sparse frontier costs little more than its vertices.
+  void ParallelVertexDoWithEdges(
+      const common::Bitmap& bitmap,
+      const std::function<void(VertexID)>& vertex_func) {
+    auto begin_id = meta_->blocks.at(current_gid_).begin_id;
+    if (mode_ != common::Normal) {
+      ParallelVertexDoWithEdges([&bitmap, &vertex_func, begin_id](VertexID id) {
+        if (bitmap.GetBit(id - begin_id)) vertex_func(id);
+      });
+      return;
+    }
+    LOG_DEBUG("ParallelVertexDoWithEdges is begin");
+    auto words = bitmap.GetDataBasePointer();
+    auto range_func = [&vertex_func, words, begin_id](
+                          BlockID bid, const util::TaskRange& range,
+                          size_t slot) {
+      for (VertexID id = range.begin; id < range.end;) {
+        auto idx = id - begin_id;
+        auto word = words[idx >> 6] >> (idx & 0x3f);
+        if (word == 0) {
+          id += 64 - (idx & 0x3f);
+          continue;
+        }
+        id += __builtin_ctzll(word);
+        if (id >= range.end) break;
+        vertex_func(id++);
       }
-      std::unique_lock<std::mutex> lock(mtx_);
-      if (size_num != 0) {
-        cv_.wait(lock, [&size_num]() { return size_num == 0; });
+    };
+    RunEdgeTasks(graphs_->at(current_gid_).IsEdgesLoaded(),
+                 GetSubBlockIDsToRead(), range_func, true);
+    LOG_INFO("task finished");
+    Sync(use_readdata_only_);
+  }
+
+  // Parallel execute a reduction over the out edges of every vertex of the
+  // current subgraph, splitting hubs into edge range tasks.
+  //
+  // `reduce_func(id, begin, end)` folds the out edges [begin, end) of vertex
+  // `id` into a partial result, and `apply_func(id, partials, num)` merges the
+  // `num` partials of a vertex. A vertex that is not split gets one partial,
+  // applied in the same task. The partials of a hub are merged in a second
+  // pass, once all of its chunks are done.
+  void ParallelVertexReduceWithEdges(
+      const std::function<VertexData(VertexID, VertexDegree, VertexDegree)>&
+          reduce_func,
+      const std::function<void(VertexID, const VertexData*, size_t)>&
+          apply_func) {
+    LOG_DEBUG("ParallelVertexReduceWithEdges is begin");
+    if (mode_ != common::Normal) {
+      // Static and Random modes keep their own task layout, with whole
+      // vertices.
+      ParallelVertexDoWithEdges([&reduce_func, &apply_func, this](VertexID id) {
+        VertexData partial =
+            reduce_func(id, 0, graphs_->at(current_gid_).GetOutDegree(id));
+        apply_func(id, &partial, 1);
+      });
+      return;
+    }
+    auto& edge_tasks = GetEdgeTasks(current_gid_);
+    // Partials of the hub chunks of each sub-block, in task order.
+    std::vector<std::vector<VertexData>> partials(edge_tasks.size());
+    for (size_t i = 0; i < edge_tasks.size(); i++) {
+      size_t num_chunks = 0;
+      for (auto& range : edge_tasks.at(i)) {
+        if (range.IsHubChunk()) num_chunks++;
       }
-    } else {
-      common::TaskPackage tasks;
-      for (int i = 0; i < block_meta.num_sub_blocks; i++) {
-        auto sub_block_meta = block_meta.sub_blocks.at(i);
-        auto task = [&vertex_func, sub_block_meta]() {
-          auto begin_id = sub_block_meta.begin_id;
-          auto end_id = sub_block_meta.end_id;
-          for (VertexID id = begin_id; id < end_id; id++) {
-            vertex_func(id);
-          }
-        };
-        tasks.emplace_back(task);
+      partials.at(i).resize(num_chunks);
+    }
+    auto range_func = [&reduce_func, &apply_func, &partials, this](
+                          BlockID bid, const util::TaskRange& range,
+                          size_t slot) {
+      if (range.IsHubChunk()) {
+        partials.at(bid).at(slot) =
+            reduce_func(range.begin, range.edge_begin, range.edge_end);
+        return;
+      }
+      for (VertexID id = range.begin; id < range.end; id++) {
+        VertexData partial =
+            reduce_func(id, 0, graphs_->at(current_gid_).GetOutDegree(id));
+        apply_func(id, &partial, 1);
+      }
+    };
+    RunEdgeTasks(graphs_->at(current_gid_).IsEdgesLoaded(),
+                 GetAllSubBlockIDs(), range_func, false);
+
+    // Merge the partials of each hub.
+    common::TaskPackage tasks;
+    for (size_t i = 0; i < edge_tasks.size(); i++) {
+      size_t slot = 0;
+      for (auto& range : edge_tasks.at(i)) {
+        if (!range.IsHubChunk()) continue;
+        if (range.chunk_id == 0) {
+          const VertexData* hub_partials = partials.at(i).data() + slot;
+          auto task = [&apply_func, range, hub_partials]() {
+            apply_func(range.begin, hub_partials, range.num_chunks);
+          };
+          tasks.push_back(task);
+        }
+        slot++;
       }
-      runner_->SubmitSync(tasks);
     }
+    if (!tasks.empty()) runner_->SubmitSync(tasks);
     LOG_INFO("task finished");
     Sync(use_readdata_only_);
-    //    LOG_INFO("ParallelVertexDoWithEdges is done");
   }
 
   // Parallel execute edge_func in task_size chunks.
@@ -801,6 +832,141 @@ class PlanarAppBaseOp : public PIE {
     LOG_DEBUG("ParallelEdgeDeleteDo is done");
   }
 
+  // Edge balanced tasks of each sub-block of block `gid`. A sub-block gets a
+  // share of the `parallelism * task_package_factor` tasks of its block in
+  // proportion to its work (edges + vertices). Vertex degrees never change in
+  // place, so the tasks are built once from the offset index, which is
+  // resident before the edges are read.
+  const std::vector<std::vector<util::TaskRange>>& GetEdgeTasks(GraphID gid) {
+    auto& edge_tasks = edge_tasks_.at(gid);
+    if (!edge_tasks.empty()) return edge_tasks;
+    auto& graph = graphs_->at(gid);
+    auto& block_meta = meta_->blocks.at(gid);
+    size_t task_num = parallelism_ * task_package_factor_;
+    double share = ((double)block_meta.num_edges + block_meta.num_vertices) /
+                   task_num;
+    if (share < 1) share = 1;
+    edge_tasks.resize(block_meta.num_sub_blocks);
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      size_t num_tasks = ceil(
+          ((double)sub_block_meta.num_edges + sub_block_meta.num_vertices) /
+          share);
+      util::SplitByEdges(
+          sub_block_meta.begin_id, sub_block_meta.end_id, num_tasks,
+          hub_degree_, [&graph](VertexID id) { return graph.GetOutOffset(id); },
+          [&graph](VertexID id) { return graph.GetOutDegree(id); },
+          &edge_tasks.at(i));
+    }
+    return edge_tasks;
+  }
+
+  std::vector<BlockID> GetAllSubBlockIDs() const {
+    std::vector<BlockID> sub_ids(meta_->blocks.at(current_gid_).num_sub_blocks);
+    for (BlockID i = 0; i < sub_ids.size(); i++) sub_ids.at(i) = i;
+    return sub_ids;
+  }
+
+  // The sub-blocks of the current block that LoaderOp2 reads, see
+  // `EdgeBuffer2::SetSubBlockToRead`.
+  std::vector<BlockID> GetSubBlockIDsToRead() const {
+    std::vector<BlockID> sub_ids;
+    for (BlockID i = 0; i < meta_->blocks.at(current_gid_).num_sub_blocks;
+         i++) {
+      if (buffer_->IsSubBlockToRead(current_gid_, i)) sub_ids.push_back(i);
+    }
+    return sub_ids;
+  }
+
+  // Split a sub-block into `parallelism` edge balanced tasks, for Static mode.
+  common::TaskPackage GetStaticTasks(
+      const data_structures::SubBlock& sub_block_meta,
+      const std::function<void(VertexID)>& vertex_func) {
+    auto& graph = graphs_->at(current_gid_);
+    std::vector<util::TaskRange> ranges;
+    util::SplitByEdges(
+        sub_block_meta.begin_id, sub_block_meta.end_id, parallelism_, 0,
+        [&graph](VertexID id) { return graph.GetOutOffset(id); },
+        [&graph](VertexID id) { return graph.GetOutDegree(id); }, &ranges);
+    common::TaskPackage tasks;
+    for (auto& range : ranges) {
+      auto task = [&vertex_func, range] {
+        for (VertexID id = range.begin; id < range.end; id++) {
+          vertex_func(id);
+        }
+      };
+      tasks.push_back(task);
+    }
+    return tasks;
+  }
+
+  // Run `range_func(bid, range, slot)` for the edge balanced tasks of the
+  // sub-blocks `sub_ids` of the current block, where `slot` is the position
+  // of a hub chunk among the hub chunks of its sub-block. If the edges are not
+  // loaded, the read is issued and the tasks of a sub-block are submitted as
+  // soon as it arrives. With `whole_vertex`, only the first chunk of a hub is
+  // run.
+  void RunEdgeTasks(
+      bool loaded, const std::vector<BlockID>& sub_ids,
+      const std::function<void(BlockID, const util::TaskRange&, size_t)>&
+          range_func,
+      bool whole_vertex) {
+    auto& edge_tasks = GetEdgeTasks(current_gid_);
+    auto get_tasks = [&](BlockID bid) {
+      common::TaskPackage tasks;
+      size_t slot = 0;
+      for (auto& range : edge_tasks.at(bid)) {
+        size_t s = slot;
+        if (range.IsHubChunk()) {
+          slot++;
+          if (whole_vertex && range.chunk_id != 0) continue;
+        }
+        auto task = [&range_func, bid, range, s]() {
+          range_func(bid, range, s);
+        };
+        tasks.push_back(task);
+      }
+      return tasks;
+    };
+    if (loaded) {
+      common::TaskPackage tasks;
+      for (auto bid : sub_ids) {
+        auto sub_tasks = get_tasks(bid);
+        tasks.insert(tasks.end(), sub_tasks.begin(), sub_tasks.end());
+      }
+      runner_->SubmitSync(tasks);
+      return;
+    }
+    // Each sub-block not yet arrived counts as one pending task.
+    int size_num = sub_ids.size();
+    scheduler::ReadMessage read;
+    read.graph_id = current_gid_;
+    hub_->get_reader_queue()->Push(read);
+    auto queue = buffer_->GetQueue();
+    while (true) {
+      auto bid = queue->PopOrWait();
+      if (bid == MAX_VERTEX_ID) break;
+      auto tasks = get_tasks(bid);
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        size_num += (int)tasks.size() - 1;
+      }
+      for (auto& sub_task : tasks) {
+        auto task = [sub_task, &size_num, this]() {
+          sub_task();
+          std::lock_guard<std::mutex> lock(mtx_);
+          size_num -= 1;
+          cv_.notify_all();
+        };
+        runner_->SubmitAsync(task);
+      }
+    }
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (size_num != 0) {
+      cv_.wait(lock, [&size_num]() { return size_num == 0; });
+    }
+  }
+
   size_t GetTaskSize(VertexID max_vid) const {
     auto task_num = parallelism_ * task_package_factor_;
     size_t task_size = ceil((double)max_vid / task_num);
@@ -818,6 +984,12 @@ class PlanarAppBaseOp : public PIE {
     actives_.at(block_id).SetBit(idx);
   }
 
+  bool IsVertexActive(VertexID id) {
+    auto block_id = GetBlockID(id);
+    auto idx = id - meta_->blocks.at(block_id).begin_id;
+    return actives_.at(block_id).GetBit(idx);
+  }
+
   void SetVertexActive(VertexID id) {
     auto block_id = GetBlockID(id);
     auto idx = id - meta_->blocks.at(block_id).begin_id;
@@ -825,17 +997,20 @@ class PlanarAppBaseOp : public PIE {
   }
 
   void SyncSubGraphActive() {
+    PROFILE_SCOPE("bitmap.swap_clear");
     std::swap(actives_.at(current_gid_), next_actives_.at(current_gid_));
     next_actives_.at(current_gid_).Clear();
   }
 
   size_t GetActiveNum() {
+    PROFILE_SCOPE("bitmap.count");
     auto& bitmap = actives_.at(current_gid_);
     //    LOGF_INFO("Gid: {}, active num: {}", current_gid_, bitmap.Count());
     return bitmap.Count();
   }
 
   void Sync(bool read_only = false) {
+    PROFILE_SCOPE("app.sync");
     if (use_data_) {
       if (!read_only) {
         memcpy(read_, write_, sizeof(VertexData) * meta_->num_vertices);
@@ -851,29 +1026,28 @@ class PlanarAppBaseOp : public PIE {
 
   void WriteActive(VertexID id, VertexData vdata) {
     write_[id] = vdata;
-    active++;
+    AddActive();
   }
 
   void WriteMin(VertexID id, VertexData vdata) {
     if (core::util::atomic::WriteMin(&write_[id], vdata)) {
-      active++;
+      AddActive();
     }
   }
 
   void WriteMax(VertexID id, VertexData vdata) {
     if (core::util::atomic::WriteMax(&write_[id], vdata)) {
-      active++;
+      AddActive();
     }
   }
 
   void WriteAdd(VertexID id, VertexData vdata) {
-    if (core::util::atomic::WriteAdd(&write_[id], vdata)) {
-      active++;
-    }
+    core::util::atomic::WriteAdd(&write_[id], vdata);
+    AddActive();
   }
 
   void WriteOneBuffer(VertexID id, VertexData vdata) {
-    active++;
+    AddActive();
     read_[id] = vdata;
   }
 
@@ -897,6 +1071,12 @@ class PlanarAppBaseOp : public PIE {
     return graphs_->at(block_id).GetOutEdges(id);
   }
 
+  // nullptr if the graph is not weighted.
+  common::EdgeWeight* GetOutWeights(VertexID id) {
+    auto block_id = GetBlockID(id);
+    return graphs_->at(block_id).GetOutWeights(id);
+  }
+
   void DeleteEdge(VertexID id, EdgeIndex idx) {
     auto block_id = GetBlockID(id);
     graphs_->at(block_id).DeleteEdge(id, idx);
@@ -931,10 +1111,36 @@ class PlanarAppBaseOp : public PIE {
 
   void SetInActive() override { active = 0; }
 
+  // ID mapping of graphs relabeled by graph_converter. Without a permutation
+  // both are the identity.
+
+  // The input ID of vertex `id`.
+  VertexID GetOriginalID(VertexID id) const {
+    return new2old_.empty() ? id : new2old_.at(id);
+  }
+
+  // The vertex ID of input ID `original_id`, e.g. for a source vertex given
+  // on the command line.
+  VertexID GetRelabeledID(VertexID original_id) const {
+    if (new2old_.empty()) return original_id;
+    if (original_id >= old2new_.size() ||
+        old2new_[original_id] == MAX_VERTEX_ID) {
+      LOGF_FATAL("Vertex {} is not in the permutation", original_id);
+    }
+    return old2new_[original_id];
+  }
+
+  // The block holding vertex `id`.
+  GraphID GetBlockOf(VertexID id) const {
+    return std::upper_bound(block_ends_.begin(), block_ends_.end(), id) -
+           block_ends_.begin();
+  }
+
   // Log functions.
   void LogVertexState() {
     for (VertexID id = 0; id < meta_->num_vertices; id++) {
-      LOGF_INFO("Vertex: {}, read: {} write: {}", id, read_[id], write_[id]);
+      LOGF_INFO("Vertex: {}, read: {} write: {}", GetOriginalID(id), read_[id],
+                write_[id]);
     }
   }
 
@@ -958,6 +1164,41 @@ class PlanarAppBaseOp : public PIE {
   }
 
  private:
+  // The write functions run in parallel tasks. `active` is only read as a
+  // flag, so they set it once with relaxed atomics instead of all contending
+  // for its cache line with read-modify-writes.
+  void AddActive() {
+    std::atomic_ref<size_t> ref(active);
+    if (!ref.load(std::memory_order_relaxed)) {
+      ref.store(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Load a permutation written by graph_converter: the input ID of every
+  // vertex ID, as a binary array of VertexID.
+  void LoadPermutation(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) LOGF_FATAL("Error opening permutation file: {}", path);
+    size_t num_vertices = file.tellg() / sizeof(VertexID);
+    if (num_vertices != meta_->num_vertices) {
+      LOGF_FATAL("Permutation of {} vertices for a graph of {} vertices",
+                 num_vertices, meta_->num_vertices);
+    }
+    new2old_.resize(num_vertices);
+    file.seekg(0);
+    file.read((char*)new2old_.data(), num_vertices * sizeof(VertexID));
+    // Input IDs need not be dense, so the inverse covers up to the largest.
+    VertexID max_original_id = 0;
+    for (auto original_id : new2old_) {
+      max_original_id = std::max(max_original_id, original_id);
+    }
+    old2new_.assign((size_t)max_original_id + 1, MAX_VERTEX_ID);
+    for (VertexID id = 0; id < new2old_.size(); id++) {
+      if (old2new_[new2old_[id]] == MAX_VERTEX_ID) old2new_[new2old_[id]] = id;
+    }
+    LOGF_INFO("Loaded vertex permutation: {}", path);
+  }
+
   BlockID GetBlockID(VertexID id) {
     for (int i = 0; i < meta_->num_blocks; i++) {
       if (id < meta_->blocks.at(i).end_id) {
@@ -1002,9 +1243,21 @@ class PlanarAppBaseOp : public PIE {
   std::mutex mtx_;
   std::condition_variable cv_;
 
+  // input ID of every vertex, empty if the graph is not relabeled.
+  std::vector<VertexID> new2old_;
+  // vertex ID of every input ID, or MAX_VERTEX_ID for those not in new2old_.
+  std::vector<VertexID> old2new_;
+
+  // end_id of every block, to find the block of a vertex.
+  std::vector<VertexID> block_ends_;
+
+  // edge balanced tasks of each block, indexed by block and sub-block id.
+  std::vector<std::vector<std::vector<util::TaskRange>>> edge_tasks_;
+
   // configs
   uint32_t parallelism_;
   uint32_t task_package_factor_;
+  uint32_t hub_degree_ = 0;
   common::ApplicationType app_type_;
   bool use_readdata_only_ = false;
   bool use_data_ = true;
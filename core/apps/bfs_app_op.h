@@ -0,0 +1,271 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_BFS_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_BFS_APP_OP_H
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/types.h"
+#include "util/atomic.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: level synchronous BFS from `source`, recording the level and
+// the parent of every vertex. The vertex data packs both as
+// `level << 32 | parent`, so one WriteMin keeps the smallest level and, among
+// the parents of that level, the smallest ID.
+//
+// The frontier is the active bitmap of the subgraph. A step expands the
+// frontier vertices of the smallest level, either top-down, pushing to their
+// neighbors, or bottom-up, with every vertex of a larger level looking for a
+// neighbor in the frontier and stopping at the first one. Bottom-up steps are
+// taken when the frontier is large (see `bottom_up_ratio`) and need a
+// symmetric graph.
+//
+// Out of core, a sub-block whose vertices are all visited and inactive needs
+// no edges in the evaluation, so it is not read at all.
+class BfsAppOp : public apis::PlanarAppBaseOp<uint64_t> {
+  using BlockID = common::BlockID;
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+  static constexpr uint64_t kUnvisited = std::numeric_limits<uint64_t>::max();
+  static constexpr uint32_t kNoLevel = std::numeric_limits<uint32_t>::max();
+
+ public:
+  BfsAppOp() : apis::PlanarAppBaseOp<uint64_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint64_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    source_ = GetRelabeledID(common::Configurations::Get()->source);
+    bottom_up_ratio_ = common::Configurations::Get()->bottom_up_ratio;
+    skip_sub_blocks_ =
+        !common::Configurations::Get()->in_memory && mode_ == common::Normal;
+  }
+
+  ~BfsAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Init(id); };
+
+    SyncSubGraphActive();
+    ParallelVertexInitDo(init);
+    RunLevels();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    SyncSubGraphActive();
+    RunLevels();
+  }
+
+  void Assemble() final {}
+
+  static uint32_t GetLevel(uint64_t data) { return data >> 32; }
+
+  static VertexID GetParent(uint64_t data) { return (VertexID)data; }
+
+ private:
+  static uint64_t Pack(uint32_t level, VertexID parent) {
+    return (uint64_t)level << 32 | parent;
+  }
+
+  void Init(VertexID id) {
+    if (id == source_) {
+      Write(id, Pack(0, id));
+      InitVertexActive(id);
+      LOGF_INFO("source of BFS: {}", id);
+    } else {
+      Write(id, kUnvisited);
+    }
+  }
+
+  // Expand the frontier of the current subgraph level by level, until none
+  // of its vertices is active.
+  void RunLevels() {
+    auto top_down = [this](VertexID id) { TopDown(id); };
+    auto bottom_up = [this](VertexID id) { BottomUp(id); };
+    auto num_vertices = meta_->blocks.at(current_gid_).num_vertices;
+    size_t num_steps = 0, num_bottom_up = 0;
+
+    SelectSubBlocksToRead();
+    level_ = GetMinActiveLevel();
+    while (level_ != kNoLevel) {
+      next_level_ = kNoLevel;
+      auto frontier = GetActiveNum();
+      if (bottom_up_ratio_ != 0 && frontier * bottom_up_ratio_ > num_vertices) {
+        ParallelVertexDoWithEdges(bottom_up);
+        num_bottom_up++;
+      } else {
+        ParallelVertexDoWithEdges(top_down);
+      }
+      SyncSubGraphActive();
+      LOGF_INFO("level {} finished, frontier: {}", level_, frontier);
+      level_ = next_level_;
+      num_steps++;
+    }
+    LOGF_INFO("BFS finished, steps: {}, bottom-up steps: {}", num_steps,
+              num_bottom_up);
+
+    // Vertices reached in sub-blocks that were not read wait for the next
+    // evaluation.
+    for (auto id : deferred_) SetVertexActive(id);
+    deferred_.clear();
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, true);
+    }
+    skipped_.clear();
+  }
+
+  // Mark the sub-blocks with no active and no unvisited vertex as not to
+  // read.
+  void SelectSubBlocksToRead() {
+    if (!skip_sub_blocks_) return;
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    skipped_.assign(block_meta.num_sub_blocks, 0);
+    common::TaskPackage tasks;
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      tasks.push_back([this, i, &sub_block_meta]() {
+        for (VertexID id = sub_block_meta.begin_id; id < sub_block_meta.end_id;
+             id++) {
+          if (IsVertexActive(id) || Read(id) == kUnvisited) return;
+        }
+        skipped_.at(i) = 1;
+      });
+    }
+    runner_->SubmitSync(tasks);
+    size_t num_skipped = 0;
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, !skipped_.at(i));
+      num_skipped += skipped_.at(i);
+    }
+    LOGF_INFO("sub-blocks not to read: {} of {}", num_skipped,
+              block_meta.num_sub_blocks);
+  }
+
+  uint32_t GetMinActiveLevel() {
+    auto& bitmap = actives_.at(current_gid_);
+    auto begin_id = meta_->blocks.at(current_gid_).begin_id;
+    uint32_t level = kNoLevel;
+    for (size_t idx = 0; idx < bitmap.size(); idx++) {
+      if (idx % 64 == 0 && !bitmap.GetBit64(idx)) {
+        idx += 63;
+        continue;
+      }
+      if (bitmap.GetBit(idx)) {
+        level = std::min(level, GetLevel(Read(begin_id + idx)));
+      }
+    }
+    return level;
+  }
+
+  bool IsInCurrentBlock(VertexID id) {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    return id >= block_meta.begin_id && id < block_meta.end_id;
+  }
+
+  bool IsSkipped(VertexID id) {
+    return !skipped_.empty() &&
+           skipped_.at(graphs_->at(current_gid_).GetSubBlockID(id));
+  }
+
+  // If `id` can pull from the frontier in a bottom-up step, i.e. is iterated.
+  bool IsPulling(VertexID id) { return IsInCurrentBlock(id) && !IsSkipped(id); }
+
+  bool IsInFrontier(VertexID id) {
+    return IsPulling(id) && IsVertexActive(id) && GetLevel(Read(id)) == level_;
+  }
+
+  // `id` stays active for a later level.
+  void Carry(VertexID id, uint32_t level) {
+    SetVertexActive(id);
+    util::atomic::WriteMin(&next_level_, level);
+  }
+
+  void Activate(VertexID id, uint32_t level) {
+    if (!IsInCurrentBlock(id)) {
+      SetVertexActive(id);
+    } else if (IsSkipped(id)) {
+      std::lock_guard<std::mutex> lock(deferred_mtx_);
+      deferred_.push_back(id);
+    } else {
+      Carry(id, level);
+    }
+  }
+
+  void Visit(VertexID id, uint32_t level, VertexID parent) {
+    WriteMin(id, Pack(level, parent));
+    Activate(id, level);
+  }
+
+  // Push the next level to the neighbors of a frontier vertex. Unless
+  // `pulling_too`, neighbors that pull in this step are left to themselves.
+  void Push(VertexID id, bool pulling_too) {
+    auto degree = GetOutDegree(id);
+    auto edges = GetOutEdges(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      auto dst_id = edges[i];
+      if (!pulling_too && IsPulling(dst_id)) continue;
+      if (level_ + 1 < GetLevel(Read(dst_id))) Visit(dst_id, level_ + 1, id);
+    }
+  }
+
+  void TopDown(VertexID id) {
+    if (!IsVertexActive(id)) return;
+    auto level = GetLevel(Read(id));
+    if (level != level_) {
+      Carry(id, level);
+      return;
+    }
+    Push(id, true);
+  }
+
+  void BottomUp(VertexID id) {
+    auto level = GetLevel(Read(id));
+    auto active = IsVertexActive(id);
+    if (active && level == level_) {
+      Push(id, false);
+      return;
+    }
+    if (level > level_ + 1) {
+      auto degree = GetOutDegree(id);
+      auto edges = GetOutEdges(id);
+      for (VertexDegree i = 0; i < degree; i++) {
+        if (IsInFrontier(edges[i])) {
+          Visit(id, level_ + 1, edges[i]);
+          return;
+        }
+      }
+    }
+    if (active) Carry(id, level);
+  }
+
+ private:
+  VertexID source_ = 0;
+  uint32_t bottom_up_ratio_ = 0;
+  bool skip_sub_blocks_ = false;
+
+  uint32_t level_ = kNoLevel;
+  uint32_t next_level_ = kNoLevel;
+
+  // sub-blocks of the current subgraph that are not read, empty if all are.
+  // Not a vector<bool>, as they are set in parallel.
+  std::vector<uint8_t> skipped_;
+  // vertices reached in skipped sub-blocks.
+  std::vector<VertexID> deferred_;
+  std::mutex deferred_mtx_;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_BFS_APP_OP_H
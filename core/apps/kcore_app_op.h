@@ -0,0 +1,207 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_KCORE_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_KCORE_APP_OP_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/types.h"
+#include "util/atomic.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: k-core decomposition by peeling, with the coreness of every
+// vertex as its data. Needs a symmetric graph.
+//
+// Vertices are bucketed by their remaining degree, and buckets are peeled in
+// increasing order, one per round of the scheduler, so a level is finished in
+// every subgraph before the next starts. The current bucket of a subgraph is
+// its active bitmap, and all of its vertices are peeled at once in a step,
+// decrementing the degrees of their neighbors. A degree never drops below the
+// level, and a neighbor that reaches it joins the bucket, in the next step if
+// it is in the current subgraph, or when its subgraph runs otherwise.
+//
+// Every subgraph keeps a lower bound of the degrees of its vertices left, so
+// empty buckets are skipped, and so are the subgraphs with nothing to peel at
+// the level, without reading their edges. Out of core, only the sub-blocks of
+// the vertices in the bucket are read.
+class KCoreAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using GraphID = common::GraphID;
+  using BlockID = common::BlockID;
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+  static constexpr uint32_t kUnpeeled = std::numeric_limits<uint32_t>::max();
+
+ public:
+  KCoreAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    if (mode_ != common::Normal) LOG_FATAL("k-core only runs in normal mode");
+    skip_sub_blocks_ = !common::Configurations::Get()->in_memory;
+    // Degrees are read from the offset index, which is resident.
+    degrees_.resize(meta->num_vertices);
+    min_degrees_.resize(meta->num_blocks, kUnpeeled);
+    for (GraphID i = 0; i < meta->num_blocks; i++) {
+      auto& block_meta = meta->blocks.at(i);
+      for (VertexID id = block_meta.begin_id; id < block_meta.end_id; id++) {
+        degrees_.at(id) = graphs->at(i).GetOutDegree(id);
+        min_degrees_.at(i) = std::min(min_degrees_.at(i), degrees_.at(id));
+      }
+    }
+    num_left_ = meta->num_vertices;
+  }
+
+  ~KCoreAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Write(id, kUnpeeled); };
+
+    ParallelVertexInitDo(init);
+    Peel();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    Peel();
+  }
+
+  void Assemble() final {}
+
+ private:
+  // Peel the bucket of the level of this round in the current subgraph.
+  void Peel() {
+    if (round_ != level_round_) {
+      level_round_ = round_;
+      level_ = *std::min_element(min_degrees_.begin(), min_degrees_.end());
+      LOGF_INFO("peeling level {}, vertices left: {}", level_, num_left_);
+    }
+    if (min_degrees_.at(current_gid_) <= level_) {
+      auto peel = [this](VertexID id) { PeelVertex(id); };
+      size_t num_steps = 0, num_peeled = 0;
+      FillBucket();
+      auto size = GetActiveNum();
+      while (size != 0) {
+        ParallelVertexDoWithEdges(peel);
+        SyncSubGraphActive();
+        num_peeled += size;
+        num_steps++;
+        size = GetActiveNum();
+      }
+      for (BlockID i = 0; i < skipped_.size(); i++) {
+        buffer_->SetSubBlockToRead(current_gid_, i, true);
+      }
+      num_left_ -= num_peeled;
+      UpdateMinDegree();
+      LOGF_INFO("level {} peeled: {} in {} steps", level_, num_peeled,
+                num_steps);
+    }
+    if (num_left_ != 0) {
+      SetActive();
+    } else if (!finished_) {
+      finished_ = true;
+      LOGF_INFO("k-core finished, max coreness: {}", level_);
+    }
+  }
+
+  // Activate the vertices left with a degree of at most the level, and mark
+  // the sub-blocks without any as not to read.
+  void FillBucket() {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    skipped_.assign(block_meta.num_sub_blocks, 0);
+    common::TaskPackage tasks;
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      tasks.push_back([this, i, &sub_block_meta]() {
+        bool empty = true;
+        for (VertexID id = sub_block_meta.begin_id; id < sub_block_meta.end_id;
+             id++) {
+          if (Read(id) != kUnpeeled || degrees_[id] > level_) continue;
+          InitVertexActive(id);
+          empty = false;
+        }
+        skipped_.at(i) = empty && skip_sub_blocks_;
+      });
+    }
+    runner_->SubmitSync(tasks);
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, !skipped_.at(i));
+    }
+  }
+
+  // The smallest degree of the vertices left in the current subgraph.
+  void UpdateMinDegree() {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    std::vector<uint32_t> mins(block_meta.num_sub_blocks, kUnpeeled);
+    common::TaskPackage tasks;
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      tasks.push_back([this, i, &sub_block_meta, &mins]() {
+        for (VertexID id = sub_block_meta.begin_id; id < sub_block_meta.end_id;
+             id++) {
+          if (Read(id) == kUnpeeled) mins[i] = std::min(mins[i], degrees_[id]);
+        }
+      });
+    }
+    runner_->SubmitSync(tasks);
+    min_degrees_.at(current_gid_) = *std::min_element(mins.begin(), mins.end());
+  }
+
+  void PeelVertex(VertexID id) {
+    if (!IsVertexActive(id)) return;
+    Write(id, level_);
+    auto degree = GetOutDegree(id);
+    auto edges = GetOutEdges(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      if (Read(edges[i]) == kUnpeeled) Decrement(edges[i]);
+    }
+  }
+
+  // Decrement the degree of `id`, down to the level at most.
+  void Decrement(VertexID id) {
+    uint32_t degree;
+    do {
+      degree = degrees_[id];
+      if (degree <= level_) return;
+    } while (!util::atomic::CAS(&degrees_[id], degree, degree - 1));
+    if (degree - 1 != level_) return;
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    if (id >= block_meta.begin_id && id < block_meta.end_id &&
+        !skipped_.at(graphs_->at(current_gid_).GetSubBlockID(id))) {
+      SetVertexActive(id);
+    } else {
+      // Its subgraph peels it at this level, in this round or the next.
+      util::atomic::WriteMin(&min_degrees_.at(GetBlockOf(id)), level_);
+    }
+  }
+
+ private:
+  bool skip_sub_blocks_ = false;
+
+  // remaining degree of every vertex, and a lower bound of the degrees left
+  // in each subgraph.
+  std::vector<uint32_t> degrees_;
+  std::vector<uint32_t> min_degrees_;
+
+  uint32_t level_ = 0;
+  int level_round_ = -1;
+  size_t num_left_ = 0;
+  bool finished_ = false;
+
+  // sub-blocks of the current subgraph that are not read.
+  // Not a vector<bool>, as they are set in parallel.
+  std::vector<uint8_t> skipped_;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_KCORE_APP_OP_H
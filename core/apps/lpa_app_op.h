@@ -0,0 +1,85 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_LPA_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_LPA_APP_OP_H
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/types.h"
+#include "util/atomic.h"
+#include "util/label_histogram.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: community detection by label propagation. Every vertex starts
+// with its own ID as label, and takes the most frequent label of its
+// neighbors, the smallest one on ties, until no label changes or for
+// `lpa_iter` rounds. Needs a symmetric graph.
+//
+// One round updates every subgraph once. Labels are written in place, so a
+// subgraph sees the labels updated by the subgraphs run before it in the
+// round, which damps the oscillation of synchronous propagation.
+class LpaAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+ public:
+  LpaAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    max_round_ = common::Configurations::Get()->lpa_iter;
+  }
+
+  ~LpaAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Write(id, id); };
+
+    ParallelVertexInitDo(init);
+    Propagate();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    Propagate();
+  }
+
+  void Assemble() final {}
+
+ private:
+  void Propagate() {
+    if (round_ >= max_round_) return;
+    auto update = [this](VertexID id) { Update(id); };
+
+    num_changed_ = 0;
+    ParallelVertexDoWithEdges(update);
+    LOGF_INFO("label propagation round {}, labels changed: {}", round_,
+              num_changed_);
+    if (num_changed_ != 0) SetActive();
+  }
+
+  void Update(VertexID id) {
+    auto degree = GetOutDegree(id);
+    if (degree == 0) return;
+    auto edges = GetOutEdges(id);
+    thread_local util::LabelHistogram histogram;
+    auto label = histogram.MostFrequent(
+        degree, [this, edges](size_t i) { return Read(edges[i]); });
+    if (label == Read(id)) return;
+    Write(id, label);
+    util::atomic::WriteAdd(&num_changed_, (size_t)1);
+  }
+
+ private:
+  int max_round_ = 0;
+  size_t num_changed_ = 0;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_LPA_APP_OP_H
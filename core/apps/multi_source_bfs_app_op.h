@@ -0,0 +1,227 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_MULTI_SOURCE_BFS_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_MULTI_SOURCE_BFS_APP_OP_H
+
+#include <algorithm>
+#include <vector>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/types.h"
+#include "util/atomic.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: BFS from up to 64 sources at once (MS-BFS), sharing every
+// read of the edges between them. The data of every vertex is the bitset of
+// the sources that reached it, bit i for `sources[i]`, and the distance
+// statistics of every source are logged at the end.
+//
+// Levels are synchronous across subgraphs, one per round of the scheduler:
+// a vertex that joins the frontier of some sources at level l is expanded for
+// all of them at once in round l, with the bitset of those sources pushed to
+// its neighbors by a single atomic or. The frontiers and seen bitsets are
+// advanced between rounds. Subgraphs without frontier vertices read no edges,
+// and out of core, neither do the sub-blocks without them.
+class MultiSourceBfsAppOp : public apis::PlanarAppBaseOp<uint64_t> {
+  using BlockID = common::BlockID;
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+ public:
+  static constexpr size_t kMaxSources = 64;
+
+  MultiSourceBfsAppOp() : apis::PlanarAppBaseOp<uint64_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint64_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    if (mode_ != common::Normal) {
+      LOG_FATAL("multi-source bfs only runs in normal mode");
+    }
+    auto& sources = common::Configurations::Get()->sources;
+    if (sources.empty() || sources.size() > kMaxSources) {
+      LOGF_FATAL("multi-source bfs needs 1 to {} sources, got {}", kMaxSources,
+                 sources.size());
+    }
+    for (auto source : sources) {
+      auto id = GetRelabeledID(source);
+      if (id >= meta->num_vertices) LOGF_FATAL("invalid source: {}", source);
+      sources_.push_back(id);
+    }
+    skip_sub_blocks_ = !common::Configurations::Get()->in_memory;
+    visit_.resize(meta->num_vertices, 0);
+    next_.resize(meta->num_vertices, 0);
+    num_reached_.resize(sources_.size(), 0);
+    distance_sums_.resize(sources_.size(), 0);
+    eccentricities_.resize(sources_.size(), 0);
+  }
+
+  ~MultiSourceBfsAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Write(id, 0); };
+
+    if (!data_init_) {
+      ParallelVertexInitDo(init);
+      for (size_t i = 0; i < sources_.size(); i++) {
+        write_[sources_[i]] |= uint64_t(1) << i;
+        visit_[sources_[i]] |= uint64_t(1) << i;
+        num_reached_[i] = 1;
+      }
+      Sync();
+      LOGF_INFO("multi-source bfs from {} sources", sources_.size());
+    }
+    Expand();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    Expand();
+  }
+
+  void Assemble() final {}
+
+  // Statistics of source i, valid once the app finished.
+  size_t GetNumReached(size_t i) const { return num_reached_.at(i); }
+  uint64_t GetDistanceSum(size_t i) const { return distance_sums_.at(i); }
+  uint32_t GetEccentricity(size_t i) const { return eccentricities_.at(i); }
+
+ private:
+  void Expand() {
+    if (round_ != level_round_) {
+      level_round_ = round_;
+      if (round_ != 0) AdvanceLevel();
+    }
+    if (finished_) return;
+    SetActive();
+    if (!SelectSubBlocksToRead()) return;
+    auto push = [this](VertexID id) { Push(id); };
+    ParallelVertexDoWithEdges(push);
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, true);
+    }
+  }
+
+  // Push the sources of the frontier at `id` to its neighbors, except to
+  // those they reached already.
+  void Push(VertexID id) {
+    auto mask = visit_[id];
+    if (mask == 0) return;
+    auto degree = GetOutDegree(id);
+    auto edges = GetOutEdges(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      auto dst_id = edges[i];
+      auto bits = mask & ~Read(dst_id);
+      if (bits != 0) util::atomic::WriteOr(&next_[dst_id], bits);
+    }
+  }
+
+  // Move the vertices reached in the last round to the frontier of level
+  // `round_`, and finish if there are none.
+  void AdvanceLevel() {
+    uint32_t level = round_;
+    auto task_size = GetTaskSize(meta_->num_vertices);
+    size_t num_tasks = (meta_->num_vertices + task_size - 1) / task_size;
+    // Per task counts of the vertices reached by each source.
+    std::vector<std::vector<size_t>> counts(num_tasks);
+    common::TaskPackage tasks;
+    for (size_t i = 0; i < num_tasks; i++) {
+      VertexID begin_id = i * task_size;
+      VertexID end_id =
+          std::min((VertexID)(begin_id + task_size), meta_->num_vertices);
+      tasks.push_back([this, i, begin_id, end_id, &counts]() {
+        auto& count = counts[i];
+        count.resize(sources_.size(), 0);
+        for (VertexID id = begin_id; id < end_id; id++) {
+          auto reached = next_[id] & ~Read(id);
+          next_[id] = 0;
+          visit_[id] = reached;
+          if (reached == 0) continue;
+          Write(id, Read(id) | reached);
+          while (reached != 0) {
+            count[__builtin_ctzll(reached)]++;
+            reached &= reached - 1;
+          }
+        }
+      });
+    }
+    runner_->SubmitSync(tasks);
+    Sync();
+    size_t frontier = 0;
+    for (size_t s = 0; s < sources_.size(); s++) {
+      size_t num = 0;
+      for (auto& count : counts) num += count[s];
+      if (num == 0) continue;
+      num_reached_[s] += num;
+      distance_sums_[s] += (uint64_t)num * level;
+      eccentricities_[s] = level;
+      frontier += num;
+    }
+    LOGF_INFO("level {}: {} (vertex, source) pairs reached", level, frontier);
+    if (frontier == 0) Finish();
+  }
+
+  void Finish() {
+    finished_ = true;
+    for (size_t s = 0; s < sources_.size(); s++) {
+      LOGF_INFO("source {}: reached {}, eccentricity {}, distance sum {}",
+                common::Configurations::Get()->sources.at(s), num_reached_[s],
+                eccentricities_[s], distance_sums_[s]);
+    }
+  }
+
+  // Mark the sub-blocks without frontier vertices as not to read. Returns if
+  // the current subgraph has any frontier vertex.
+  bool SelectSubBlocksToRead() {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    skipped_.assign(block_meta.num_sub_blocks, 0);
+    common::TaskPackage tasks;
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      tasks.push_back([this, i, &sub_block_meta]() {
+        for (VertexID id = sub_block_meta.begin_id; id < sub_block_meta.end_id;
+             id++) {
+          if (visit_[id] != 0) return;
+        }
+        skipped_.at(i) = 1;
+      });
+    }
+    runner_->SubmitSync(tasks);
+    size_t num_skipped = std::count(skipped_.begin(), skipped_.end(), 1);
+    if (num_skipped == skipped_.size()) return false;
+    if (skip_sub_blocks_) {
+      for (BlockID i = 0; i < skipped_.size(); i++) {
+        buffer_->SetSubBlockToRead(current_gid_, i, !skipped_.at(i));
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::vector<VertexID> sources_;
+  bool skip_sub_blocks_ = false;
+
+  // sources of the frontier at every vertex in this level, and of the next.
+  std::vector<uint64_t> visit_;
+  std::vector<uint64_t> next_;
+
+  std::vector<size_t> num_reached_;
+  std::vector<uint64_t> distance_sums_;
+  std::vector<uint32_t> eccentricities_;
+
+  int level_round_ = -1;
+  bool finished_ = false;
+
+  // sub-blocks of the current subgraph without frontier vertices.
+  // Not a vector<bool>, as they are set in parallel.
+  std::vector<uint8_t> skipped_;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_MULTI_SOURCE_BFS_APP_OP_H
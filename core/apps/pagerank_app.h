@@ -39,12 +39,17 @@ class PageRankApp : public apis::PlanarAppBaseOp<float> {
     LOG_INFO("PEval begins!");
     auto count_degree = [this](VertexID id) { CountDegree(id); };
     auto init = [this](VertexID id) { Init(id); };
-    auto pull = [this](VertexID id) { Pull(id); };
+    auto pull_sum = [this](VertexID id, VertexDegree begin, VertexDegree end) {
+      return PullSum(id, begin, end);
+    };
+    auto pull_apply = [this](VertexID id, const VertexData* sums, size_t num) {
+      PullApply(id, sums, num);
+    };
 
     ParallelVertexInitDo(init);
     //    LogVertexState();
 
-    ParallelVertexDoWithEdges(pull);
+    ParallelVertexReduceWithEdges(pull_sum, pull_apply);
 
     SetActive();
 
@@ -52,9 +57,14 @@ class PageRankApp : public apis::PlanarAppBaseOp<float> {
   }
   void IncEval() final {
     LOG_INFO("IncEval begins!");
-    auto pull = [this](VertexID id) { Pull(id); };
+    auto pull_sum = [this](VertexID id, VertexDegree begin, VertexDegree end) {
+      return PullSum(id, begin, end);
+    };
+    auto pull_apply = [this](VertexID id, const VertexData* sums, size_t num) {
+      PullApply(id, sums, num);
+    };
 
-    ParallelVertexDoWithEdges(pull);
+    ParallelVertexReduceWithEdges(pull_sum, pull_apply);
 
     if (round_ >= int(iter - 1)) {
       UnsetActive();
@@ -80,13 +90,25 @@ class PageRankApp : public apis::PlanarAppBaseOp<float> {
     }
   }
 
-  void Pull(VertexID id) {
+  // Sum of the ranks over the out edges [begin, end) of `id`. Hubs are pulled
+  // in several edge ranges, whose sums are merged by `PullApply`.
+  VertexData PullSum(VertexID id, VertexDegree begin, VertexDegree end) {
+    float sum = 0;
+    if (end != 0) {
+      auto edges = GetOutEdges(id);
+      for (VertexDegree i = begin; i < end; i++) {
+        sum += Read(edges[i]);
+      }
+    }
+    return sum;
+  }
+
+  void PullApply(VertexID id, const VertexData* sums, size_t num) {
     auto degree = GetOutDegree(id);
     if (degree != 0) {
-      auto edges = GetOutEdges(id);
       float sum = 0;
-      for (VertexDegree i = 0; i < degree; i++) {
-        sum += Read(edges[i]);
+      for (size_t i = 0; i < num; i++) {
+        sum += sums[i];
       }
       float pr_new = 0;
       if (round_ == int(iter)) {
@@ -1,16 +1,48 @@
 #ifndef GRAPH_SYSTEMS_CORE_APPS_RANDOMWALK_APP_OP_H
 #define GRAPH_SYSTEMS_CORE_APPS_RANDOMWALK_APP_OP_H
 
-#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <vector>
 
 #include "apis/planar_app_base_op.h"
 #include "common/types.h"
-#include "data_structures/graph/mutable_csr_graph.h"
+#include "util/alias_table.h"
+#include "util/atomic.h"
+#include "util/random.h"
 
 namespace sics::graph::core::apps {
 
+// @DESCRIPTION: random walks of `walk` steps, `walks_per_vertex` from every
+// vertex, scheduled by walker as in GraphWalker. A walk stops early at a
+// vertex without out edges. Weighted blocks are walked with the probability
+// of an edge proportional to its weight, by alias tables built for the
+// vertices of the sub-blocks read.
+//
+// Walkers are bucketed by the subgraph of their current vertex. When a
+// subgraph runs, its walkers are advanced until they leave it, and moved to
+// the bucket of the subgraph they enter. Subgraphs without walkers are not
+// read, and out of core, neither are the sub-blocks without any. The
+// generator of a walker step is derived from the seed, the walk and the step,
+// so the walks do not depend on the order of the subgraphs or the threads.
+//
+// The walks are streamed to `walk_output`, if set, as the segments walked in
+// one evaluation each: the walk ID (uint64_t, source * walks_per_vertex + i),
+// the step of the first vertex and the number of vertices (uint32_t), and the
+// vertices (VertexID). The segments of a walk cover its steps once, in an
+// arbitrary order in the file.
 class RandomWalkAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using GraphID = common::GraphID;
+  using BlockID = common::BlockID;
   using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+  struct Walker {
+    uint64_t walk_id;
+    VertexID current;
+    uint32_t step;
+  };
 
  public:
   RandomWalkAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
@@ -22,67 +54,217 @@ class RandomWalkAppOp : public apis::PlanarAppBaseOp<uint32_t> {
       scheduler::MessageHub* hub, scheduler::GraphState* state) override {
     apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
                                              state);
-    walk_length_ = core::common::Configurations::Get()->walk;
-    num_vertices_ = meta->num_vertices;
-    uint64_t size = (uint64_t)(num_vertices_) * (uint64_t)(walk_length_);
-    matrix_ = new uint32_t[size];
-    LOGF_INFO("matrix size : {}", size);
+    if (mode_ != common::Normal) {
+      LOG_FATAL("random walk only runs in normal mode");
+    }
+    auto config = common::Configurations::Get();
+    walk_length_ = config->walk;
+    walks_per_vertex_ = config->walks_per_vertex;
+    seed_ = config->walk_seed;
+    skip_sub_blocks_ = !config->in_memory;
+    if (!config->walk_output.empty()) {
+      output_.open(config->walk_output, std::ios::binary);
+      if (!output_) LOGF_FATAL("Can not open {}", config->walk_output);
+    }
+    buckets_.resize(meta->num_blocks);
+    for (GraphID i = 0; i < meta->num_blocks; i++) {
+      auto& block_meta = meta->blocks.at(i);
+      auto& bucket = buckets_.at(i);
+      bucket.reserve((size_t)block_meta.num_vertices * walks_per_vertex_);
+      for (VertexID id = block_meta.begin_id; id < block_meta.end_id; id++) {
+        for (uint32_t k = 0; k < walks_per_vertex_; k++) {
+          bucket.push_back({(uint64_t)id * walks_per_vertex_ + k, id, 0});
+        }
+      }
+    }
+    num_alive_ = (size_t)meta->num_vertices * walks_per_vertex_;
+    LOGF_INFO("random walk: {} walks of {} steps", num_alive_, walk_length_);
   }
 
-  ~RandomWalkAppOp() override { delete[] matrix_; };
+  ~RandomWalkAppOp() override = default;
 
   void PEval() final {
-    auto sample = [this](VertexID id) { Init(id); };
-    ParallelVertexDoWithEdges(sample);
-    SetActive();
+    LOG_INFO("PEval begins!");
+    Advance();
   }
 
   void IncEval() final {
-    auto walk = [this](VertexID id) { this->Walk(id); };
-    ParallelVertexDo(walk);
-    LOG_INFO("Walk finished");
-    UnsetActive();
+    LOG_INFO("IncEval begins!");
+    Advance();
   }
 
   void Assemble() final {}
 
  private:
-  void Init(VertexID id) {}
-
-  void Sample(VertexID id) {
-    auto degree = GetOutDegree(id);
-    auto edges = GetOutEdges(id);
-    for (uint32_t i = 0; i < walk_length_; i++) {
-      if (degree == 0) {
-        GetRoad(id)[i] = id;
-      } else {
-        GetRoad(id)[i] = edges[GetRandom(degree)];
+  // Advance the walkers of the current subgraph until they leave it.
+  void Advance() {
+    std::vector<Walker> walkers;
+    std::swap(walkers, buckets_.at(current_gid_));
+    if (!walkers.empty()) {
+      LoadEdges(walkers);
+      AdvanceLoaded(walkers);
+      for (BlockID i = 0; i < skipped_.size(); i++) {
+        buffer_->SetSubBlockToRead(current_gid_, i, true);
       }
     }
+    if (num_alive_ != 0) {
+      SetActive();
+    } else if (!finished_) {
+      finished_ = true;
+      if (output_.is_open()) output_.close();
+      LOGF_INFO("random walk finished, steps: {}, stopped early: {}",
+                num_steps_, num_stopped_);
+    }
+  }
+
+  // Read the sub-blocks with walkers, building their alias tables if the
+  // subgraph is weighted.
+  void LoadEdges(const std::vector<Walker>& walkers) {
+    auto& graph = graphs_->at(current_gid_);
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    skipped_.assign(block_meta.num_sub_blocks, skip_sub_blocks_);
+    for (auto& walker : walkers) {
+      skipped_[graph.GetSubBlockID(walker.current)] = 0;
+    }
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, !skipped_.at(i));
+    }
+    weighted_ = graph.IsWeighted();
+    if (weighted_) {
+      alias_prob_.resize(block_meta.num_edges);
+      alias_index_.resize(block_meta.num_edges);
+    }
+    auto build = [this, &graph](BlockID, const util::TaskRange& range,
+                                size_t) {
+      if (!weighted_) return;
+      thread_local util::AliasTableBuilder builder;
+      for (VertexID id = range.begin; id < range.end; id++) {
+        auto offset = graph.GetOutOffset(id);
+        builder.Build(graph.GetOutWeights(id), graph.GetOutDegree(id),
+                      alias_prob_.data() + offset,
+                      alias_index_.data() + offset);
+      }
+    };
+    RunEdgeTasks(graph.IsEdgesLoaded(), GetSubBlockIDsToRead(), build, true);
   }
 
-  void Walk(VertexID id) {
-    auto tmp = id;
-    for (uint32_t i = 0; i < walk_length_; i++) {
-      tmp = GetRoad(tmp)[i];
+  void AdvanceLoaded(const std::vector<Walker>& walkers) {
+    auto task_size = std::max(walkers.size() / (parallelism_ * 4), (size_t)1);
+    size_t num_tasks = (walkers.size() + task_size - 1) / task_size;
+    // Walkers leaving the subgraph, per task and destination subgraph.
+    std::vector<std::vector<std::vector<Walker>>> moved(num_tasks);
+    common::TaskPackage tasks;
+    for (size_t t = 0; t < num_tasks; t++) {
+      auto begin = walkers.begin() + t * task_size;
+      auto end = walkers.begin() + std::min((t + 1) * task_size,
+                                            walkers.size());
+      tasks.push_back([this, t, begin, end, &moved]() {
+        auto& out = moved[t];
+        out.resize(meta_->num_blocks);
+        std::vector<char> segments;
+        for (auto iter = begin; iter != end; iter++) {
+          auto walker = *iter;
+          WalkInBlock(&walker, &segments);
+          if (walker.step == walk_length_) continue;
+          if (walker.current == MAX_VERTEX_ID) continue;
+          out.at(GetBlockOf(walker.current)).push_back(walker);
+        }
+        Flush(segments);
+      });
+    }
+    runner_->SubmitSync(tasks);
+    for (auto& out : moved) {
+      for (GraphID i = 0; i < out.size(); i++) {
+        auto& bucket = buckets_.at(i);
+        bucket.insert(bucket.end(), out[i].begin(), out[i].end());
+      }
     }
   }
 
-  uint32_t GetRandom(uint32_t max) {
-    uint32_t res = rand() % max;
-    return res;
+  // Walk `walker` while its vertex has edges read, appending the segment to
+  // `segments`. Its current vertex is MAX_VERTEX_ID if it stopped early.
+  void WalkInBlock(Walker* walker, std::vector<char>* segments) {
+    auto& graph = graphs_->at(current_gid_);
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    thread_local std::vector<VertexID> path;
+    path.clear();
+    auto first_step = walker->step;
+    uint32_t begin_step = first_step == 0 ? 0 : first_step + 1;
+    if (walker->step == 0) path.push_back(walker->current);
+    while (walker->step < walk_length_) {
+      auto id = walker->current;
+      if (id < block_meta.begin_id || id >= block_meta.end_id ||
+          skipped_.at(graph.GetSubBlockID(id))) {
+        break;
+      }
+      auto degree = graph.GetOutDegree(id);
+      if (degree == 0) {
+        walker->current = MAX_VERTEX_ID;
+        util::atomic::WriteAdd(&num_stopped_, (size_t)1);
+        break;
+      }
+      // Seeded per step, so that a walk does not depend on where the sub-blocks
+      // read split it into segments.
+      util::Xoshiro256 rng(seed_, walker->walk_id, walker->step);
+      uint32_t i;
+      if (weighted_) {
+        auto offset = graph.GetOutOffset(id);
+        i = util::SampleAlias(alias_prob_.data() + offset,
+                              alias_index_.data() + offset, degree, &rng);
+      } else {
+        i = rng.Uniform(degree);
+      }
+      walker->current = graph.GetOutEdges(id)[i];
+      walker->step++;
+      path.push_back(walker->current);
+    }
+    util::atomic::WriteAdd(&num_steps_, (size_t)(walker->step - first_step));
+    if (walker->step == walk_length_ || walker->current == MAX_VERTEX_ID) {
+      util::atomic::WriteSub(&num_alive_, (size_t)1);
+    }
+    if (!output_.is_open() || path.empty()) return;
+    auto append = [segments](const void* data, size_t size) {
+      segments->insert(segments->end(), (const char*)data,
+                       (const char*)data + size);
+    };
+    uint32_t length = path.size();
+    append(&walker->walk_id, sizeof(uint64_t));
+    append(&begin_step, sizeof(uint32_t));
+    append(&length, sizeof(uint32_t));
+    append(path.data(), length * sizeof(VertexID));
   }
 
-  uint32_t* GetRoad(VertexID id) {
-    uint64_t index = (uint64_t)(id) * (uint64_t)(walk_length_);
-    return matrix_ + index;
+  void Flush(const std::vector<char>& segments) {
+    if (segments.empty()) return;
+    std::lock_guard<std::mutex> lock(output_mtx_);
+    output_.write(segments.data(), segments.size());
   }
 
  private:
   // configs
   uint32_t walk_length_ = 5;
-  uint32_t* matrix_ = nullptr;
-  uint32_t num_vertices_ = 0;
+  uint32_t walks_per_vertex_ = 1;
+  uint64_t seed_ = 1;
+  bool skip_sub_blocks_ = false;
+
+  // walkers by the subgraph of their current vertex.
+  std::vector<std::vector<Walker>> buckets_;
+  size_t num_alive_ = 0;
+  size_t num_steps_ = 0;
+  size_t num_stopped_ = 0;
+  bool finished_ = false;
+
+  // alias tables of the out edges of the current subgraph, at their offsets,
+  // if it is weighted.
+  bool weighted_ = false;
+  std::vector<float> alias_prob_;
+  std::vector<uint32_t> alias_index_;
+
+  // sub-blocks of the current subgraph that are not read.
+  std::vector<uint8_t> skipped_;
+
+  std::ofstream output_;
+  std::mutex output_mtx_;
 };
 
 }  // namespace sics::graph::core::apps
@@ -0,0 +1,187 @@
+#include "apps/randomwalk_app_op.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "common/multithreading/thread_pool.h"
+
+namespace sics::graph::core::apps {
+
+using common::EdgeIndex;
+using common::VertexDegree;
+using common::VertexID;
+using data_structures::TwoDMetadata;
+using data_structures::graph::MutableBlockCSRGraph;
+
+class RandomWalkAppOpTest : public ::testing::Test {
+ protected:
+  using Walks = std::map<uint64_t, std::vector<VertexID>>;
+
+  RandomWalkAppOpTest() : thread_pool_(4) {}
+
+  void SetUp() override {
+    std::filesystem::create_directories(root_);
+    auto config = common::Configurations::GetMutable();
+    config->application = common::RandomWalk;
+    config->mode = common::Normal;
+    config->parallelism = 4;
+    config->walk = 30;
+    config->walks_per_vertex = 1;
+    config->walk_seed = 7;
+  }
+
+  void TearDown() override { std::filesystem::remove_all(root_); }
+
+  // Blocks of 16 vertices, in sub-blocks of 2, whose edges mostly stay in
+  // the block. Some vertices have no out edges.
+  void WriteGraph() {
+    std::mt19937 rng(3);
+    VertexID num_vertices = 64;
+    meta_.num_vertices = num_vertices;
+    meta_.num_blocks = 4;
+    meta_.num_edges = 0;
+    edges_.resize(num_vertices);
+    for (VertexID id = 0; id < num_vertices; id++) {
+      auto degree = rng() % 7 == 0 ? 0 : rng() % 4 + 1;
+      VertexID block_begin = id / 16 * 16;
+      for (VertexID i = 0; i < degree; i++) {
+        edges_[id].push_back(rng() % 5 == 0 ? rng() % num_vertices
+                                            : block_begin + rng() % 16);
+      }
+    }
+    for (common::GraphID gid = 0; gid < meta_.num_blocks; gid++) {
+      data_structures::Block block;
+      block.id = gid;
+      block.num_sub_blocks = 8;
+      block.num_vertices = 16;
+      block.offset_ratio = 1;
+      block.begin_id = gid * 16;
+      block.end_id = block.begin_id + 16;
+      block.vertex_offset = 2;
+      std::vector<EdgeIndex> offsets;
+      std::vector<VertexDegree> degrees;
+      EdgeIndex offset = 0;
+      for (common::BlockID bid = 0; bid < block.num_sub_blocks; bid++) {
+        data_structures::SubBlock sub_block;
+        sub_block.id = bid;
+        sub_block.begin_id = block.begin_id + bid * 2;
+        sub_block.end_id = sub_block.begin_id + 2;
+        sub_block.num_vertices = 2;
+        sub_block.begin_offset = offset;
+        for (auto id = sub_block.begin_id; id < sub_block.end_id; id++) {
+          offsets.push_back(offset);
+          degrees.push_back(edges_[id].size());
+          offset += edges_[id].size();
+        }
+        sub_block.num_edges = offset - sub_block.begin_offset;
+        block.sub_blocks.push_back(sub_block);
+      }
+      block.num_edges = offset;
+      meta_.num_edges += offset;
+      meta_.blocks.push_back(block);
+
+      auto dir = root_ + "graphs/" + std::to_string(gid) + "_blocks/";
+      std::filesystem::create_directories(dir);
+      std::ofstream file(dir + "index.bin", std::ios::binary);
+      file.write((char*)offsets.data(), offsets.size() * sizeof(EdgeIndex));
+      file.write((char*)degrees.data(), degrees.size() * sizeof(VertexDegree));
+    }
+  }
+
+  // Run the walks to the end, with all the sub-blocks in memory or only
+  // those with walkers read, and gather them from the output, along with the
+  // number of segments written.
+  Walks Walk(bool in_memory, size_t* num_segments) {
+    auto config = common::Configurations::GetMutable();
+    config->in_memory = in_memory;
+    config->walk_output = root_ + "walks.bin";
+    {
+      std::vector<MutableBlockCSRGraph> graphs(meta_.num_blocks);
+      for (common::GraphID gid = 0; gid < meta_.num_blocks; gid++) {
+        auto& block = meta_.blocks.at(gid);
+        auto& graph = graphs.at(gid);
+        graph.Init(root_, &block);
+        for (auto& sub_block : block.sub_blocks) {
+          auto base = graph.ApplySubBlockBuffer(sub_block.id);
+          for (auto id = sub_block.begin_id; id < sub_block.end_id; id++) {
+            base = std::copy(edges_[id].begin(), edges_[id].end(), base);
+          }
+        }
+        graph.SetEdgeLoaded(true);
+      }
+      scheduler::EdgeBuffer2 buffer(&meta_, &graphs);
+      scheduler::MessageHub hub;
+      scheduler::GraphState state(meta_.num_blocks);
+      RandomWalkAppOp app;
+      app.AppInit(&thread_pool_, &meta_, &buffer, &graphs, &hub, &state);
+      // Run as the scheduler does, through the PIE interface.
+      apis::PIE* pie = &app;
+      for (int round = 0; round < 1000; round++) {
+        pie->SetInActive();
+        for (common::GraphID gid = 0; gid < meta_.num_blocks; gid++) {
+          pie->SetCurrentGid(gid);
+          round == 0 ? pie->PEval() : pie->IncEval();
+        }
+        if (!pie->IsActive()) break;
+      }
+      EXPECT_FALSE(pie->IsActive());
+    }
+
+    Walks walks;
+    *num_segments = 0;
+    std::ifstream file(config->walk_output, std::ios::binary);
+    uint64_t walk_id;
+    while (file.read((char*)&walk_id, sizeof(walk_id))) {
+      uint32_t begin_step, length;
+      file.read((char*)&begin_step, sizeof(begin_step));
+      file.read((char*)&length, sizeof(length));
+      auto& walk = walks[walk_id];
+      if (walk.size() < begin_step + length) {
+        walk.resize(begin_step + length, MAX_VERTEX_ID - 1);
+      }
+      file.read((char*)(walk.data() + begin_step), length * sizeof(VertexID));
+      (*num_segments)++;
+    }
+    return walks;
+  }
+
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/randomwalk_app_op_test_" + std::to_string(getpid()) +
+                      "/";
+  TwoDMetadata meta_;
+  std::vector<std::vector<VertexID>> edges_;
+  common::ThreadPool thread_pool_;
+};
+
+TEST_F(RandomWalkAppOpTest, OutOfCoreWalksMatchInMemoryWalks) {
+  WriteGraph();
+  size_t in_memory_segments, out_of_core_segments;
+  auto in_memory = Walk(true, &in_memory_segments);
+  auto out_of_core = Walk(false, &out_of_core_segments);
+  // Out of core, walkers also stop at the sub-blocks not read, so the walks
+  // are split into more segments.
+  EXPECT_GT(out_of_core_segments, in_memory_segments);
+  EXPECT_EQ(in_memory.size(), meta_.num_vertices);
+  EXPECT_EQ(out_of_core, in_memory);
+
+  // The walks follow the edges, and only stop early at vertices without any.
+  for (auto& [walk_id, walk] : in_memory) {
+    EXPECT_EQ(walk.front(), walk_id);
+    for (size_t i = 0; i + 1 < walk.size(); i++) {
+      auto& out = edges_[walk[i]];
+      EXPECT_NE(std::find(out.begin(), out.end(), walk[i + 1]), out.end());
+    }
+    if (walk.size() <= common::Configurations::Get()->walk) {
+      EXPECT_TRUE(edges_[walk.back()].empty());
+    }
+  }
+}
+
+}  // namespace sics::graph::core::apps
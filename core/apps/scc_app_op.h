@@ -0,0 +1,300 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_SCC_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_SCC_APP_OP_H
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/bitmap.h"
+#include "common/types.h"
+#include "util/atomic.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: strongly connected components by trimming and coloring, with
+// the smallest vertex ID of its SCC as the data of every vertex. Needs the in
+// edges of every block, e.g. as written by graph_gen -in_edges.
+//
+// Every iteration works on the vertices left, in three phases:
+//  - trim: a vertex without a left in or out neighbor is an SCC alone. One
+//    round over all subgraphs.
+//  - forward: every vertex takes the smallest ID of the vertices reaching it
+//    as its color, pushed along the out edges.
+//  - backward: the vertices of color c reaching c along the in edges, within
+//    color c, are the SCC of c, for every c at once.
+// The propagations run to a fixpoint in a subgraph, in steps over its active
+// bitmap, and across subgraphs over the rounds of the scheduler. A phase ends
+// with the first round that starts with no active vertex in any subgraph.
+//
+// The in edges of a vertex are read with its out edges, from the same
+// sub-block file. Out of core, only the sub-blocks with active vertices are
+// read in the propagations.
+class SccAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using BlockID = common::BlockID;
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+  static constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+
+  enum Phase { kTrim, kForward, kBackward };
+
+ public:
+  SccAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    if (mode_ != common::Normal) LOG_FATAL("scc only runs in normal mode");
+    for (auto& block_meta : meta->blocks) {
+      if (!block_meta.in_edges) {
+        LOGF_FATAL("block {} has no in edges, scc needs them", block_meta.id);
+      }
+    }
+    skip_sub_blocks_ = !common::Configurations::Get()->in_memory;
+    colors_.resize(meta->num_vertices, kUnassigned);
+    reached_.Init(meta->num_vertices);
+    num_left_ = meta->num_vertices;
+  }
+
+  ~SccAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Write(id, kUnassigned); };
+
+    ParallelVertexInitDo(init);
+    Run();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    Run();
+  }
+
+  void Assemble() final {}
+
+ private:
+  void Run() {
+    BeginRound();
+    if (finished_) return;
+    if (phase_ == kTrim) {
+      auto trim = [this](VertexID id) { Trim(id); };
+      ParallelVertexDoWithEdges(trim);
+    } else if (phase_ == kForward) {
+      Propagate([this](VertexID id) { Forward(id); });
+    } else {
+      Propagate([this](VertexID id) { Backward(id); });
+    }
+    SetActive();
+  }
+
+  // Move to the next phase in the first evaluation of a round, if the
+  // current one is done.
+  void BeginRound() {
+    if (round_ == phase_round_) return;
+    bool first = phase_round_ < 0;
+    phase_round_ = round_;
+    if (first) return;
+    if (phase_ == kTrim) {
+      num_left_ -= num_assigned_;
+      LOGF_INFO("trimmed: {}, vertices left: {}", num_assigned_, num_left_);
+      num_assigned_ = 0;
+      if (num_left_ == 0) return Finish();
+      StartForward();
+    } else if (!HasPending()) {
+      if (phase_ == kForward) return StartBackward();
+      AssignReached();
+      if (num_left_ == 0) return Finish();
+      phase_ = kTrim;
+    }
+  }
+
+  void StartForward() {
+    auto init = [this](VertexID id) {
+      if (Read(id) != kUnassigned) return;
+      colors_[id] = id;
+      SetVertexActive(id);
+    };
+    ParallelAllVertexDo(init);
+    phase_ = kForward;
+  }
+
+  // The roots of the backward phase are the vertices of their own color.
+  void StartBackward() {
+    size_t num_roots = 0;
+    auto init = [this, &num_roots](VertexID id) {
+      if (Read(id) != kUnassigned || colors_[id] != id) return;
+      reached_.SetBit(id);
+      SetVertexActive(id);
+      util::atomic::WriteAdd(&num_roots, (size_t)1);
+    };
+    ParallelAllVertexDo(init);
+    LOGF_INFO("colored {} vertices with {} colors", num_left_, num_roots);
+    phase_ = kBackward;
+  }
+
+  void AssignReached() {
+    auto assign = [this](VertexID id) {
+      if (Read(id) != kUnassigned || !reached_.GetBit(id)) return;
+      Write(id, colors_[id]);
+      util::atomic::WriteAdd(&num_assigned_, (size_t)1);
+    };
+    ParallelAllVertexDo(assign);
+    reached_.Clear();
+    num_left_ -= num_assigned_;
+    LOGF_INFO("assigned: {}, vertices left: {}", num_assigned_, num_left_);
+    num_assigned_ = 0;
+  }
+
+  void Finish() {
+    finished_ = true;
+    LOG_INFO("scc finished");
+  }
+
+  // If a subgraph has active vertices for its next evaluation.
+  bool HasPending() const {
+    for (auto& bitmap : next_actives_) {
+      if (!bitmap.IsEmpty()) return true;
+    }
+    return false;
+  }
+
+  // Run `step` over the active vertices of the current subgraph until none
+  // is left.
+  void Propagate(const std::function<void(VertexID)>& step) {
+    SyncSubGraphActive();
+    auto size = GetActiveNum();
+    if (size == 0) return;
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    MarkSubBlocksToRead();
+    carried_.Init(block_meta.num_vertices);
+    size_t num_steps = 0;
+    while (size != 0) {
+      ParallelVertexDoWithEdges(step);
+      SyncSubGraphActive();
+      num_steps++;
+      size = GetActiveNum();
+    }
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, true);
+    }
+    // Activated in sub-blocks that are not read, so left to the next round.
+    for (VertexID i = 0; i < block_meta.num_vertices; i++) {
+      if (carried_.GetBit(i)) SetVertexActive(block_meta.begin_id + i);
+    }
+    LOGF_INFO("phase {} of subgraph {}: {} steps", (int)phase_, current_gid_,
+              num_steps);
+  }
+
+  // Mark the sub-blocks without active vertices as not to read.
+  void MarkSubBlocksToRead() {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    skipped_.assign(block_meta.num_sub_blocks, 0);
+    if (!skip_sub_blocks_) return;
+    common::TaskPackage tasks;
+    for (BlockID i = 0; i < block_meta.num_sub_blocks; i++) {
+      auto& sub_block_meta = block_meta.sub_blocks.at(i);
+      tasks.push_back([this, i, &sub_block_meta]() {
+        bool empty = true;
+        for (VertexID id = sub_block_meta.begin_id;
+             id < sub_block_meta.end_id && empty; id++) {
+          empty = !IsVertexActive(id);
+        }
+        skipped_.at(i) = empty;
+      });
+    }
+    runner_->SubmitSync(tasks);
+    for (BlockID i = 0; i < skipped_.size(); i++) {
+      buffer_->SetSubBlockToRead(current_gid_, i, !skipped_.at(i));
+    }
+  }
+
+  // Activate `id` for the next step, or the next evaluation of its subgraph.
+  void Activate(VertexID id) {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    if (id >= block_meta.begin_id && id < block_meta.end_id &&
+        skipped_.at(graphs_->at(current_gid_).GetSubBlockID(id))) {
+      carried_.SetBit(id - block_meta.begin_id);
+    } else {
+      SetVertexActive(id);
+    }
+  }
+
+  // Neighbors assigned in this round still count as left, which only trims
+  // less.
+  void Trim(VertexID id) {
+    if (Read(id) != kUnassigned) return;
+    auto& graph = graphs_->at(current_gid_);
+    auto has_left = [this, id](const VertexID* edges, VertexDegree degree) {
+      for (VertexDegree i = 0; i < degree; i++) {
+        if (edges[i] != id && Read(edges[i]) == kUnassigned) return true;
+      }
+      return false;
+    };
+    if (has_left(graph.GetOutEdges(id), graph.GetOutDegree(id)) &&
+        has_left(graph.GetInEdges(id), graph.GetInDegree(id))) {
+      return;
+    }
+    Write(id, id);
+    util::atomic::WriteAdd(&num_assigned_, (size_t)1);
+  }
+
+  void Forward(VertexID id) {
+    if (!IsVertexActive(id)) return;
+    auto color = colors_[id];
+    auto degree = GetOutDegree(id);
+    auto edges = GetOutEdges(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      auto dst_id = edges[i];
+      if (color >= colors_[dst_id] || Read(dst_id) != kUnassigned) continue;
+      if (util::atomic::WriteMin(&colors_[dst_id], color)) Activate(dst_id);
+    }
+  }
+
+  void Backward(VertexID id) {
+    if (!IsVertexActive(id)) return;
+    auto color = colors_[id];
+    auto& graph = graphs_->at(current_gid_);
+    auto degree = graph.GetInDegree(id);
+    auto edges = graph.GetInEdges(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      auto src_id = edges[i];
+      if (colors_[src_id] != color || reached_.GetBit(src_id) ||
+          Read(src_id) != kUnassigned) {
+        continue;
+      }
+      reached_.SetBit(src_id);
+      Activate(src_id);
+    }
+  }
+
+ private:
+  bool skip_sub_blocks_ = false;
+
+  // color of every vertex left in the forward and backward phases, and the
+  // vertices reached backward from the root of their color.
+  std::vector<VertexID> colors_;
+  common::Bitmap reached_;
+
+  Phase phase_ = kTrim;
+  int phase_round_ = -1;
+  size_t num_left_ = 0;
+  size_t num_assigned_ = 0;
+  bool finished_ = false;
+
+  // sub-blocks of the current subgraph that are not read, and the vertices
+  // in them activated by a step. Not a vector<bool>, as they are set in
+  // parallel.
+  std::vector<uint8_t> skipped_;
+  common::Bitmap carried_;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_SCC_APP_OP_H
@@ -25,7 +25,7 @@ class SsspAppOp : public apis::PlanarAppBaseOp<uint32_t> {
       scheduler::MessageHub* hub, scheduler::GraphState* state) override {
     apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
                                              state);
-    source_ = common::Configurations::Get()->source;
+    source_ = GetRelabeledID(common::Configurations::Get()->source);
     active_.Init(meta->num_vertices);
     active_next_.Init(meta->num_vertices);
   }
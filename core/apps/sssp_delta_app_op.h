@@ -0,0 +1,199 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_SSSP_DELTA_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_SSSP_DELTA_APP_OP_H
+
+#include <algorithm>
+#include <limits>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/bitmap.h"
+#include "common/types.h"
+#include "util/atomic.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: delta-stepping SSSP over weighted edges, see
+// `Block::weighted`. Unweighted graphs get a weight of 1 on every edge.
+//
+// Active vertices are grouped into buckets of width `delta` by distance, and
+// buckets are settled in increasing order. Light edges (weight <= delta) may
+// put a vertex back into the current bucket, so they are relaxed step by step
+// until the bucket is empty. Heavy edges can only reach later buckets, so they
+// are relaxed once per bucket, from the vertices settled in it. Vertices of
+// later buckets stay active and wait for their turn, instead of being relaxed
+// in every step as SsspAppOp does. The light steps and the heavy pass run on
+// bitmaps of the vertices of the current bucket, so those of other buckets are
+// not even visited.
+//
+// Buckets are ordered within one subgraph. A distance pushed to another
+// subgraph activates the vertex there, and it is settled when that subgraph
+// runs IncEval.
+class SsspDeltaAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+  using EdgeWeight = common::EdgeWeight;
+
+  static constexpr uint32_t kNoBucket = std::numeric_limits<uint32_t>::max();
+
+ public:
+  SsspDeltaAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    source_ = GetRelabeledID(common::Configurations::Get()->source);
+    delta_ = common::Configurations::Get()->delta;
+    if (delta_ == 0) LOG_FATAL("delta of delta stepping must be positive");
+    LOGF_INFO("delta stepping with delta: {}, weighted: {}", delta_,
+              graphs->at(0).IsWeighted());
+  }
+
+  ~SsspDeltaAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Init(id); };
+
+    SyncSubGraphActive();
+    ParallelVertexInitDo(init);
+    RunBuckets();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    SyncSubGraphActive();
+    RunBuckets();
+  }
+
+  void Assemble() final {}
+
+ private:
+  void Init(VertexID id) {
+    if (id == source_) {
+      Write(id, 0);
+      InitVertexActive(id);
+      LOGF_INFO("source of SSSP: {}", id);
+    } else {
+      Write(id, SSSP_INFINITY);
+    }
+  }
+
+  // Settle the buckets of the active vertices of the current subgraph, in
+  // increasing order, until none is active.
+  void RunBuckets() {
+    auto light = [this](VertexID id) { RelaxLight(id); };
+    auto heavy = [this](VertexID id) { RelaxHeavy(id); };
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    frontier_.Init(block_meta.num_vertices);
+    next_frontier_.Init(block_meta.num_vertices);
+    settled_.Init(block_meta.num_vertices);
+    size_t num_buckets = 0, num_steps = 0;
+
+    TakeMinActiveBucket();
+    while (current_bucket_ != kNoBucket) {
+      settled_.Clear();
+      while (!frontier_.IsEmpty()) {
+        ParallelVertexDoWithEdges(frontier_, light);
+        std::swap(frontier_, next_frontier_);
+        next_frontier_.Clear();
+        num_steps++;
+      }
+      ParallelVertexDoWithEdges(settled_, heavy);
+      TakeMinActiveBucket();
+      num_buckets++;
+    }
+    LOGF_INFO("delta stepping finished, buckets: {}, light steps: {}",
+              num_buckets, num_steps);
+  }
+
+  // Move the active vertices of the current subgraph in the smallest bucket
+  // to `frontier_`, and make it the current bucket, or kNoBucket if none is
+  // active.
+  void TakeMinActiveBucket() {
+    auto& bitmap = actives_.at(current_gid_);
+    auto begin_id = meta_->blocks.at(current_gid_).begin_id;
+    current_bucket_ = kNoBucket;
+    for (int pass = 0; pass < 2; pass++) {
+      for (size_t idx = 0; idx < bitmap.size(); idx++) {
+        if (idx % 64 == 0 && !bitmap.GetBit64(idx)) {
+          idx += 63;
+          continue;
+        }
+        if (!bitmap.GetBit(idx)) continue;
+        auto bucket = Read(begin_id + idx) / delta_;
+        if (pass == 0) {
+          current_bucket_ = std::min(current_bucket_, bucket);
+        } else if (bucket == current_bucket_) {
+          bitmap.ClearBit(idx);
+          frontier_.SetBit(idx);
+        }
+      }
+      if (current_bucket_ == kNoBucket) return;
+    }
+  }
+
+  // A vertex of the current subgraph joins the next light step if it is in
+  // the current bucket, and waits in `actives_` otherwise. A vertex of
+  // another subgraph is settled when that subgraph runs IncEval.
+  void Activate(VertexID id, uint32_t dis) {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    if (id < block_meta.begin_id || id >= block_meta.end_id) {
+      SetVertexActive(id);
+    } else if (dis / delta_ == current_bucket_) {
+      next_frontier_.SetBit(id - block_meta.begin_id);
+    } else {
+      actives_.at(current_gid_).SetBit(id - block_meta.begin_id);
+    }
+  }
+
+  void RelaxLight(VertexID id) {
+    auto idx = id - meta_->blocks.at(current_gid_).begin_id;
+    // A vertex relaxed into a later bucket before the current one of this
+    // step may still wait in `actives_`.
+    actives_.at(current_gid_).ClearBit(idx);
+    settled_.SetBit(idx);
+    Relax(id, Read(id), [this](EdgeWeight weight) { return weight <= delta_; });
+  }
+
+  void RelaxHeavy(VertexID id) {
+    Relax(id, Read(id), [this](EdgeWeight weight) { return weight > delta_; });
+  }
+
+  template <typename EdgeFilter>
+  void Relax(VertexID id, uint32_t dis, EdgeFilter&& filter) {
+    auto degree = GetOutDegree(id);
+    if (degree == 0) return;
+    auto edges = GetOutEdges(id);
+    auto weights = GetOutWeights(id);
+    for (VertexDegree i = 0; i < degree; i++) {
+      EdgeWeight weight = weights == nullptr ? 1 : weights[i];
+      if (!filter(weight)) continue;
+      auto dst_id = edges[i];
+      auto new_dis = dis + weight;
+      if (new_dis < Read(dst_id)) {
+        WriteMin(dst_id, new_dis);
+        Activate(dst_id, new_dis);
+      }
+    }
+  }
+
+ private:
+  VertexID source_ = 0;
+  uint32_t delta_ = 1;
+  uint32_t current_bucket_ = kNoBucket;
+  // vertices of the current bucket relaxed in the current and the next light
+  // step, and those settled in it, whose heavy edges are relaxed once the
+  // bucket is empty. All are indexed from the begin_id of the current
+  // subgraph.
+  common::Bitmap frontier_;
+  common::Bitmap next_frontier_;
+  common::Bitmap settled_;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_SSSP_DELTA_APP_OP_H
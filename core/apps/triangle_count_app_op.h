@@ -0,0 +1,278 @@
+#ifndef GRAPH_SYSTEMS_CORE_APPS_TRIANGLE_COUNT_APP_OP_H
+#define GRAPH_SYSTEMS_CORE_APPS_TRIANGLE_COUNT_APP_OP_H
+
+#include <algorithm>
+#include <vector>
+
+#include "apis/planar_app_base.h"
+#include "apis/planar_app_base_op.h"
+#include "common/types.h"
+#include "util/atomic.h"
+#include "util/intersection.h"
+
+namespace sics::graph::core::apps {
+
+// @DESCRIPTION: triangle counting, with the number of triangles of every
+// vertex as its data, and the local clustering coefficients
+// 2 * t(v) / (d(v) * (d(v) - 1)). Needs a symmetric graph with sorted
+// adjacency, e.g. as written by graph_convertor.
+//
+// Edges are oriented from lower to higher rank, by (degree, ID), and each
+// triangle u < v < w is found once, as w in N+(u) ∩ N+(v), for the edge (u,
+// v). The adjacency of every vertex is reordered in place when its edges are
+// loaded, with N+ first, so the intersections only read the short oriented
+// lists and no copy of the graph is made.
+//
+// PEval of block i counts the triangles whose lowest vertex u is in block i.
+// The edges (u, v) with v in block i are joined in block i. For the others, the
+// sub-blocks of v are read from their block j while block i stays loaded, one
+// sub-block of j at a time, and joined as they arrive, so a pair of sub-blocks
+// is resident in EdgeBuffer2 at once. Round 1 computes the coefficients from
+// the final counts, with no edges.
+class TriangleCountAppOp : public apis::PlanarAppBaseOp<uint32_t> {
+  using GraphID = common::GraphID;
+  using BlockID = common::BlockID;
+  using VertexID = common::VertexID;
+  using VertexDegree = common::VertexDegree;
+
+ public:
+  TriangleCountAppOp() : apis::PlanarAppBaseOp<uint32_t>() {}
+
+  void AppInit(
+      common::TaskRunner* runner, data_structures::TwoDMetadata* meta,
+      scheduler::EdgeBuffer2* buffer,
+      std::vector<data_structures::graph::MutableBlockCSRGraph>* graphs,
+      scheduler::MessageHub* hub, scheduler::GraphState* state) override {
+    apis::PlanarAppBaseOp<uint32_t>::AppInit(runner, meta, buffer, graphs, hub,
+                                             state);
+    if (mode_ != common::Normal) {
+      LOG_FATAL("triangle counting only runs in normal mode");
+    }
+    // Degrees are read from the offset index, which is resident.
+    degrees_.resize(meta->num_vertices);
+    plus_degrees_.resize(meta->num_vertices, 0);
+    clustering_.resize(meta->num_vertices, 0);
+    needed_.resize(meta->num_blocks);
+    for (GraphID i = 0; i < meta->num_blocks; i++) {
+      auto& block_meta = meta->blocks.at(i);
+      for (VertexID id = block_meta.begin_id; id < block_meta.end_id; id++) {
+        degrees_.at(id) = graphs->at(i).GetOutDegree(id);
+      }
+      needed_.at(i).resize(block_meta.num_sub_blocks, 0);
+    }
+  }
+
+  ~TriangleCountAppOp() override = default;
+
+  void PEval() final {
+    LOG_INFO("PEval begins!");
+    auto init = [this](VertexID id) { Write(id, 0); };
+    auto orient = [this](VertexID id) {
+      Orient(id);
+      MarkNeeded(id);
+    };
+    auto count = [this](VertexID id) { CountInBlock(id); };
+
+    ParallelVertexInitDo(init);
+    ParallelVertexDoWithEdges(orient);
+    ParallelVertexDoWithEdges(count);
+    for (GraphID j = 0; j < meta_->num_blocks; j++) {
+      if (j != current_gid_) JoinBlock(j);
+    }
+    Sync();
+    // The counts are final once every block has run PEval.
+    SetActive();
+  }
+
+  void IncEval() final {
+    LOG_INFO("IncEval begins!");
+    ComputeClustering();
+  }
+
+  void Assemble() final {}
+
+  // Local clustering coefficient of `id`, valid once the app finished.
+  float GetClusteringCoefficient(VertexID id) const {
+    return clustering_.at(id);
+  }
+
+ private:
+  // If `a` comes after `b` in the orientation.
+  bool IsHigher(VertexID a, VertexID b) const {
+    return degrees_[a] > degrees_[b] || (degrees_[a] == degrees_[b] && a > b);
+  }
+
+  // Move N+(id) to the front of the adjacency of `id`, keeping both parts
+  // sorted. Running it again changes nothing.
+  void Orient(VertexID id) {
+    auto degree = GetOutDegree(id);
+    if (degree == 0) return;
+    auto edges = GetOutEdges(id);
+    thread_local std::vector<VertexID> lower;
+    lower.clear();
+    VertexDegree plus_degree = 0;
+    for (VertexDegree i = 0; i < degree; i++) {
+      if (IsHigher(edges[i], id)) {
+        edges[plus_degree++] = edges[i];
+      } else {
+        lower.push_back(edges[i]);
+      }
+    }
+    std::copy(lower.begin(), lower.end(), edges + plus_degree);
+    plus_degrees_[id] = plus_degree;
+  }
+
+  // Mark the sub-blocks of other blocks holding N+(id).
+  void MarkNeeded(VertexID id) {
+    auto edges = GetOutEdges(id);
+    for (VertexDegree i = 0; i < plus_degrees_[id]; i++) {
+      auto gid = GetBlockOf(edges[i]);
+      if (gid == current_gid_) continue;
+      auto bid = graphs_->at(gid).GetSubBlockID(edges[i]);
+      if (needed_[gid][bid] == 0) {
+        util::atomic::WriteMax(&needed_[gid][bid], (uint8_t)1);
+      }
+    }
+  }
+
+  // Count the triangles of the edge (u, v), given the edges of both.
+  void CountEdge(VertexID u, const VertexID* plus_u, VertexID v,
+                 const VertexID* plus_v) {
+    auto num = util::IntersectSorted(
+        plus_u, plus_degrees_[u], plus_v, plus_degrees_[v],
+        [this](VertexID w) { util::atomic::WriteAdd(write_ + w, 1u); });
+    if (num == 0) return;
+    util::atomic::WriteAdd(write_ + u, (uint32_t)num);
+    util::atomic::WriteAdd(write_ + v, (uint32_t)num);
+  }
+
+  void CountInBlock(VertexID id) {
+    auto edges = GetOutEdges(id);
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    for (VertexDegree i = 0; i < plus_degrees_[id]; i++) {
+      auto dst_id = edges[i];
+      if (dst_id < block_meta.begin_id || dst_id >= block_meta.end_id) {
+        continue;
+      }
+      CountEdge(id, edges, dst_id, GetOutEdges(dst_id));
+    }
+  }
+
+  // Count the triangles of the edges from the current block to sub-block
+  // `bid` of block `gid`, whose edges are loaded.
+  void JoinSubBlock(GraphID gid, BlockID bid) {
+    auto& sub_block_meta = meta_->blocks.at(gid).sub_blocks.at(bid);
+    auto& graph = graphs_->at(gid);
+    common::TaskPackage tasks;
+    auto task_size = GetTaskSize(sub_block_meta.num_vertices);
+    for (VertexID begin_id = sub_block_meta.begin_id;
+         begin_id < sub_block_meta.end_id; begin_id += task_size) {
+      auto end_id = std::min((VertexID)(begin_id + task_size),
+                             sub_block_meta.end_id);
+      tasks.push_back([this, begin_id, end_id]() {
+        for (VertexID id = begin_id; id < end_id; id++) Orient(id);
+      });
+    }
+    runner_->SubmitSync(tasks);
+
+    auto join = [&](GraphID, const util::TaskRange& range, size_t) {
+      for (VertexID id = range.begin; id < range.end; id++) {
+        auto edges = GetOutEdges(id);
+        auto end = edges + plus_degrees_[id];
+        for (auto iter = std::lower_bound(edges, end, sub_block_meta.begin_id);
+             iter != end && *iter < sub_block_meta.end_id; iter++) {
+          CountEdge(id, edges, *iter, graph.GetOutEdges(*iter));
+        }
+      }
+    };
+    RunEdgeTasks(true, GetAllSubBlockIDs(), join, true);
+  }
+
+  // Join the current block with the needed sub-blocks of block `gid`,
+  // reading them if the block is not loaded.
+  void JoinBlock(GraphID gid) {
+    auto& needed = needed_.at(gid);
+    size_t num_needed = std::count(needed.begin(), needed.end(), 1);
+    if (num_needed == 0) return;
+    auto& graph = graphs_->at(gid);
+    if (graph.IsEdgesLoaded()) {
+      for (BlockID i = 0; i < needed.size(); i++) {
+        if (needed.at(i)) JoinSubBlock(gid, i);
+      }
+    } else {
+      for (BlockID i = 0; i < needed.size(); i++) {
+        buffer_->SetSubBlockToRead(gid, i, needed.at(i));
+      }
+      scheduler::ReadMessage read;
+      read.graph_id = gid;
+      hub_->get_reader_queue()->Push(read);
+      auto queue = buffer_->GetQueue();
+      while (true) {
+        auto bid = queue->PopOrWait();
+        if (bid == MAX_VERTEX_ID) break;
+        JoinSubBlock(gid, bid);
+        // Make room for the next sub-block of `gid`.
+        buffer_->FinishOneEdgeBlock(gid, bid);
+      }
+      graph.SetSubBlocksRelease();
+      for (BlockID i = 0; i < needed.size(); i++) {
+        buffer_->SetSubBlockToRead(gid, i, true);
+      }
+    }
+    LOGF_INFO("joined block {} with {} sub-blocks of block {}", current_gid_,
+              num_needed, gid);
+    std::fill(needed.begin(), needed.end(), 0);
+  }
+
+  void ComputeClustering() {
+    auto& block_meta = meta_->blocks.at(current_gid_);
+    auto task_size = GetTaskSize(block_meta.num_vertices);
+    size_t num_tasks = (block_meta.num_vertices + task_size - 1) / task_size;
+    std::vector<uint64_t> triangles(num_tasks, 0);
+    std::vector<double> sums(num_tasks, 0);
+    common::TaskPackage tasks;
+    for (size_t i = 0; i < num_tasks; i++) {
+      VertexID begin_id = block_meta.begin_id + i * task_size;
+      VertexID end_id = std::min((VertexID)(begin_id + task_size),
+                                 block_meta.end_id);
+      tasks.push_back([this, i, begin_id, end_id, &triangles, &sums]() {
+        for (VertexID id = begin_id; id < end_id; id++) {
+          uint64_t degree = degrees_[id];
+          auto num = Read(id);
+          triangles[i] += num;
+          if (degree < 2) continue;
+          clustering_[id] = 2.0 * num / (degree * (degree - 1));
+          sums[i] += clustering_[id];
+        }
+      });
+    }
+    runner_->SubmitSync(tasks);
+    for (size_t i = 0; i < num_tasks; i++) {
+      num_triangles_ += triangles[i];
+      clustering_sum_ += sums[i];
+    }
+    // Every triangle is counted at its 3 vertices.
+    if (++num_finished_ == meta_->num_blocks) {
+      LOGF_INFO("triangles: {}, average clustering coefficient: {}",
+                num_triangles_ / 3, clustering_sum_ / meta_->num_vertices);
+    }
+  }
+
+ private:
+  // degree of every vertex, and the size of its N+ once oriented.
+  std::vector<VertexDegree> degrees_;
+  std::vector<VertexDegree> plus_degrees_;
+  std::vector<float> clustering_;
+
+  // sub-blocks of each block holding N+ of a vertex of the current block.
+  // Not a vector<bool>, as they are set in parallel.
+  std::vector<std::vector<uint8_t>> needed_;
+
+  uint64_t num_triangles_ = 0;
+  double clustering_sum_ = 0;
+  GraphID num_finished_ = 0;
+};
+
+}  // namespace sics::graph::core::apps
+
+#endif  // GRAPH_SYSTEMS_CORE_APPS_TRIANGLE_COUNT_APP_OP_H
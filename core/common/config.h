@@ -2,6 +2,7 @@
 #define GRAPH_SYSTEMS_CORE_COMMON_CONFIG_H_
 
 #include <string>
+#include <vector>
 
 namespace sics::graph::core::common {
 
@@ -42,6 +43,12 @@ enum ApplicationType {
   PageRank,
   GNN,
   Khop,
+  Bfs,
+  TriangleCount,
+  KCore,
+  LabelPropagation,
+  Scc,
+  MultiSourceBfs,
 };
 
 enum ModeType {
@@ -70,8 +77,14 @@ class Configurations {
   Configurations& operator=(const Configurations& rhs) = delete;
   uint32_t task_package_factor = 100;
   uint32_t parallelism = 1;
+  // Vertices with more out edges than this are split into edge range tasks,
+  // when the operator supports it. 0 disables the splitting.
+  uint32_t hub_degree = 65536;
   PartitionType partition_type = PlanarVertexCut;
   std::string root_path = "/testfile";
+  // permutation written by graph_converter (vid_map.bin or permutation.bin),
+  // used to map vertex IDs from and to the input IDs. Empty for none.
+  std::string permutation_path = "";
   VertexDataType vertex_data_type = kVertexDataTypeUInt32;
   bool edge_mutate = false;
   bool in_memory = false;
@@ -88,12 +101,24 @@ class Configurations {
   // for sssp
   uint32_t source = 0;
   bool ASP = false;
+  uint32_t delta = 16;  // bucket width of delta stepping
+  // for bfs: bottom-up steps when the frontier is larger than 1 /
+  // bottom_up_ratio of the subgraph, 0 for top-down only.
+  uint32_t bottom_up_ratio = 20;
+  // for multi-source bfs, at most 64 sources traversed at once.
+  std::vector<uint32_t> sources;
   // for mst
   bool fast = false;
-  // for random walk
+  // for random walk: the walk length, the walks started from every vertex,
+  // the seed of the walks, and the file they are written to, empty for none.
   uint32_t walk = 5;
+  uint32_t walks_per_vertex = 1;
+  uint64_t walk_seed = 1;
+  std::string walk_output = "";
   // for pagerank
   uint32_t pr_iter = 10;
+  // for label propagation, the maximum number of rounds.
+  uint32_t lpa_iter = 10;
   // for GNN
   uint32_t gnn_l = 4;  // gnn feature size
   uint32_t gnn_k = 3;  // gnn layer size
@@ -121,6 +146,19 @@ class Configurations {
   // for nvme
   uint32_t task_size = 500000;
 
+  // Files written back at once by the dischargers, and whether they are
+  // synced to the storage before they replace the previous version.
+  uint32_t write_back_depth = 8;
+  bool sync_write_back = false;
+  // Mutated blocks append their deleted edges to a log until it exceeds this
+  // ratio of the block size, then are written in full. 0 always writes them
+  // in full.
+  double mutation_log_ratio = 0.25;
+
+  // for profiling, see util/profiler.h. Empty path disables it.
+  std::string profile_path = "";
+  std::string profile_format = "json";
+
  private:
   Configurations() = default;
   inline static Configurations* instance_ = nullptr;
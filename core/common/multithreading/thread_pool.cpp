@@ -1,5 +1,7 @@
 #include "thread_pool.h"
 
+#include "util/profiler.h"
+
 namespace sics::graph::core::common {
 
 ThreadPool::ThreadPool(uint32_t num_threads)
@@ -38,19 +40,24 @@ void ThreadPool::SubmitSync(Task&& task) {
 }
 
 void ThreadPool::SubmitSync(const TaskPackage& tasks) {
+  PROFILE_SCOPE("task.submit_sync");
+  PROFILE_COUNTER("task.tasks", tasks.size());
   std::mutex mtx;
   std::condition_variable finish_cv;
 
   size_t pending_packages = tasks.size();
-  for (const auto& t : tasks) {
-    internal_pool_.add([this, &finish_cv, &pending_packages, &mtx, &t]() {
-      t();
-      {
-        std::lock_guard<std::mutex> lck(mtx);
-        pending_packages--;
-        if (pending_packages == 0) finish_cv.notify_all();
-      }
-    });
+  {
+    PROFILE_SCOPE("task.dispatch");
+    for (const auto& t : tasks) {
+      internal_pool_.add([this, &finish_cv, &pending_packages, &mtx, &t]() {
+        t();
+        {
+          std::lock_guard<std::mutex> lck(mtx);
+          pending_packages--;
+          if (pending_packages == 0) finish_cv.notify_all();
+        }
+      });
+    }
   }
   std::unique_lock<std::mutex> lck(mtx);
   finish_cv.wait(lck, [&] { return pending_packages == 0; });
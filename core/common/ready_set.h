@@ -0,0 +1,118 @@
+#ifndef GRAPH_SYSTEMS_CORE_COMMON_READY_SET_H_
+#define GRAPH_SYSTEMS_CORE_COMMON_READY_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::common {
+
+// @DESCRIPTION
+//
+// ReadySet is a set of the integers of [0, size), for the schedulers to find
+// the next graph ready for some step without scanning all the graphs. Insert
+// and Erase take O(1), and FindNext O(log_64(size)) word operations, i.e. at
+// most 3 for a quarter million graphs.
+//
+// The members are kept in a bitmap, whose non-empty words are kept in a
+// bitmap of the level above, and so on up to a single word.
+class ReadySet {
+ public:
+  ReadySet() = default;
+  explicit ReadySet(size_t size) { Init(size); }
+
+  void Init(size_t size) {
+    size_ = size;
+    count_ = 0;
+    levels_.clear();
+    do {
+      size = (size + 63) / 64;
+      levels_.emplace_back(size, 0);
+    } while (size > 1);
+  }
+
+  bool Contains(size_t i) const {
+    return (levels_[0][i >> 6] >> (i & 0x3f)) & 1;
+  }
+
+  void Insert(size_t i) {
+    if (Contains(i)) return;
+    count_++;
+    for (auto& level : levels_) {
+      auto& word = level[i >> 6];
+      bool was_empty = word == 0;
+      word |= 1ull << (i & 0x3f);
+      if (!was_empty) break;
+      i >>= 6;
+    }
+  }
+
+  void Erase(size_t i) {
+    if (!Contains(i)) return;
+    count_--;
+    for (auto& level : levels_) {
+      auto& word = level[i >> 6];
+      word &= ~(1ull << (i & 0x3f));
+      if (word != 0) break;
+      i >>= 6;
+    }
+  }
+
+  // Insert all of [0, size).
+  void Fill() {
+    size_t bits = size_;
+    for (auto& level : levels_) {
+      std::fill(level.begin(), level.end(), ~0ull);
+      if (bits & 0x3f) level.back() = (1ull << (bits & 0x3f)) - 1;
+      bits = level.size();
+    }
+    count_ = size_;
+  }
+
+  void Clear() {
+    for (auto& level : levels_) std::fill(level.begin(), level.end(), 0);
+    count_ = 0;
+  }
+
+  // The smallest member not below `i`, or size() if there is none.
+  size_t FindNext(size_t i = 0) const {
+    // Go up until a word has a member at or after i...
+    size_t level = 0;
+    while (true) {
+      if (level == levels_.size() || (i >> 6) >= levels_[level].size()) {
+        return size_;
+      }
+      auto word = levels_[level][i >> 6] & (~0ull << (i & 0x3f));
+      if (word != 0) {
+        i = (i & ~size_t(0x3f)) + __builtin_ctzll(word);
+        break;
+      }
+      i = (i >> 6) + 1;
+      level++;
+    }
+    // ... then down to the first member of the words found.
+    while (level > 0) {
+      level--;
+      i = (i << 6) + __builtin_ctzll(levels_[level][i]);
+    }
+    return i;
+  }
+
+  size_t Count() const { return count_; }
+
+  bool Empty() const { return count_ == 0; }
+
+  size_t size() const { return size_; }
+
+ private:
+  size_t size_ = 0;
+  size_t count_ = 0;
+  // levels_[0] has the bit of each member, levels_[l + 1] the bit of each
+  // non-empty word of levels_[l].
+  std::vector<std::vector<uint64_t>> levels_;
+};
+
+}  // namespace sics::graph::core::common
+
+#endif  // GRAPH_SYSTEMS_CORE_COMMON_READY_SET_H_
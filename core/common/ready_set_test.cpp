@@ -0,0 +1,60 @@
+#include "ready_set.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+namespace sics::graph::core::common {
+
+class ReadySetTest : public ::testing::Test {
+ protected:
+  ReadySetTest() = default;
+};
+
+TEST_F(ReadySetTest, FindNextMatchesOrderedSet) {
+  std::mt19937 rand(0);
+  // One, two and three levels of words.
+  for (size_t size : {1, 64, 100, 4096, 5000, 300000}) {
+    ReadySet ready(size);
+    std::set<size_t> expected;
+    EXPECT_EQ(ready.FindNext(), size);
+    for (int i = 0; i < 2000; i++) {
+      size_t member = rand() % size;
+      if (rand() % 3 == 0) {
+        ready.Erase(member);
+        expected.erase(member);
+      } else {
+        ready.Insert(member);
+        expected.insert(member);
+      }
+      size_t from = rand() % size;
+      auto it = expected.lower_bound(from);
+      EXPECT_EQ(ready.FindNext(from), it == expected.end() ? size : *it);
+      EXPECT_EQ(ready.Count(), expected.size());
+    }
+    for (auto member : expected) ready.Erase(member);
+    EXPECT_TRUE(ready.Empty());
+    EXPECT_EQ(ready.FindNext(), size);
+  }
+}
+
+TEST_F(ReadySetTest, FillInsertsAll) {
+  ReadySet ready(4097);
+  ready.Fill();
+  EXPECT_EQ(ready.Count(), 4097);
+  size_t count = 0;
+  for (auto i = ready.FindNext(); i < ready.size(); i = ready.FindNext(i + 1)) {
+    EXPECT_EQ(i, count++);
+  }
+  EXPECT_EQ(count, 4097);
+  ready.Erase(4096);
+  ready.Erase(0);
+  EXPECT_EQ(ready.FindNext(), 1);
+  EXPECT_EQ(ready.FindNext(4000), 4000);
+  EXPECT_EQ(ready.FindNext(4096), 4097);
+  ready.Clear();
+  EXPECT_EQ(ready.FindNext(), 4097);
+}
+
+}  // namespace sics::graph::core::common
@@ -19,6 +19,7 @@ typedef uint32_t VertexCount;
 typedef uint64_t EdgeIndex;
 typedef uint32_t EdgeIndexS;  // for small edge index, used only in Block
 typedef uint32_t BlockID;
+typedef uint32_t EdgeWeight;  // for weighted blocks, see graph_metadata.h
 
 typedef uint8_t DefaultEdgeDataType;  // used for position
 typedef uint32_t Uint32VertexDataType;
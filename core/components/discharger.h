@@ -39,14 +39,18 @@ class Discharger : public Component {
       while (true) {
         scheduler::WriteMessage message = writer_q_->PopOrWait();
         if (message.terminated) {
+          writer_.Flush();
           LOG_INFO("*** Discharger is signaled termination ***");
           break;
         }
 
         LOGF_INFO("Discharger starts writing subgraph {}", message.graph_id);
-        writer_.Write(&message);
-        LOGF_INFO("Discharger completes writing subgraph {}", message.graph_id);
-        response_q_->Push(scheduler::Message(message));
+        writer_.WriteAsync(
+            &message, [this](const scheduler::WriteMessage& written) {
+              LOGF_INFO("Discharger completes writing subgraph {}",
+                        written.graph_id);
+              response_q_->Push(scheduler::Message(written));
+            });
       }
     });
   }
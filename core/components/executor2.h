@@ -12,6 +12,7 @@
 #include "components/component.h"
 #include "scheduler/message_hub.h"
 #include "util/logging.h"
+#include "util/profiler.h"
 
 namespace sics::graph::core::components {
 
@@ -44,6 +45,7 @@ class Executor2 : public Component {
         switch (message.execute_type) {
           case scheduler::ExecuteType::kDeserialize: {
             LOGF_INFO("Executor: Deserialize graph {}", message.graph_id);
+            PROFILE_SCOPE_ARG("executor.deserialize", message.graph_id);
             data_structures::Serializable* graph = message.graph;
             graph->Deserialize(task_runner_,
                                std::unique_ptr<data_structures::Serialized>(
@@ -51,24 +53,30 @@ class Executor2 : public Component {
             message.response_serializable = graph;
             break;
           }
-          case scheduler::ExecuteType::kPEval:
+          case scheduler::ExecuteType::kPEval: {
             LOGF_INFO("Executor: PEval graph {}", message.graph_id);
+            PROFILE_SCOPE_ARG("executor.peval", message.graph_id);
             if (in_memory_time_) start_time_ = std::chrono::system_clock::now();
             message.app->SetCurrentGid(message.graph_id);
             message.app->PEval();
             if (in_memory_time_) end_time_ = std::chrono::system_clock::now();
             break;
-          case scheduler::ExecuteType::kIncEval:
+          }
+          case scheduler::ExecuteType::kIncEval: {
             LOGF_INFO("Executor: kIncEval graph {}", message.graph_id);
+            PROFILE_SCOPE_ARG("executor.inceval", message.graph_id);
             message.app->SetCurrentGid(message.graph_id);
             message.app->IncEval();
             break;
-          case scheduler::ExecuteType::kSerialize:
+          }
+          case scheduler::ExecuteType::kSerialize: {
             LOGF_INFO("Executor: Serialized graph {}", message.graph_id);
+            PROFILE_SCOPE_ARG("executor.serialize", message.graph_id);
             // Set serialized graph to message for write back to disk.
             message.serialized =
                 message.graph->Serialize(task_runner_).release();
             break;
+          }
         }
         LOGF_INFO("Executor completes executing subgraph {}", message.graph_id);
         response_q_->Push(scheduler::Message(message));
@@ -16,6 +16,7 @@
 #include "scheduler/graph_state.h"
 #include "scheduler/message_hub.h"
 #include "util/logging.h"
+#include "util/profiler.h"
 
 namespace sics::graph::core::components {
 
@@ -58,7 +59,10 @@ class LoaderOp2 {
       begin++;
       queue_++;
     }
-    reader_.Read(current_gid_, reqs);
+    if (!reqs.empty()) {
+      PROFILE_SCOPE("io.read_submit");
+      reader_.Read(current_gid_, reqs);
+    }
     return begin;
   }
 
@@ -85,17 +89,21 @@ class LoaderOp2 {
           current_gid_ = message.graph_id;
         }
         int begin = 0;
+        // Time from the first submission until the last completion of the
+        // subgraph, i.e. the time spent waiting for the CQEs.
+        util::ScopedTimer cqe_wait("io.cqe_wait", message.graph_id);
         while (receive_ < to_read_blocks_id_.size()) {
           // Send QD requests per Read operation.
           begin = SubmitReadRequest(begin);
           auto load = CheckIOEntry();
           // TODO: Judge if to block for buffer release.
         }
-        buffer_->Push(4294967295);
         // One subgraph finished, terminate the executor for next one.
         //        scheduler::ReadMessage read_finish;
         //        read_finish.graph_id = current_gid_;
         //        response_q_->Push(scheduler::Message(read_finish));
+        // Marked loaded before the end marker, so an app that releases the
+        // sub-blocks once it gets the marker is not overwritten.
         if (common::Configurations::Get()->mode != common::Normal) {
           state_->SetEdgeLoaded(static_gid_);
           LOGF_INFO("Loading subgraph {} finish", static_gid_);
@@ -103,6 +111,7 @@ class LoaderOp2 {
           graphs_->at(current_gid_).SetEdgeLoaded(true);
           LOGF_INFO("Loading subgraph {} finish", current_gid_);
         }
+        buffer_->Push(4294967295);
 
         receive_ = 0;
         queue_ = 0;
@@ -154,7 +163,7 @@ class LoaderOp2 {
     } else {
       auto num_sub_blocks = meta_->blocks.at(gid).num_sub_blocks;
       for (common::BlockID i = 0; i < num_sub_blocks; i++) {
-        to_read_blocks_id_.push_back(i);
+        if (buffer_->IsSubBlockToRead(gid, i)) to_read_blocks_id_.push_back(i);
       }
     }
   }
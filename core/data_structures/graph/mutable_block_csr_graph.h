@@ -1,6 +1,7 @@
 #ifndef GRAPH_SYSTEMS_CORE_DATA_STRUCTURES_GRAPH_MUTABLE_BLOCK_CSR_GRAPH_H_
 #define GRAPH_SYSTEMS_CORE_DATA_STRUCTURES_GRAPH_MUTABLE_BLOCK_CSR_GRAPH_H_
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -53,6 +54,10 @@ class MutableBlockCSRGraph {
   using VertexIndex = common::VertexIndex;
   using EdgeIndex = common::EdgeIndex;
   using VertexDegree = common::VertexDegree;
+  using EdgeWeight = common::EdgeWeight;
+
+  static_assert(sizeof(EdgeWeight) == sizeof(VertexID),
+                "weights share the sub-block buffer of the edges");
 
  public:
   MutableBlockCSRGraph(){};
@@ -87,6 +92,13 @@ class MutableBlockCSRGraph {
     file.read((char*)(out_offset_reduce_), num_offsets * sizeof(EdgeIndex));
     file.read((char*)(out_degree_),
               block_meta->num_vertices * sizeof(VertexDegree));
+    if (block_meta->in_edges) {
+      in_offset_reduce_ = new EdgeIndex[num_offsets];
+      in_degree_ = new VertexDegree[block_meta->num_vertices];
+      file.read((char*)(in_offset_reduce_), num_offsets * sizeof(EdgeIndex));
+      file.read((char*)(in_degree_),
+                block_meta->num_vertices * sizeof(VertexDegree));
+    }
     file.close();
     // Init vector size;
     sub_blocks_.resize(block_meta->num_sub_blocks);
@@ -96,12 +108,21 @@ class MutableBlockCSRGraph {
       edge_delete_bitmaps_.emplace_back(block_meta->sub_blocks.at(i).num_edges);
       num_edges_[i] = block_meta->sub_blocks.at(i).num_edges;
     }
+    // Sub-blocks sized by a cost model have no common number of vertices.
+    if (block_meta->vertex_offset == 0) {
+      sub_block_ends_.clear();
+      for (auto& sub_block : block_meta->sub_blocks) {
+        sub_block_ends_.push_back(sub_block.end_id - block_meta->begin_id);
+      }
+    }
     mode_ = common::Configurations::Get()->mode;
   }
 
   ~MutableBlockCSRGraph() {
     delete[] out_offset_reduce_;
     delete[] out_degree_;
+    delete[] in_offset_reduce_;
+    delete[] in_degree_;
     delete[] num_edges_;
   };
 
@@ -140,7 +161,12 @@ class MutableBlockCSRGraph {
 
   BlockID GetSubBlockID(VertexID id) {
     auto idx = id - metadata_block_->begin_id;
-    return idx / metadata_block_->vertex_offset;
+    if (metadata_block_->vertex_offset != 0) {
+      return idx / metadata_block_->vertex_offset;
+    }
+    return std::upper_bound(sub_block_ends_.begin(), sub_block_ends_.end(),
+                            idx) -
+           sub_block_ends_.begin();
   }
 
   EdgeIndex GetInitOffset(VertexID id) {
@@ -156,12 +182,68 @@ class MutableBlockCSRGraph {
            (offset - metadata_block_->sub_blocks.at(subBlock_id).begin_offset);
   }
 
+  // Weights of the out edges of `id`, parallel to GetOutEdges, or nullptr if
+  // the block is not weighted.
+  EdgeWeight* GetOutWeights(VertexID id) {
+    if (!metadata_block_->weighted) return nullptr;
+    auto offset = GetOutOffset(id);
+    auto subBlock_id = GetSubBlockID(id);
+    auto& sub_block = metadata_block_->sub_blocks.at(subBlock_id);
+    auto edges_base = sub_blocks_.at(subBlock_id).out_edges_base_;
+    auto weights_base = (EdgeWeight*)(edges_base + sub_block.num_edges);
+    return weights_base + (offset - sub_block.begin_offset);
+  }
+
   VertexID* GetAllEdges(BlockID bid) {
     return sub_blocks_.at(bid).out_edges_base_;
   }
 
+  bool IsWeighted() const { return metadata_block_->weighted; }
+
+  bool HasInEdges() const { return metadata_block_->in_edges; }
+
+  VertexDegree GetInDegree(VertexID id) {
+    return in_degree_[id - metadata_block_->begin_id];
+  }
+
+  EdgeIndex GetInOffset(VertexID vid) {
+    auto idx = vid - metadata_block_->begin_id;
+    auto b = idx / metadata_block_->offset_ratio;
+    uint64_t res = in_offset_reduce_[b];
+    auto beg = b * metadata_block_->offset_ratio;
+    while (beg < idx) {
+      res += in_degree_[beg++];
+    }
+    return res;
+  }
+
+  // In edges of `id`, which follow the out edges and weights in the buffer of
+  // its sub_block. Only valid if the block has in edges.
+  VertexID* GetInEdges(VertexID id) {
+    auto offset = GetInOffset(id);
+    auto subBlock_id = GetSubBlockID(id);
+    auto& sub_block = metadata_block_->sub_blocks.at(subBlock_id);
+    auto num_out = (metadata_block_->weighted ? 2 : 1) * sub_block.num_edges;
+    auto in_edges_base = sub_blocks_.at(subBlock_id).out_edges_base_ + num_out;
+    return in_edges_base + (offset - sub_block.in_begin_offset);
+  }
+
+  // Bytes of sub_block `bid`, as in its file: the edges, then the weights if
+  // the block is weighted, then the in edges if it has them.
+  size_t GetSubBlockSize(BlockID bid) const {
+    auto& sub_block = metadata_block_->sub_blocks.at(bid);
+    size_t size = (size_t)sub_block.num_edges * sizeof(VertexID);
+    if (metadata_block_->weighted) {
+      size += (size_t)sub_block.num_edges * sizeof(EdgeWeight);
+    }
+    if (metadata_block_->in_edges) {
+      size += (size_t)sub_block.num_in_edges * sizeof(VertexID);
+    }
+    return size;
+  }
+
   VertexID* ApplySubBlockBuffer(BlockID bid) {
-    sub_blocks_.at(bid).Init(metadata_block_->sub_blocks.at(bid).num_edges);
+    sub_blocks_.at(bid).Init(GetSubBlockSize(bid) / sizeof(VertexID));
     return sub_blocks_.at(bid).out_edges_base_;
   }
 
@@ -169,31 +251,19 @@ class MutableBlockCSRGraph {
     return &edge_delete_bitmaps_.at(bid);
   }
 
-  // One thread works for one sub_block, so no need for lock.
-  // TODO: attention for Static mode, which maybe conflict above.
+  // The tasks of a pass may split a sub_block by its edges, so the edge count
+  // of a sub_block is decremented atomically in every mode.
   void DeleteEdge(VertexID id, EdgeIndex idx) {
     auto subBlock_id = GetSubBlockID(id);
     edge_delete_bitmaps_.at(subBlock_id).SetBit(idx);
-    if (mode_ == common::Static) {
-      //      std::lock_guard<std::mutex> lock(mtx_);
-      //      num_edges_.at(subBlock_id) = num_edges_.at(subBlock_id) - 1;
-      util::atomic::WriteSub(num_edges_ + subBlock_id, EdgeIndex(1));
-      return;
-    }
-    num_edges_[subBlock_id] = num_edges_[subBlock_id] - 1;
+    util::atomic::WriteSub(num_edges_ + subBlock_id, EdgeIndex(1));
   }
 
   void DeleteEdgeByVertex(VertexID id, EdgeIndex idx) {
     auto subBlock_id = GetSubBlockID(id);
     auto offset = GetInitOffset(id);
     edge_delete_bitmaps_.at(subBlock_id).SetBit(offset + idx);
-    if (mode_ == common::Static) {
-      //      std::lock_guard<std::mutex> lock(mtx_);
-      //      num_edges_[subBlock_id] = num_edges_[subBlock_id] - 1;
-      util::atomic::WriteSub(num_edges_ + subBlock_id, EdgeIndex(1));
-      return;
-    }
-    num_edges_[subBlock_id] = num_edges_[subBlock_id] - 1;
+    util::atomic::WriteSub(num_edges_ + subBlock_id, EdgeIndex(1));
   }
 
   bool IsEdgeDelete(VertexID id, EdgeIndex idx) {
@@ -308,9 +378,14 @@ class MutableBlockCSRGraph {
 
   EdgeIndex* out_offset_reduce_ = nullptr;
   VertexDegree* out_degree_ = nullptr;
+  // Only read if the block has in edges.
+  EdgeIndex* in_offset_reduce_ = nullptr;
+  VertexDegree* in_degree_ = nullptr;
 
   // Edges sub_block. init in constructor.
   std::vector<SubBlockImpl> sub_blocks_;
+  // Local end of each sub-block, if they are not of vertex_offset vertices.
+  std::vector<VertexID> sub_block_ends_;
   std::vector<common::Bitmap> edge_delete_bitmaps_;
   //  std::vector<EdgeIndex> num_edges_;
   EdgeIndex* num_edges_ = nullptr;
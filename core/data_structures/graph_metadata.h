@@ -48,6 +48,10 @@ struct SubBlock {
   uint32_t num_edges;
   uint32_t num_vertices;
   EdgeIndex begin_offset;
+  // In edges of the vertices of the sub_block, if the block has them, and the
+  // offset of the first in the in edges of the block.
+  uint32_t num_in_edges = 0;
+  EdgeIndex in_begin_offset = 0;
 };
 
 struct Block {
@@ -59,7 +63,15 @@ struct Block {
   uint32_t offset_ratio = 64;
   VertexID begin_id;
   VertexID end_id;
+  // Vertices of every sub-block but the last, or 0 if they vary, e.g. when
+  // sized by a SubBlockCostModel.
   uint32_t vertex_offset;
+  // If set, each sub-block file holds the EdgeWeight of every edge after its
+  // VertexID array, in the same order.
+  bool weighted = false;
+  // If set, each sub-block file ends with the in edges of its vertices, and
+  // index.bin with their in offsets and degrees, as for the out edges.
+  bool in_edges = false;
   std::vector<SubBlock> sub_blocks;
 };
 
@@ -365,6 +377,10 @@ struct convert<sics::graph::core::data_structures::SubBlock> {
     node["num_vertices"] = block.num_vertices;
     node["num_edges"] = block.num_edges;
     node["begin_offset"] = block.begin_offset;
+    if (block.num_in_edges != 0 || block.in_begin_offset != 0) {
+      node["num_in_edges"] = block.num_in_edges;
+      node["in_begin_offset"] = block.in_begin_offset;
+    }
     return node;
   }
   static bool decode(const Node& node,
@@ -375,6 +391,10 @@ struct convert<sics::graph::core::data_structures::SubBlock> {
     block.num_vertices = node["num_vertices"].as<uint32_t>();
     block.num_edges = node["num_edges"].as<uint32_t>();
     block.begin_offset = node["begin_offset"].as<EdgeIndex>();
+    if (node["num_in_edges"]) {
+      block.num_in_edges = node["num_in_edges"].as<uint32_t>();
+      block.in_begin_offset = node["in_begin_offset"].as<EdgeIndex>();
+    }
     return true;
   }
 };
@@ -391,6 +411,8 @@ struct convert<sics::graph::core::data_structures::Block> {
     node["begin_id"] = block.begin_id;
     node["end_id"] = block.end_id;
     node["vertex_offset"] = block.vertex_offset;
+    if (block.weighted) node["weighted"] = true;
+    if (block.in_edges) node["in_edges"] = true;
     node["sub_blocks"] = block.sub_blocks;
     return node;
   }
@@ -404,6 +426,8 @@ struct convert<sics::graph::core::data_structures::Block> {
     block.begin_id = node["begin_id"].as<VertexID>();
     block.end_id = node["end_id"].as<VertexID>();
     block.vertex_offset = node["vertex_offset"].as<uint32_t>();
+    block.weighted = node["weighted"] && node["weighted"].as<bool>();
+    block.in_edges = node["in_edges"] && node["in_edges"].as<bool>();
     block.sub_blocks =
         node["sub_blocks"]
             .as<std::vector<sics::graph::core::data_structures::SubBlock>>();
@@ -0,0 +1,158 @@
+#include "io/async_file_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "util/logging.h"
+#include "util/profiler.h"
+
+namespace sics::graph::core::io {
+
+AsyncFileWriter::AsyncFileWriter(unsigned max_in_flight, bool sync)
+    : max_in_flight_(max_in_flight == 0 ? 1 : max_in_flight), sync_(sync) {
+  // Each file has one request queued at a time, plus the stop signal.
+  auto ret = io_uring_queue_init(max_in_flight_ + 1, &ring_, 0);
+  if (ret < 0) {
+    LOGF_FATAL("queue_init: {}", ret);
+  }
+  reaper_ = std::make_unique<std::thread>([this]() { Reap(); });
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(sq_mtx_);
+    auto sqe = io_uring_get_sqe(&ring_);
+    if (!sqe) LOG_FATAL("Error at get sqe");
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+  reaper_->join();
+  io_uring_queue_exit(&ring_);
+}
+
+void AsyncFileWriter::Submit(std::vector<File> files,
+                             std::function<void()> on_complete) {
+  if (files.empty()) {
+    if (on_complete) on_complete();
+    return;
+  }
+  auto shared_on_complete =
+      std::make_shared<std::function<void()>>(std::move(on_complete));
+  auto files_left = std::make_shared<std::atomic<size_t>>(files.size());
+  for (auto& file : files) {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      cv_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+      in_flight_++;
+    }
+    auto open_path = file.append ? file.path : file.path + ".tmp";
+    int fd = open(open_path.c_str(),
+                  O_WRONLY | O_CREAT | (file.append ? 0 : O_TRUNC), 0644);
+    if (fd < 0) {
+      LOGF_FATAL("Error opening {}: {}", open_path, strerror(errno));
+    }
+    auto pending = new PendingFile;
+    pending->fd = fd;
+    pending->path = std::move(file.path);
+    pending->iovecs = std::move(file.iovecs);
+    pending->append = file.append;
+    if (file.append) {
+      pending->begin = lseek(fd, 0, SEEK_END);
+      pending->offset = pending->begin;
+    }
+    pending->on_complete = shared_on_complete;
+    pending->files_left = files_left;
+    SubmitNext(pending);
+  }
+}
+
+void AsyncFileWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  cv_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+void AsyncFileWriter::SubmitNext(PendingFile* file) {
+  std::lock_guard<std::mutex> lock(sq_mtx_);
+  auto sqe = io_uring_get_sqe(&ring_);
+  if (!sqe) LOG_FATAL("Error at get sqe");
+  if (file->syncing) {
+    io_uring_prep_fsync(sqe, file->fd, IORING_FSYNC_DATASYNC);
+  } else {
+    io_uring_prep_writev(sqe, file->fd, file->iovecs.data() + file->next,
+                         file->iovecs.size() - file->next, file->offset);
+  }
+  io_uring_sqe_set_data(sqe, file);
+  if (io_uring_submit(&ring_) < 0) LOG_FATAL("Error at submit sqes");
+}
+
+void AsyncFileWriter::Complete(PendingFile* file, int res) {
+  if (res < 0) {
+    LOGF_FATAL("Error writing {}: {}", file->path, strerror(-res));
+  }
+  if (!file->syncing) {
+    // A write may be short: skip what it wrote and write the rest.
+    size_t written = res;
+    file->offset += written;
+    while (file->next < file->iovecs.size() &&
+           written >= file->iovecs[file->next].iov_len) {
+      written -= file->iovecs[file->next].iov_len;
+      file->next++;
+    }
+    if (file->next < file->iovecs.size()) {
+      if (res == 0) LOGF_FATAL("Error writing {}: no progress", file->path);
+      auto& iov = file->iovecs[file->next];
+      iov.iov_base = (char*)iov.iov_base + written;
+      iov.iov_len -= written;
+      SubmitNext(file);
+      return;
+    }
+    if (sync_) {
+      file->syncing = true;
+      SubmitNext(file);
+      return;
+    }
+  }
+
+  close(file->fd);
+  auto tmp_path = file->path + ".tmp";
+  if (!file->append && rename(tmp_path.c_str(), file->path.c_str()) != 0) {
+    LOGF_FATAL("Error renaming {}: {}", tmp_path, strerror(errno));
+  }
+  PROFILE_COUNTER("io.write_bytes", file->offset - file->begin);
+  bytes_written_ += file->offset - file->begin;
+  if (--*file->files_left == 0 && *file->on_complete) {
+    (*file->on_complete)();
+  }
+  delete file;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    in_flight_--;
+  }
+  cv_.notify_all();
+}
+
+void AsyncFileWriter::Reap() {
+  while (true) {
+    struct io_uring_cqe* cqe;
+    auto ret = io_uring_wait_cqe(&ring_, &cqe);
+    if (ret == -EINTR) continue;
+    if (ret < 0) {
+      LOGF_FATAL("wait_cqe: {}", ret);
+    }
+    auto file = (PendingFile*)io_uring_cqe_get_data(cqe);
+    auto res = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    // The only request without a file is the stop signal.
+    if (file == nullptr) break;
+    Complete(file, res);
+  }
+}
+
+}  // namespace sics::graph::core::io
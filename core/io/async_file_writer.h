@@ -0,0 +1,100 @@
+#ifndef GRAPH_SYSTEMS_CORE_IO_ASYNC_FILE_WRITER_H_
+#define GRAPH_SYSTEMS_CORE_IO_ASYNC_FILE_WRITER_H_
+
+#include <liburing.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sics::graph::core::io {
+
+// Writes whole files with io_uring, so that the caller does not wait for the
+// storage and several files are written at once.
+//
+// Each file is written as a single vectored write to `<path>.tmp`, followed by
+// an fdatasync if `sync` is set, and renamed to `path` once complete, so that
+// `path` is either the previous version or the new one in full. Files to
+// append to are written in place, at their end. A thread owned by the writer
+// reaps the completions and calls the callbacks.
+// @EXAMPLE
+//  AsyncFileWriter writer(8, false);
+//  auto buffer = std::make_shared<OwnedBuffer>(size);
+//  writer.Submit({{path, {{buffer->Get(), buffer->GetSize()}}}},
+//                [buffer]() { /* the last reference to buffer is dropped */ });
+//  writer.Flush();
+class AsyncFileWriter {
+ public:
+  struct File {
+    std::string path;
+    // Content of the file, in order.
+    std::vector<iovec> iovecs;
+    // Whether the content is appended to the file rather than replacing it.
+    bool append = false;
+  };
+
+  // At most `max_in_flight` files are written at once; Submit blocks until one
+  // completes beyond that.
+  explicit AsyncFileWriter(unsigned max_in_flight = 8, bool sync = false);
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+  // Write `files`, and call `on_complete` from the reaping thread once they
+  // are all renamed. The memory the iovecs point to must stay valid until
+  // then.
+  void Submit(std::vector<File> files,
+              std::function<void()> on_complete = nullptr);
+
+  // Block until all submitted files are written.
+  void Flush();
+
+  size_t GetBytesWritten() const { return bytes_written_; }
+
+ private:
+  struct PendingFile {
+    int fd;
+    std::string path;
+    std::vector<iovec> iovecs;
+    bool append;
+    // First iovec not written yet, and the offsets the write started at and
+    // continues from.
+    size_t next = 0;
+    size_t begin = 0;
+    size_t offset = 0;
+    bool syncing = false;
+    // Called when the last file of its Submit is written.
+    std::shared_ptr<std::function<void()>> on_complete;
+    std::shared_ptr<std::atomic<size_t>> files_left;
+  };
+
+  // Queue the next request of the file: the write of its remaining iovecs, or
+  // the fdatasync once they are written.
+  void SubmitNext(PendingFile* file);
+  void Complete(PendingFile* file, int res);
+  void Reap();
+
+  const unsigned max_in_flight_;
+  const bool sync_;
+  struct io_uring ring_;
+  // Guards the submission queue, used by both Submit and the reaping thread.
+  std::mutex sq_mtx_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  unsigned in_flight_ = 0;
+  std::atomic<size_t> bytes_written_ = 0;
+
+  std::unique_ptr<std::thread> reaper_;
+};
+
+}  // namespace sics::graph::core::io
+
+#endif  // GRAPH_SYSTEMS_CORE_IO_ASYNC_FILE_WRITER_H_
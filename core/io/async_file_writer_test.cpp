@@ -0,0 +1,84 @@
+#include "io/async_file_writer.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace sics::graph::core::io {
+
+class AsyncFileWriterTest : public ::testing::Test {
+ protected:
+  AsyncFileWriterTest() { std::filesystem::create_directories(root_); }
+  ~AsyncFileWriterTest() override { std::filesystem::remove_all(root_); }
+
+  static std::string ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  }
+
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/async_file_writer_test_" + std::to_string(getpid()) +
+                      "/";
+};
+
+TEST_F(AsyncFileWriterTest, WritesAllFilesThenCallsBack) {
+  std::string meta = "meta data", edges = "edges of the block", label = "l";
+  std::atomic<int> calls = 0;
+  {
+    AsyncFileWriter writer(1, true);
+    writer.Submit({{root_ + "0.bin", {{meta.data(), meta.size()},
+                                      {edges.data(), edges.size()}}},
+                   {root_ + "0.label", {{label.data(), label.size()}}}},
+                  [&]() { calls++; });
+    writer.Flush();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(writer.GetBytesWritten(), meta.size() + edges.size() + 1);
+  }
+  EXPECT_EQ(ReadFile(root_ + "0.bin"), meta + edges);
+  EXPECT_EQ(ReadFile(root_ + "0.label"), label);
+  EXPECT_FALSE(std::filesystem::exists(root_ + "0.bin.tmp"));
+}
+
+TEST_F(AsyncFileWriterTest, ReplacesPreviousVersions) {
+  std::atomic<int> calls = 0;
+  std::string old_content(100, 'x');
+  std::vector<std::string> contents;
+  for (int i = 0; i < 16; i++) contents.push_back(std::to_string(i * 7919));
+
+  AsyncFileWriter writer(4);
+  for (int i = 0; i < 16; i++) {
+    auto path = root_ + std::to_string(i) + ".bin.new";
+    std::ofstream(path) << old_content;
+    writer.Submit({{path, {{contents[i].data(), contents[i].size()}}}},
+                  [&]() { calls++; });
+  }
+  writer.Flush();
+  EXPECT_EQ(calls, 16);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(ReadFile(root_ + std::to_string(i) + ".bin.new"), contents[i]);
+  }
+
+  // Nothing to write completes at once.
+  writer.Submit({}, [&]() { calls++; });
+  EXPECT_EQ(calls, 17);
+}
+
+TEST_F(AsyncFileWriterTest, AppendsInPlace) {
+  std::string first = "first record", second = "second";
+  std::ofstream(root_ + "0.log") << first;
+  AsyncFileWriter writer;
+  AsyncFileWriter::File file{root_ + "0.log",
+                             {{second.data(), second.size()}}};
+  file.append = true;
+  writer.Submit({file});
+  writer.Flush();
+  EXPECT_EQ(ReadFile(root_ + "0.log"), first + second);
+  EXPECT_EQ(writer.GetBytesWritten(), second.size());
+}
+
+}  // namespace sics::graph::core::io
@@ -21,6 +21,7 @@
 #include "io/csr_edge_block_reader.h"
 #include "io/reader_writer.h"
 #include "scheduler/edge_buffer2.h"
+#include "util/profiler.h"
 
 namespace sics::graph::core::io {
 
@@ -84,6 +85,10 @@ class CSREdgeBlockReader2 {
       if (fstat(fd, &sb) < 0) {
         LOG_FATAL("Error at fstat");
       }
+      if ((size_t)sb.st_size > graphs_->at(gid).GetSubBlockSize(bid)) {
+        LOGF_FATAL("Sub-block file {} has {} bytes, {} expected", path,
+                   sb.st_size, graphs_->at(gid).GetSubBlockSize(bid));
+      }
       io_data* data = (io_data*)malloc(sizeof(io_data));
       data->size = sb.st_size;
       data->gid = gid;
@@ -132,6 +137,7 @@ class CSREdgeBlockReader2 {
         break;
       }
       io_data* data = (io_data*)io_uring_cqe_get_data(cqe);
+      if (cqe->res > 0) PROFILE_COUNTER("io.read_bytes", cqe->res);
       auto size_to = data->size;
       if (size_to > 2747483647) {
         auto size = cqe->res;
@@ -170,6 +176,7 @@ class CSREdgeBlockReader2 {
     //    if (ids != "") {
     //      LOGF_INFO("Read blocks: {}", ids);
     //    }
+    if (num_cqe != 0) PROFILE_COUNTER("io.sub_blocks_read", num_cqe);
     return num_cqe;
   }
 
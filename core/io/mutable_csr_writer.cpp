@@ -4,51 +4,38 @@ namespace sics::graph::core::io {
 
 void MutableCSRWriter::Write(WriteMessage* message,
                              common::TaskRunner* /* runner */) {
+  WriteAsync(message, [](const WriteMessage&) {});
+  file_writer_.Flush();
+}
+
+void MutableCSRWriter::WriteAsync(
+    WriteMessage* message,
+    const std::function<void(const WriteMessage&)>& on_written) {
   std::string file_path =
       root_path_ + "graphs/" + std::to_string(message->graph_id) + ".bin.new";
   std::string label_path =
       root_path_ + "label/" + std::to_string(message->graph_id) + ".bin.new";
 
+  // The buffers are kept until the files are written: the meta data and
+  // edges of the subgraph, then its labels.
+  auto buffers = std::make_shared<std::vector<OwnedBUffer>>();
+  std::vector<AsyncFileWriter::File> files;
   if (message->serialized->HasNext()) {
-    auto a = message->serialized->PopNext();
+    *buffers = message->serialized->PopNext();
+    auto iovec_of = [&](size_t i) {
+      return iovec{buffers->at(i).Get(), buffers->at(i).GetSize()};
+    };
     if (common::Configurations::GetMutable()->edge_mutate) {
-      WriteMetaInfoToBin(file_path, a);
+      files.push_back({file_path, {iovec_of(0), iovec_of(1)}});
     }
-    WriteLabelInfoToBin(label_path, a);
-  }
-}
-
-void MutableCSRWriter::WriteMetaInfoToBin(
-    const std::string& path, const std::vector<OwnedBUffer>& buffers) {
-  // TODO: create if file do not exist
-  std::ofstream file(path, std::ios::binary);
-  if (!file) {
-    LOG_FATAL("Error opening bin file: ", path.c_str());
-  }
-
-  file.write((char*) (buffers.at(0).Get()), buffers.at(0).GetSize());
-  if (!file) {
-    LOG_FATAL("Error writing meta data file: ", path.c_str());
-  }
-  file.write((char*) (buffers.at(1).Get()), buffers.at(1).GetSize());
-  if (!file) {
-    LOG_FATAL("Error writing label data file: ", path.c_str());
-  }
-  file.close();
-}
-
-void MutableCSRWriter::WriteLabelInfoToBin(
-    const std::string& path, const std::vector<OwnedBUffer>& buffers) {
-  std::ofstream label_file(path, std::ios::binary);
-  if (!label_file) {
-    LOG_INFO("Error opening label bin file: ", path.c_str());
+    files.push_back({label_path, {iovec_of(2)}});
   }
 
-  label_file.write((char*) (buffers.at(2).Get()), buffers.at(2).GetSize());
-  if (!label_file) {
-    LOG_FATAL("Error writing label data file: ", path.c_str());
-  }
-  label_file.close();
+  file_writer_.Submit(std::move(files),
+                      [buffers, message = *message, on_written]() {
+                        buffers->clear();
+                        on_written(message);
+                      });
 }
 
-}  // namespace sics::graph::core::io
\ No newline at end of file
+}  // namespace sics::graph::core::io
@@ -12,18 +12,25 @@
 #include "data_structures/buffer.h"
 #include "data_structures/graph_metadata.h"
 #include "data_structures/serialized.h"
+#include "io/async_file_writer.h"
 #include "io/reader_writer.h"
 #include "scheduler/message.h"
 
 namespace sics::graph::core::io {
 
+// Writes the subgraphs back to `graphs/<gid>.bin.new` with edge mutation, and
+// their labels to `label/<gid>.bin.new`, several subgraphs at once. The
+// buffers of a subgraph are released once it is written.
 class MutableCSRWriter : public Writer {
  private:
   using OwnedBUffer = data_structures::OwnedBuffer;
   using Serialized = data_structures::Serialized;
 
  public:
-  MutableCSRWriter(const std::string& root_path) : root_path_(root_path) {}
+  MutableCSRWriter(const std::string& root_path)
+      : root_path_(root_path),
+        file_writer_(common::Configurations::Get()->write_back_depth,
+                     common::Configurations::Get()->sync_write_back) {}
 
   void Init(const std::string& root_path) {
     // copy the root path
@@ -33,15 +40,15 @@ class MutableCSRWriter : public Writer {
   void Write(WriteMessage* message,
              common::TaskRunner* runner = nullptr) override;
 
- private:
-  void WriteMetaInfoToBin(const std::string& path,
-                          const std::vector<OwnedBUffer>& buffers);
+  void WriteAsync(
+      WriteMessage* message,
+      const std::function<void(const WriteMessage&)>& on_written) override;
 
-  void WriteLabelInfoToBin(const std::string& path,
-                           const std::vector<OwnedBUffer>& buffers);
+  void Flush() override { file_writer_.Flush(); }
 
  private:
   std::string root_path_;
+  AsyncFileWriter file_writer_;
 };
 
 }  // namespace sics::graph::core::io
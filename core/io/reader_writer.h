@@ -1,6 +1,8 @@
 #ifndef CORE_IO_RW_INTERFACE_H_
 #define CORE_IO_RW_INTERFACE_H_
 
+#include <functional>
+
 #include "common/multithreading/task_runner.h"
 #include "scheduler/message.h"
 
@@ -36,6 +38,19 @@ class Writer {
   // caller thread; otherwise, it will be executed by the provided task runner.
   virtual void Write(WriteMessage* message,
                      common::TaskRunner* runner = nullptr) = 0;
+
+  // Write a subgraph without waiting for the storage: `on_written` is called
+  // with the message, possibly from another thread, once it is written. The
+  // default waits for Write.
+  virtual void WriteAsync(
+      WriteMessage* message,
+      const std::function<void(const WriteMessage&)>& on_written) {
+    Write(message);
+    on_written(*message);
+  }
+
+  // Block until the writes in progress are complete.
+  virtual void Flush() {}
 };
 
 }  // namespace sics::graph::core::io
@@ -18,6 +18,7 @@
 #include "scheduler/graph_state.h"
 #include "scheduler/scheduler2.h"
 #include "update_stores/bsp_update_store.h"
+#include "util/profiler.h"
 
 namespace sics::graph::core::planar_system {
 
@@ -31,6 +32,11 @@ class Planar {
   Planar(const std::string& root_path)
       : meta_(root_path),
         scheduler_(std::make_unique<scheduler::Scheduler2>(root_path)) {
+    auto config = common::Configurations::Get();
+    if (!config->profile_path.empty()) {
+      util::Profiler::Get()->Enable(config->profile_path,
+                                    config->profile_format);
+    }
     graphs_.resize(meta_.num_blocks);
     for (int i = 0; i < meta_.num_blocks; i++) {
       graphs_.at(i).Init(root_path, &meta_.blocks.at(i));
@@ -63,6 +69,7 @@ class Planar {
   void Start() {
     LOG_INFO("start components!");
     start_time_ = std::chrono::system_clock::now();
+    PROFILE_SCOPE("planar.run");
     loader2_.Start();
     executer_->Start();
     scheduler_->Start();
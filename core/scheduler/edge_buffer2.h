@@ -40,7 +40,7 @@ class EdgeBuffer2 {
     for (GraphID i = 0; i < meta->num_blocks; i++) {
       auto block_meta = meta->blocks.at(i);
       for (BlockID j = 0; j < block_meta.num_sub_blocks; j++) {
-        auto size = sizeof(VertexID) * block_meta.sub_blocks.at(j).num_edges;
+        auto size = graphs->at(i).GetSubBlockSize(j);
         max_block_size_ = std::max(max_block_size_, size);
         edge_block_size_.at(i).push_back(size);
       }
@@ -92,9 +92,12 @@ class EdgeBuffer2 {
     ReleaseBuffer(entry.first, entry.second);
   }
 
+  // Only the sub-blocks in memory give their space back, the others were not
+  // read (see `SetSubBlockToRead`) or are already finished.
   void ReleaseBuffer(GraphID gid) {
     std::lock_guard<std::mutex> lock(mtx_);
     for (int i = 0; i < meta_->blocks.at(gid).num_sub_blocks; i++) {
+      if (!is_in_memory_.at(gid).at(i)) continue;
       graphs_->at(gid).Release(i);
       is_in_memory_.at(gid).at(i) = false;
       buffer_size_ += edge_block_size_.at(gid).at(i);
@@ -149,6 +152,19 @@ class EdgeBuffer2 {
     //    cv_.notify_all();
   }
 
+  // LoaderOp2 skips the sub-blocks not to read, for apps that know their
+  // edges are not needed in the next evaluation of the subgraph. All are read
+  // by default.
+  void SetSubBlockToRead(GraphID gid, BlockID bid, bool to_read) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    is_active_.at(gid).at(bid) = to_read;
+  }
+
+  bool IsSubBlockToRead(GraphID gid, BlockID bid) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return is_active_.at(gid).at(bid);
+  }
+
   std::vector<BlockID> GetBlocksInMemory(GraphID gid) {
     std::vector<BlockID> res;
     for (BlockID bid = 0; bid < is_active_.at(gid).size(); bid++) {
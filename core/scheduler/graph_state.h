@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "common/ready_set.h"
 #include "common/types.h"
 #include "data_structures/graph/serialized_mutable_csr_graph.h"
 #include "data_structures/serializable.h"
@@ -50,6 +51,8 @@ struct GraphState {
     serialized_.resize(num_subgraphs_);
     graphs_.resize(num_subgraphs_);
     current_round_pending_.resize(num_subgraphs_, true);
+    pending_.Init(num_subgraphs_);
+    pending_.Fill();
     next_round_pending_.resize(num_subgraphs_, false);
     is_block_mode_ = common::Configurations::Get()->is_block_mode;
   }
@@ -76,7 +79,7 @@ struct GraphState {
 
   void SetDeserializedToComputed(common::GraphID gid) {
     subgraph_storage_state_.at(gid) = Computed;
-    current_round_pending_.at(gid) = false;
+    SetPending(gid, false);
   }
 
   void SetComputedToSerialized(common::GraphID gid) {
@@ -96,11 +99,11 @@ struct GraphState {
   void UpdateSubgraphState2(common::GraphID gid, StorageStateType type) {
     subgraph_storage_state_.at(gid) = type;
     subgraph_round_.at(gid) = subgraph_round_.at(gid) + 1;
-    current_round_pending_.at(gid) = false;
+    SetPending(gid, false);
   }
 
   void SetGraphCurrentRoundFinish(common::GraphID gid) {
-    current_round_pending_.at(gid) = false;
+    SetPending(gid, false);
   }
 
   void SetGraphState(common::GraphID gid, StorageStateType type) {
@@ -119,8 +122,18 @@ struct GraphState {
     for (size_t i = 0; i < num_subgraphs_; i++) {
       current_round_pending_.at(i) = true;
     }
+    pending_.Fill();
   }
 
+  // The first graph pending in the current round from `gid` on, or
+  // INVALID_GRAPH_ID if there is none.
+  common::GraphID GetNextPending(common::GraphID gid = 0) const {
+    auto next = pending_.FindNext(gid);
+    return next < num_subgraphs_ ? next : INVALID_GRAPH_ID;
+  }
+
+  size_t GetNumPending() const { return pending_.Count(); }
+
   // graph handlers
   data_structures::Serialized* GetSubgraphSerialized(common::GraphID gid) {
     return serialized_.at(gid).get();
@@ -173,7 +186,8 @@ struct GraphState {
   std::vector<int> subgraph_round_;
   std::vector<StorageStateType> subgraph_storage_state_;
 
-  // label for if current round graph is executed
+  // label for if current round graph is executed, set through SetPending to
+  // keep pending_ in sync.
   std::vector<bool> current_round_pending_;
   // label for if next round graph is executed
   std::vector<bool> next_round_pending_;
@@ -190,6 +204,18 @@ struct GraphState {
   std::vector<bool> is_loaded_;
 
  private:
+  void SetPending(common::GraphID gid, bool pending) {
+    current_round_pending_.at(gid) = pending;
+    if (pending) {
+      pending_.Insert(gid);
+    } else {
+      pending_.Erase(gid);
+    }
+  }
+
+  // The graphs of current_round_pending_, to find the next one without a
+  // scan.
+  common::ReadySet pending_;
   std::vector<std::unique_ptr<data_structures::Serialized>> serialized_;
   std::vector<std::unique_ptr<data_structures::Serializable>> graphs_;
 };
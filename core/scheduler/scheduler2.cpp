@@ -326,19 +326,18 @@ void Scheduler2::SetAppRuntimeGraph(common::GraphID gid) {}
 
 // TODO: Add logic to decide which graph is executed first.
 common::GraphID Scheduler2::GetNextExecuteGraph() const {
+  const GraphState* state = &graph_state_;
+  GraphID num_graphs = metadata_->num_blocks;
   if (mode_ != common::Normal) {
-    for (GraphID gid = 0; gid < static_state_->num_subgraphs_; gid++) {
-      if (static_state_->current_round_pending_.at(gid) &&
-          static_state_->subgraph_round_.at(gid) == current_round_) {
-        return gid;
-      }
-    }
-  } else {
-    for (GraphID gid = 0; gid < metadata_->num_blocks; gid++) {
-      if (graph_state_.current_round_pending_.at(gid) &&
-          graph_state_.subgraph_round_.at(gid) == current_round_) {
-        return gid;
-      }
+    state = static_state_;
+    num_graphs = static_state_->num_subgraphs_;
+  }
+  // The pending graphs are those of the current round, so this takes the
+  // first one.
+  for (auto gid = state->GetNextPending(); gid < num_graphs;
+       gid = state->GetNextPending(gid + 1)) {
+    if (state->subgraph_round_.at(gid) == current_round_) {
+      return gid;
     }
   }
   return INVALID_GRAPH_ID;
@@ -376,39 +375,14 @@ common::GraphID Scheduler2::GetNextExecuteGraph() const {
 // }
 
 size_t Scheduler2::GetLeftPendingGraphNums() const {
-  size_t res = 0;
   if (mode_ != common::Normal) {
-    for (GraphID gid = 0; gid < static_state_->num_subgraphs_; gid++) {
-      if (static_state_->current_round_pending_.at(gid)) {
-        res++;
-      }
-    }
-  } else {
-    for (GraphID gid = 0; gid < graph_metadata_info_.get_num_subgraphs();
-         gid++) {
-      if (graph_state_.current_round_pending_.at(gid)) {
-        res++;
-      }
-    }
+    return static_state_->GetNumPending();
   }
-  return res;
+  return graph_state_.GetNumPending();
 }
 
 bool Scheduler2::IsCurrentRoundFinish() const {
-  if (mode_ != common::Normal) {
-    for (GraphID i = 0; i < static_state_->num_subgraphs_; i++) {
-      if (static_state_->current_round_pending_.at(i)) {
-        return false;
-      }
-    }
-  } else {
-    for (GraphID i = 0; i < graph_metadata_info_.get_num_subgraphs(); i++) {
-      if (graph_state_.current_round_pending_.at(i)) {
-        return false;
-      }
-    }
-  }
-  return true;
+  return GetLeftPendingGraphNums() == 0;
 }
 
 bool Scheduler2::IsSystemStop() const { return app_->IsActive() == 0; }
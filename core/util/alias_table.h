@@ -0,0 +1,76 @@
+#ifndef CORE_UTIL_ALIAS_TABLE_H_
+#define CORE_UTIL_ALIAS_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "util/random.h"
+
+namespace sics::graph::core::util {
+
+// @DESCRIPTION
+//
+//  Alias tables (Vose) for sampling an index of a list of weights in O(1).
+//  A table of `size` entries is two arrays, `prob` and `alias`, written in
+//  place, e.g. at the offsets of the out edges of a vertex in arrays over all
+//  the edges of a block. Index i is sampled as i with probability prob[i],
+//  and as alias[i] otherwise.
+//
+//  Build in O(size). The scratch buffers only grow, so an instance kept per
+//  thread allocates nothing once warm.
+class AliasTableBuilder {
+ public:
+  template <typename Weight>
+  void Build(const Weight* weights, size_t size, float* prob,
+             uint32_t* alias) {
+    if (size == 0) return;
+    double sum = 0;
+    for (size_t i = 0; i < size; i++) sum += weights[i];
+    scaled_.resize(size);
+    small_.clear();
+    large_.clear();
+    for (size_t i = 0; i < size; i++) {
+      // All weights zero: sample uniformly.
+      scaled_[i] = sum > 0 ? weights[i] * size / sum : 1.0;
+      (scaled_[i] < 1.0 ? small_ : large_).push_back(i);
+    }
+    while (!small_.empty() && !large_.empty()) {
+      auto s = small_.back();
+      auto l = large_.back();
+      small_.pop_back();
+      prob[s] = scaled_[s];
+      alias[s] = l;
+      scaled_[l] -= 1.0 - scaled_[s];
+      if (scaled_[l] < 1.0) {
+        large_.pop_back();
+        small_.push_back(l);
+      }
+    }
+    // Left overs are 1 up to rounding.
+    for (auto i : large_) {
+      prob[i] = 1;
+      alias[i] = i;
+    }
+    for (auto i : small_) {
+      prob[i] = 1;
+      alias[i] = i;
+    }
+  }
+
+ private:
+  std::vector<double> scaled_;
+  std::vector<uint32_t> small_;
+  std::vector<uint32_t> large_;
+};
+
+// Sample an index of the table of `size` > 0 entries.
+inline uint32_t SampleAlias(const float* prob, const uint32_t* alias,
+                            uint32_t size, Xoshiro256* rng) {
+  auto i = rng->Uniform(size);
+  return rng->NextDouble() < prob[i] ? i : alias[i];
+}
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_ALIAS_TABLE_H_
@@ -0,0 +1,50 @@
+#include "alias_table.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing alias tables.
+class AliasTableTest : public ::testing::Test {
+ protected:
+  AliasTableTest() = default;
+
+  // Sample the table of `weights` and check the frequencies.
+  template <typename Weight>
+  void ExpectDistribution(const std::vector<Weight>& weights) {
+    std::vector<float> prob(weights.size());
+    std::vector<uint32_t> alias(weights.size());
+    builder_.Build(weights.data(), weights.size(), prob.data(), alias.data());
+    double sum = 0;
+    for (auto weight : weights) sum += weight;
+    std::vector<uint32_t> counts(weights.size(), 0);
+    const uint32_t kSamples = 200000;
+    Xoshiro256 rng(3);
+    for (uint32_t i = 0; i < kSamples; i++) {
+      counts[SampleAlias(prob.data(), alias.data(), weights.size(), &rng)]++;
+    }
+    for (size_t i = 0; i < weights.size(); i++) {
+      double expected = sum > 0 ? weights[i] / sum : 1.0 / weights.size();
+      EXPECT_NEAR((double)counts[i] / kSamples, expected, 0.01);
+    }
+  }
+
+  AliasTableBuilder builder_;
+};
+
+TEST_F(AliasTableTest, SamplesByWeight) {
+  ExpectDistribution(std::vector<uint32_t>{1});
+  ExpectDistribution(std::vector<uint32_t>{1, 2, 3, 4});
+  ExpectDistribution(std::vector<uint32_t>{100, 0, 1, 0, 7});
+  ExpectDistribution(std::vector<float>{0.5, 0.25, 0.125, 0.125});
+}
+
+TEST_F(AliasTableTest, ZeroWeightsAreUniform) {
+  ExpectDistribution(std::vector<uint32_t>{0, 0, 0});
+}
+
+}  // namespace sics::graph::core::util
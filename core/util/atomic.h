@@ -1,12 +1,31 @@
 #ifndef CORE_UTIL_ATOMIC_H_
 #define CORE_UTIL_ATOMIC_H_
 
-#include <cassert>
-#include <cstdlib>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
 
 namespace sics::graph::core::util {
 namespace atomic {
 
+// @DESCRIPTION
+//
+//  All helpers below operate on plain (non-atomic) memory through
+//  `std::atomic_ref`, so vertex data arrays allocated with `new[]` can be
+//  updated concurrently without changing their type.
+//
+//  Updates use relaxed memory ordering: the values they produce are only
+//  consumed after the task package is joined (`TaskRunner::SubmitSync`), which
+//  already establishes the happens-before edge. `CAS` keeps sequentially
+//  consistent ordering since callers may use it to publish other data.
+template <class ET>
+using AtomicRef = std::atomic_ref<ET>;
+
+// Whether `ET` can be updated by the helpers in this file without falling back
+// to a lock. 1, 2, 4 and 8 byte integers and floats are supported.
+template <class ET>
+inline constexpr bool kIsLockFree = std::atomic_ref<ET>::is_always_lock_free;
+
 // @DESCRIPTION
 //
 //  CAS is an atomic instruction used in multithreading to achieve
@@ -15,58 +34,100 @@ namespace atomic {
 //  location to a new given value.
 template <class ET>
 inline bool CAS(ET* ptr, ET oldv, ET newv) {
-  if (sizeof(ET) == 8) {
-    return __sync_bool_compare_and_swap((long*)ptr, *((long*)&oldv),
-                                        *((long*)&newv));
-  } else if (sizeof(ET) == 4) {
-    return __sync_bool_compare_and_swap((int*)ptr, *((int*)&oldv),
-                                        *((int*)&newv));
-  } else if (sizeof(ET) == 2) {
-    return __sync_bool_compare_and_swap((unsigned short*)ptr,
-                                        *((unsigned short*)&oldv),
-                                        *((unsigned short*)&newv));
-  } else {
-    assert(false);
-  }
+  static_assert(kIsLockFree<ET>, "CAS on a type that is not lock free");
+  return AtomicRef<ET>(*ptr).compare_exchange_strong(oldv, newv);
 }
 
+// Atomically load `*ptr`. Used by the update loops below to re-read the
+// current value without a `volatile` access.
+template <class ET>
+inline ET Load(ET* ptr) {
+  return AtomicRef<ET>(*ptr).load(std::memory_order_relaxed);
+}
+
+// Emulated fetch_min: store `b` into `*a` if it is smaller than the current
+// value. The current value is read first, so updates that cannot win return
+// without issuing a locked instruction.
+// Return true if `*a` is updated by this call.
 template <class ET>
 inline bool WriteMin(ET* a, ET b) {
-  ET c;
-  bool r = 0;
-  do c = *a;
-  while (c > b && !(r = CAS(a, c, b)));
-  return r;
+  AtomicRef<ET> ref(*a);
+  ET c = ref.load(std::memory_order_relaxed);
+  while (b < c) {
+    // On failure `c` is reloaded with the value observed in memory.
+    if (ref.compare_exchange_weak(c, b, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
 }
 
+// Emulated fetch_max, see `WriteMin`.
+// Return true if `*a` is updated by this call.
 template <class ET>
 inline bool WriteMax(ET* a, ET b) {
-  ET c;
-  bool r = 0;
-  do c = *a;
-  while (c < b && !(r = CAS(a, c, b)));
-  return r;
+  AtomicRef<ET> ref(*a);
+  ET c = ref.load(std::memory_order_relaxed);
+  while (c < b) {
+    if (ref.compare_exchange_weak(c, b, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Atomically add `b` to `*a` and return the value held before the addition.
+// Integers map to the hardware fetch-and-add instruction, floating point types
+// use the C++20 `atomic_ref<float>` specialization.
+template <class ET>
+inline ET FetchAdd(ET* a, ET b) {
+  if constexpr (std::is_integral_v<ET> || std::is_floating_point_v<ET>) {
+    return AtomicRef<ET>(*a).fetch_add(b, std::memory_order_relaxed);
+  } else {
+    AtomicRef<ET> ref(*a);
+    ET c = ref.load(std::memory_order_relaxed);
+    while (!ref.compare_exchange_weak(c, c + b, std::memory_order_relaxed)) {
+    }
+    return c;
+  }
+}
+
+// Atomically subtract `b` from `*a` and return the value held before.
+template <class ET>
+inline ET FetchSub(ET* a, ET b) {
+  if constexpr (std::is_integral_v<ET> || std::is_floating_point_v<ET>) {
+    return AtomicRef<ET>(*a).fetch_sub(b, std::memory_order_relaxed);
+  } else {
+    AtomicRef<ET> ref(*a);
+    ET c = ref.load(std::memory_order_relaxed);
+    while (!ref.compare_exchange_weak(c, c - b, std::memory_order_relaxed)) {
+    }
+    return c;
+  }
+}
+
+// Emulated fetch_or for integers: set the bits of `b` in `*a`. Like
+// `WriteMin`, a write that sets no new bit issues no locked instruction.
+// Return the bits set by this call.
+template <class ET>
+inline ET WriteOr(ET* a, ET b) {
+  static_assert(std::is_integral_v<ET>, "WriteOr needs an integer type");
+  AtomicRef<ET> ref(*a);
+  if ((ref.load(std::memory_order_relaxed) & b) == b) return 0;
+  return ~ref.fetch_or(b, std::memory_order_relaxed) & b;
 }
 
 template <class ET>
 inline void WriteAdd(ET* a, ET b) {
-  volatile ET newV, oldV;
-  do {
-    oldV = *a;
-    newV = oldV + b;
-  } while (!CAS(a, oldV, newV));
+  FetchAdd(a, b);
 }
 
 template <class ET>
 inline void WriteSub(ET* a, ET b) {
-  volatile ET newV, oldV;
-  do {
-    oldV = *a;
-    newV = oldV - b;
-  } while (!CAS(a, oldV, newV));
+  FetchSub(a, b);
 }
 
 }  // namespace atomic
 }  // namespace sics::graph::core::util
 
-#endif  // CORE_UTIL_ATOMIC_H_
\ No newline at end of file
+#endif  // CORE_UTIL_ATOMIC_H_
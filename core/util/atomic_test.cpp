@@ -0,0 +1,119 @@
+#include "atomic.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace sics::graph::core::util::atomic {
+
+// The fixture for testing atomic helpers.
+class AtomicTest : public ::testing::Test {
+ protected:
+  AtomicTest() {
+    // Suppress death test warnings.
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  }
+
+  // Run `func(thread_id)` on `kNumThreads` threads and join them.
+  template <typename Func>
+  void RunConcurrently(Func func) {
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kNumThreads; i++) {
+      threads.emplace_back([&func, i]() { func(i); });
+    }
+    for (auto& t : threads) t.join();
+  }
+
+  static constexpr uint32_t kNumThreads = 8;
+  static constexpr uint32_t kNumIterations = 10000;
+};
+
+TEST_F(AtomicTest, CASSupportsAllWidths) {
+  uint16_t a16 = 1;
+  uint32_t a32 = 1;
+  uint64_t a64 = 1;
+  float af = 1.0;
+  EXPECT_TRUE(CAS(&a16, uint16_t(1), uint16_t(2)));
+  EXPECT_FALSE(CAS(&a16, uint16_t(1), uint16_t(3)));
+  EXPECT_TRUE(CAS(&a32, uint32_t(1), uint32_t(2)));
+  EXPECT_TRUE(CAS(&a64, uint64_t(1), uint64_t(1) << 40));
+  EXPECT_TRUE(CAS(&af, 1.0f, 2.5f));
+  EXPECT_EQ(a16, 2);
+  EXPECT_EQ(a32, 2);
+  EXPECT_EQ(a64, uint64_t(1) << 40);
+  EXPECT_EQ(af, 2.5f);
+}
+
+TEST_F(AtomicTest, WriteMinReturnsTrueOnlyOnUpdate) {
+  uint32_t a = 10;
+  EXPECT_FALSE(WriteMin(&a, uint32_t(11)));
+  EXPECT_FALSE(WriteMin(&a, uint32_t(10)));
+  EXPECT_TRUE(WriteMin(&a, uint32_t(3)));
+  EXPECT_EQ(a, 3);
+
+  float f = 1.0;
+  EXPECT_TRUE(WriteMax(&f, 2.0f));
+  EXPECT_FALSE(WriteMax(&f, 1.5f));
+  EXPECT_EQ(f, 2.0f);
+}
+
+TEST_F(AtomicTest, ConcurrentWriteMinKeepsMinimum) {
+  uint32_t a = std::numeric_limits<uint32_t>::max();
+  uint16_t b = std::numeric_limits<uint16_t>::max();
+  RunConcurrently([&](uint32_t tid) {
+    for (uint32_t i = 0; i < kNumIterations; i++) {
+      WriteMin(&a, kNumIterations * tid + i + 7);
+      WriteMin(&b, uint16_t(tid + 7));
+    }
+  });
+  EXPECT_EQ(a, 7);
+  EXPECT_EQ(b, 7);
+}
+
+TEST_F(AtomicTest, ConcurrentWriteOrSetsEveryBitOnce) {
+  uint64_t a = 0;
+  uint64_t set_bits[kNumThreads] = {};
+  RunConcurrently([&](uint32_t tid) {
+    for (uint32_t i = 0; i < 64; i++) {
+      set_bits[tid] |= WriteOr(&a, uint64_t(1) << ((i + tid) % 64));
+    }
+  });
+  EXPECT_EQ(a, std::numeric_limits<uint64_t>::max());
+  uint64_t all = 0;
+  for (uint32_t i = 0; i < kNumThreads; i++) {
+    EXPECT_EQ(all & set_bits[i], 0);
+    all |= set_bits[i];
+  }
+  EXPECT_EQ(all, a);
+  EXPECT_EQ(WriteOr(&a, uint64_t(5)), 0);
+}
+
+TEST_F(AtomicTest, ConcurrentWriteAddIsExact) {
+  int count = 0;
+  uint64_t count64 = 0;
+  float sum = 0;
+  RunConcurrently([&](uint32_t tid) {
+    for (uint32_t i = 0; i < kNumIterations; i++) {
+      WriteAdd(&count, 1);
+      WriteAdd(&count64, uint64_t(2));
+      // Small integers are exactly representable, so the float sum is exact.
+      WriteAdd(&sum, 1.0f);
+    }
+  });
+  EXPECT_EQ(count, kNumThreads * kNumIterations);
+  EXPECT_EQ(count64, 2ul * kNumThreads * kNumIterations);
+  EXPECT_EQ(sum, float(kNumThreads * kNumIterations));
+
+  RunConcurrently([&](uint32_t tid) {
+    for (uint32_t i = 0; i < kNumIterations; i++) {
+      WriteSub(&count64, uint64_t(2));
+    }
+  });
+  EXPECT_EQ(count64, 0);
+}
+
+}  // namespace sics::graph::core::util::atomic
@@ -0,0 +1,89 @@
+#ifndef CORE_UTIL_INTERSECTION_H_
+#define CORE_UTIL_INTERSECTION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sics::graph::core::util {
+
+// Lists longer than this many times the other are intersected by binary
+// search of the short list in the long one instead of a merge.
+inline constexpr size_t kGallopRatio = 32;
+
+// @DESCRIPTION
+//
+//  Intersect the sorted lists a[0, size_a) and b[0, size_b) of distinct
+//  values, calling `func(value)` for every common value in increasing order.
+//  Returns the number of common values.
+//
+//  The merge compares blocks of 4 values of each list at once, all 16 pairs
+//  with 4 rotations of one block, and advances the block with the smaller
+//  last value. Without SSE2 it is a plain merge.
+template <typename Func>
+size_t IntersectSorted(const uint32_t* a, size_t size_a, const uint32_t* b,
+                       size_t size_b, Func&& func) {
+  if (size_a > size_b) return IntersectSorted(b, size_b, a, size_a, func);
+  size_t count = 0;
+  if (size_a == 0) return count;
+
+  if (size_a * kGallopRatio < size_b) {
+    const uint32_t* first = b;
+    const uint32_t* last = b + size_b;
+    for (size_t i = 0; i < size_a && first != last; i++) {
+      first = std::lower_bound(first, last, a[i]);
+      if (first != last && *first == a[i]) {
+        func(a[i]);
+        count++;
+      }
+    }
+    return count;
+  }
+
+  size_t i = 0, j = 0;
+#if defined(__SSE2__)
+  size_t end_a = size_a & ~(size_t)3, end_b = size_b & ~(size_t)3;
+  while (i < end_a && j < end_b) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+    __m128i eq0 = _mm_cmpeq_epi32(va, vb);
+    __m128i eq1 =
+        _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+    __m128i eq2 =
+        _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128i eq3 =
+        _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+    __m128i eq = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+    while (mask != 0) {
+      func(a[i + __builtin_ctz(mask)]);
+      count++;
+      mask &= mask - 1;
+    }
+    uint32_t last_a = a[i + 3], last_b = b[j + 3];
+    if (last_a <= last_b) i += 4;
+    if (last_b <= last_a) j += 4;
+  }
+#endif
+  while (i < size_a && j < size_b) {
+    if (a[i] < b[j]) {
+      i++;
+    } else if (a[i] > b[j]) {
+      j++;
+    } else {
+      func(a[i]);
+      count++;
+      i++;
+      j++;
+    }
+  }
+  return count;
+}
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_INTERSECTION_H_
@@ -0,0 +1,63 @@
+#include "intersection.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing sorted list intersection.
+class IntersectionTest : public ::testing::Test {
+ protected:
+  IntersectionTest() = default;
+
+  // `size` distinct sorted values in [0, range).
+  std::vector<uint32_t> RandomList(size_t size, uint32_t range) {
+    std::vector<uint32_t> values(range);
+    for (uint32_t i = 0; i < range; i++) values[i] = i;
+    std::shuffle(values.begin(), values.end(), rng_);
+    values.resize(size);
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+
+  void ExpectIntersection(const std::vector<uint32_t>& a,
+                          const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> expected, result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    auto count =
+        IntersectSorted(a.data(), a.size(), b.data(), b.size(),
+                        [&result](uint32_t v) { result.push_back(v); });
+    EXPECT_EQ(count, expected.size());
+    EXPECT_EQ(result, expected);
+  }
+
+  std::mt19937 rng_{1};
+};
+
+TEST_F(IntersectionTest, EmptyAndDisjoint) {
+  ExpectIntersection({}, {1, 2, 3});
+  ExpectIntersection({1, 2, 3}, {});
+  ExpectIntersection({0, 2, 4, 6, 8, 10, 12, 14}, {1, 3, 5, 7, 9, 11, 13, 15});
+}
+
+TEST_F(IntersectionTest, MergeOfSimilarSizes) {
+  for (size_t size = 1; size < 64; size++) {
+    ExpectIntersection(RandomList(size, 128), RandomList(size + size / 3, 128));
+  }
+}
+
+TEST_F(IntersectionTest, GallopOfSkewedSizes) {
+  ExpectIntersection(RandomList(3, 10000), RandomList(5000, 10000));
+  auto large = RandomList(4000, 10000);
+  std::vector<uint32_t> small = {large[0], large[1000], large[3999]};
+  ExpectIntersection(small, large);
+}
+
+}  // namespace sics::graph::core::util
@@ -0,0 +1,100 @@
+#ifndef CORE_UTIL_LABEL_HISTOGRAM_H_
+#define CORE_UTIL_LABEL_HISTOGRAM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// @DESCRIPTION
+//
+//  Most frequent label of a list of labels, e.g. of the neighbors of a
+//  vertex, with ties broken by the smallest label. Short lists are sorted and
+//  scanned, longer ones counted in an open addressing table. The scratch
+//  buffers only grow, so an instance kept per thread allocates nothing once
+//  warm:
+//
+//    thread_local util::LabelHistogram histogram;
+//    auto label = histogram.MostFrequent(degree, [&](size_t i) { ... });
+class LabelHistogram {
+ public:
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  // Lists up to this long are sorted instead of hashed.
+  static constexpr size_t kSortThreshold = 64;
+
+  // The most frequent of the labels get_label(0), ..., get_label(size - 1),
+  // none of which is kEmpty. kEmpty for an empty list.
+  template <typename GetLabel>
+  uint32_t MostFrequent(size_t size, GetLabel&& get_label) {
+    if (size == 0) return kEmpty;
+    if (size <= kSortThreshold) return SortAndScan(size, get_label);
+    return Count(size, get_label);
+  }
+
+ private:
+  template <typename GetLabel>
+  uint32_t SortAndScan(size_t size, GetLabel& get_label) {
+    if (sorted_.size() < size) sorted_.resize(size);
+    for (size_t i = 0; i < size; i++) sorted_[i] = get_label(i);
+    std::sort(sorted_.begin(), sorted_.begin() + size);
+    uint32_t best = sorted_[0];
+    size_t best_count = 0;
+    for (size_t i = 0; i < size;) {
+      size_t j = i + 1;
+      while (j < size && sorted_[j] == sorted_[i]) j++;
+      // Runs are in increasing order, so the first of a count wins ties.
+      if (j - i > best_count) {
+        best = sorted_[i];
+        best_count = j - i;
+      }
+      i = j;
+    }
+    return best;
+  }
+
+  template <typename GetLabel>
+  uint32_t Count(size_t size, GetLabel& get_label) {
+    // A power of two of at least twice the labels, so probes stay short.
+    size_t capacity = 2;
+    int bits = 1;
+    while (capacity < 2 * size) {
+      capacity <<= 1;
+      bits++;
+    }
+    if (keys_.size() < capacity) {
+      keys_.resize(capacity, kEmpty);
+      counts_.resize(capacity, 0);
+    }
+    size_t mask = capacity - 1;
+    uint32_t best = kEmpty, best_count = 0;
+    for (size_t i = 0; i < size; i++) {
+      auto label = get_label(i);
+      // Fibonacci hashing, on the high bits of the product.
+      size_t slot = (uint32_t)(label * 0x9E3779B1u) >> (32 - bits);
+      while (keys_[slot] != kEmpty && keys_[slot] != label) {
+        slot = (slot + 1) & mask;
+      }
+      keys_[slot] = label;
+      auto count = ++counts_[slot];
+      if (count > best_count || (count == best_count && label < best)) {
+        best = label;
+        best_count = count;
+      }
+    }
+    std::fill(keys_.begin(), keys_.begin() + capacity, kEmpty);
+    std::fill(counts_.begin(), counts_.begin() + capacity, 0);
+    return best;
+  }
+
+ private:
+  std::vector<uint32_t> sorted_;
+  std::vector<uint32_t> keys_;
+  std::vector<uint32_t> counts_;
+};
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_LABEL_HISTOGRAM_H_
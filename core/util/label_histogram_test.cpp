@@ -0,0 +1,60 @@
+#include "label_histogram.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing the most frequent label.
+class LabelHistogramTest : public ::testing::Test {
+ protected:
+  LabelHistogramTest() = default;
+
+  uint32_t MostFrequent(const std::vector<uint32_t>& labels) {
+    return histogram_.MostFrequent(labels.size(),
+                                   [&labels](size_t i) { return labels[i]; });
+  }
+
+  // The smallest of the most frequent labels.
+  static uint32_t Expected(const std::vector<uint32_t>& labels) {
+    std::map<uint32_t, size_t> counts;
+    for (auto label : labels) counts[label]++;
+    uint32_t best = LabelHistogram::kEmpty;
+    size_t best_count = 0;
+    for (auto& [label, count] : counts) {
+      if (count > best_count) {
+        best = label;
+        best_count = count;
+      }
+    }
+    return best;
+  }
+
+  LabelHistogram histogram_;
+};
+
+TEST_F(LabelHistogramTest, TiesGoToTheSmallestLabel) {
+  EXPECT_EQ(MostFrequent({}), LabelHistogram::kEmpty);
+  EXPECT_EQ(MostFrequent({7}), 7);
+  EXPECT_EQ(MostFrequent({9, 3, 9, 3, 5}), 3);
+  EXPECT_EQ(MostFrequent({4, 2, 4}), 4);
+}
+
+TEST_F(LabelHistogramTest, SortedAndHashedAgree) {
+  std::mt19937 rng(1);
+  // Sizes on both sides of kSortThreshold, reusing the scratch buffers.
+  for (size_t size : {10, 64, 65, 1000, 30, 5000, 100}) {
+    for (uint32_t range : {4u, 100u, 1u << 20}) {
+      std::vector<uint32_t> labels(size);
+      for (auto& label : labels) label = rng() % range * 1024;
+      EXPECT_EQ(MostFrequent(labels), Expected(labels));
+    }
+  }
+}
+
+}  // namespace sics::graph::core::util
@@ -0,0 +1,271 @@
+#include "util/profiler.h"
+
+#include <semaphore.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "util/logging.h"
+
+namespace sics::graph::core::util {
+
+namespace {
+
+enum EventType : uint32_t {
+  kSpan = 1,
+  kCounter,
+};
+
+sem_t dump_sem;
+
+void HandleDumpSignal(int) { sem_post(&dump_sem); }
+
+}  // namespace
+
+struct Profiler::Event {
+  const char* name;
+  uint64_t ts_ns;
+  // Duration of a span, or the increment of a counter.
+  int64_t value;
+  int64_t arg;
+  EventType type;
+};
+
+// Events of one thread. Only the owner thread appends, and it publishes each
+// event by a release store of `size`, so readers that acquire `size` can read
+// every event before it without a lock. Chunks are never moved or freed, as
+// a dump may read them at any time.
+struct Profiler::ThreadBuffer {
+  static constexpr size_t kChunkSize = 1 << 14;
+  static constexpr size_t kMaxChunks = 1 << 10;
+
+  explicit ThreadBuffer(uint32_t id) : tid(id) {
+    for (auto& chunk : chunks) chunk.store(nullptr, std::memory_order_relaxed);
+  }
+
+  ~ThreadBuffer() {
+    for (auto& chunk : chunks) delete[] chunk.load(std::memory_order_relaxed);
+  }
+
+  void Append(const Event& event) {
+    size_t n = size.load(std::memory_order_relaxed);
+    size_t c = n / kChunkSize;
+    if (c >= kMaxChunks) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    Event* chunk = chunks[c].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+      chunk = new Event[kChunkSize];
+      chunks[c].store(chunk, std::memory_order_relaxed);
+    }
+    chunk[n % kChunkSize] = event;
+    size.store(n + 1, std::memory_order_release);
+  }
+
+  template <typename Func>
+  void ForEach(Func&& func) const {
+    size_t n = size.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; i++) {
+      func(chunks[i / kChunkSize].load(std::memory_order_relaxed)
+               [i % kChunkSize]);
+    }
+  }
+
+  const uint32_t tid;
+  std::atomic<size_t> size = 0;
+  std::atomic<uint64_t> dropped = 0;
+  std::atomic<Event*> chunks[kMaxChunks];
+};
+
+Profiler* Profiler::Get() {
+  static Profiler* instance = new Profiler();
+  return instance;
+}
+
+uint64_t Profiler::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Profiler::Enable(const std::string& path, const std::string& format) {
+  std::lock_guard<std::mutex> lck(mtx_);
+  path_ = path;
+  if (format == "json") {
+    format_ = kJSON;
+  } else if (format == "chrome") {
+    format_ = kChromeTrace;
+  } else {
+    LOGF_FATAL("Unknown profile format: {}, expected json or chrome", format);
+  }
+  if (!signal_installed_) {
+    signal_installed_ = true;
+    WatchSignal();
+    std::atexit([]() { Profiler::Get()->Dump(); });
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+  LOGF_INFO("Profiling into {} ({}), send SIGUSR1 to dump", path, format);
+}
+
+// A signal handler can not write files, so it only wakes up a detached
+// thread that does the dump.
+void Profiler::WatchSignal() {
+  sem_init(&dump_sem, 0, 0);
+  std::thread([this]() {
+    while (true) {
+      if (sem_wait(&dump_sem) != 0) continue;
+      Dump();
+    }
+  }).detach();
+  struct sigaction action = {};
+  action.sa_handler = HandleDumpSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &action, nullptr);
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lck(mtx_);
+    buffers_.push_back(std::make_unique<ThreadBuffer>(buffers_.size()));
+    buffer = buffers_.back().get();
+  }
+  return buffer;
+}
+
+void Profiler::Append(const Event& event) { GetThreadBuffer()->Append(event); }
+
+void Profiler::RecordSpan(const char* name, uint64_t begin_ns, uint64_t end_ns,
+                          int64_t arg) {
+  Append({name, begin_ns, (int64_t)(end_ns - begin_ns), arg, kSpan});
+}
+
+void Profiler::RecordCounter(const char* name, int64_t value) {
+  Append({name, NowNs(), value, -1, kCounter});
+}
+
+void Profiler::Dump() {
+  std::string path;
+  Format format;
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (path_.empty()) return;
+    path = path_;
+    format = format_;
+  }
+  DumpTo(path, format);
+}
+
+void Profiler::DumpTo(const std::string& path, Format format) {
+  // Snapshot the buffer list, the buffers themselves are read lock free.
+  std::vector<ThreadBuffer*> buffers;
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    for (auto& buffer : buffers_) buffers.push_back(buffer.get());
+  }
+  uint64_t dropped = 0;
+  for (auto buffer : buffers) {
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+  }
+
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) {
+    LOGF_ERROR("Can not open profile output {}", path);
+    return;
+  }
+
+  if (format == kJSON) {
+    struct Stat {
+      uint64_t count = 0;
+      int64_t total_ns = 0;
+      int64_t min_ns = INT64_MAX;
+      int64_t max_ns = 0;
+    };
+    std::map<std::string, Stat> spans;
+    std::map<std::string, int64_t> counters;
+    for (auto buffer : buffers) {
+      buffer->ForEach([&](const Event& event) {
+        if (event.type == kCounter) {
+          counters[event.name] += event.value;
+          return;
+        }
+        auto& stat = spans[event.name];
+        stat.count++;
+        stat.total_ns += event.value;
+        stat.min_ns = std::min(stat.min_ns, event.value);
+        stat.max_ns = std::max(stat.max_ns, event.value);
+      });
+    }
+    out << "{\n  \"phases\": {";
+    bool first = true;
+    for (auto& [name, stat] : spans) {
+      out << (first ? "\n" : ",\n") << "    \"" << name << "\": {\"count\": "
+          << stat.count << ", \"total_ms\": " << stat.total_ns / 1e6
+          << ", \"avg_ms\": " << stat.total_ns / 1e6 / stat.count
+          << ", \"min_ms\": " << stat.min_ns / 1e6
+          << ", \"max_ms\": " << stat.max_ns / 1e6 << "}";
+      first = false;
+    }
+    out << "\n  },\n  \"counters\": {";
+    first = true;
+    for (auto& [name, value] : counters) {
+      out << (first ? "\n" : ",\n") << "    \"" << name << "\": " << value;
+      first = false;
+    }
+    out << "\n  },\n  \"threads\": " << buffers.size()
+        << ",\n  \"dropped_events\": " << dropped << "\n}\n";
+    return;
+  }
+
+  // Chrome trace: complete events for spans, and counter events carrying the
+  // running sum of each counter.
+  uint64_t base_ns = UINT64_MAX;
+  std::vector<Event> counter_events;
+  for (auto buffer : buffers) {
+    buffer->ForEach([&](const Event& event) {
+      base_ns = std::min(base_ns, event.ts_ns);
+      if (event.type == kCounter) counter_events.push_back(event);
+    });
+  }
+  out << "{\"traceEvents\": [";
+  bool first = true;
+  // Events recorded after the first pass may start before `base_ns`.
+  auto to_us = [&](uint64_t ns) {
+    return ns < base_ns ? 0.0 : (ns - base_ns) / 1e3;
+  };
+  for (auto buffer : buffers) {
+    buffer->ForEach([&](const Event& event) {
+      if (event.type != kSpan) return;
+      out << (first ? "\n" : ",\n") << "{\"name\": \"" << event.name
+          << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << buffer->tid
+          << ", \"ts\": " << to_us(event.ts_ns)
+          << ", \"dur\": " << event.value / 1e3;
+      if (event.arg >= 0) out << ", \"args\": {\"arg\": " << event.arg << "}";
+      out << "}";
+      first = false;
+    });
+  }
+  std::stable_sort(
+      counter_events.begin(), counter_events.end(),
+      [](const Event& a, const Event& b) { return a.ts_ns < b.ts_ns; });
+  std::map<std::string, int64_t> sums;
+  for (auto& event : counter_events) {
+    auto& sum = sums[event.name];
+    sum += event.value;
+    out << (first ? "\n" : ",\n") << "{\"name\": \"" << event.name
+        << "\", \"ph\": \"C\", \"pid\": 0, \"ts\": " << to_us(event.ts_ns)
+        << ", \"args\": {\"value\": " << sum << "}}";
+    first = false;
+  }
+  out << "\n], \"displayTimeUnit\": \"ms\", "
+      << "\"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+}
+
+}  // namespace sics::graph::core::util
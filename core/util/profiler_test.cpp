@@ -0,0 +1,56 @@
+#include "profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing the per-phase profiler.
+class ProfilerTest : public ::testing::Test {
+ protected:
+  ProfilerTest() = default;
+
+  std::string ReadFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+};
+
+TEST_F(ProfilerTest, DumpsSpansAndCountersOfAllThreads) {
+  auto path = ::testing::TempDir() + "profile.json";
+  Profiler::Get()->Enable(path, "json");
+  ASSERT_TRUE(Profiler::IsEnabled());
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 10; j++) {
+        PROFILE_SCOPE("test.phase");
+        PROFILE_COUNTER("test.counter", 2);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  Profiler::Get()->Dump();
+  auto json = ReadFile(path);
+  EXPECT_NE(json.find("\"test.phase\": {\"count\": 40"), std::string::npos);
+  EXPECT_NE(json.find("\"test.counter\": 80"), std::string::npos);
+  EXPECT_NE(json.find("\"dropped_events\": 0"), std::string::npos);
+
+  auto trace_path = ::testing::TempDir() + "profile_trace.json";
+  Profiler::Get()->DumpTo(trace_path, Profiler::kChromeTrace);
+  auto trace = ReadFile(trace_path);
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"ph\": \"X\""), std::string::npos);
+  EXPECT_NE(trace.find("\"args\": {\"value\": 80}"), std::string::npos);
+}
+
+}  // namespace sics::graph::core::util
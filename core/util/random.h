@@ -0,0 +1,71 @@
+#ifndef CORE_UTIL_RANDOM_H_
+#define CORE_UTIL_RANDOM_H_
+
+#include <cstdint>
+
+namespace sics::graph::core::util {
+
+// splitmix64, used to expand seeds into generator states.
+inline uint64_t SplitMix64(uint64_t* state) {
+  uint64_t x = (*state += 0x9E3779B97F4A7C15ULL);
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// @DESCRIPTION
+//
+//  xoshiro256** pseudo random generator. It is small enough to be created
+//  per task or per walker, so threads never share a generator, unlike
+//  `rand()`. Streams for different keys, e.g. (walk, step), are derived from
+//  the seed, which makes the output independent of the thread schedule:
+//
+//    util::Xoshiro256 rng(seed, walk_id, step);
+//    auto next = edges[rng.Uniform(degree)];
+class Xoshiro256 {
+ public:
+  explicit Xoshiro256(uint64_t seed, uint64_t key0 = 0, uint64_t key1 = 0) {
+    uint64_t state = seed ^ (key0 * 0xD1B54A32D192ED03ULL) ^
+                     (key1 * 0x8CB92BA72F3D8DD7ULL);
+    for (auto& s : s_) s = SplitMix64(&state);
+  }
+
+  uint64_t Next() {
+    uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+    uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = Rotl(s_[3], 45);
+    return result;
+  }
+
+  // Uniform in [0, bound), bound > 0, by Lemire's multiply and shift with
+  // rejection, so without a division in the common case.
+  uint32_t Uniform(uint32_t bound) {
+    uint64_t m = (Next() >> 32) * bound;
+    auto low = (uint32_t)m;
+    if (low < bound) {
+      uint32_t threshold = -bound % bound;
+      while (low < threshold) {
+        m = (Next() >> 32) * bound;
+        low = (uint32_t)m;
+      }
+    }
+    return m >> 32;
+  }
+
+  // Uniform in [0, 1).
+  double NextDouble() { return (Next() >> 11) * 0x1.0p-53; }
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  uint64_t s_[4];
+};
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_RANDOM_H_
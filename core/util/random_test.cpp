@@ -0,0 +1,47 @@
+#include "random.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing the random generator.
+class RandomTest : public ::testing::Test {
+ protected:
+  RandomTest() = default;
+};
+
+TEST_F(RandomTest, StreamsDependOnlyOnSeedAndKeys) {
+  Xoshiro256 a(7, 1, 2), b(7, 1, 2), c(7, 2, 1), d(8, 1, 2);
+  for (int i = 0; i < 100; i++) {
+    auto x = a.Next();
+    EXPECT_EQ(x, b.Next());
+    EXPECT_NE(x, c.Next());
+    EXPECT_NE(x, d.Next());
+  }
+}
+
+TEST_F(RandomTest, UniformIsInRangeAndBalanced) {
+  Xoshiro256 rng(1);
+  EXPECT_EQ(rng.Uniform(1), 0);
+  std::vector<uint32_t> counts(10, 0);
+  const uint32_t kSamples = 100000;
+  for (uint32_t i = 0; i < kSamples; i++) {
+    auto value = rng.Uniform(10);
+    ASSERT_LT(value, 10);
+    counts[value]++;
+  }
+  for (auto count : counts) {
+    EXPECT_NEAR(count, kSamples / 10, kSamples / 100);
+  }
+  for (int i = 0; i < 1000; i++) {
+    auto value = rng.NextDouble();
+    EXPECT_GE(value, 0);
+    EXPECT_LT(value, 1);
+  }
+}
+
+}  // namespace sics::graph::core::util
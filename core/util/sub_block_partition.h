@@ -0,0 +1,101 @@
+#ifndef CORE_UTIL_SUB_BLOCK_PARTITION_H_
+#define CORE_UTIL_SUB_BLOCK_PARTITION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The cost model the partitioners use to size the sub-blocks of a block, i.e.
+// the unit of edges the engine reads and processes as one task.
+//
+// Small sub-blocks pay the overhead of one I/O request and one task each, and
+// big ones leave the thread pool idle while the last of a block run. So a
+// sub-block aims at `target_bytes`, the request size at which the device
+// reaches its bandwidth (compress/block_size_nvme measures it), but shrinks
+// down to `min_bytes` when the block has fewer than parallelism *
+// tasks_per_thread sub-blocks of that size.
+struct SubBlockCostModel {
+  // Zero disables the model, and sub-blocks have the same number of vertices.
+  size_t target_bytes = 0;
+  size_t min_bytes = 1 << 20;
+  uint32_t parallelism = 1;
+  uint32_t tasks_per_thread = 4;
+  // Bytes of one edge in a sub-block file, e.g. twice sizeof(VertexID) with
+  // weights.
+  size_t edge_bytes = sizeof(uint32_t);
+  // A vertex with at least hub_ratio * target edges is a hub, and gets a
+  // sub-block of its own, so that the skew of a few vertices does not make the
+  // sub-blocks around them uneven.
+  double hub_ratio = 0.5;
+
+  bool Enabled() const { return target_bytes != 0; }
+
+  // Edges of a sub-block of a block of `num_edges` edges. Never beyond
+  // UINT32_MAX, as SubBlock::num_edges holds it.
+  uint64_t GetTargetEdges(uint64_t num_edges) const {
+    uint64_t num_tasks = (uint64_t)std::max(parallelism, 1u) *
+                         std::max(tasks_per_thread, 1u);
+    uint64_t bytes = num_edges * edge_bytes / num_tasks;
+    bytes = std::max(bytes, (uint64_t)std::min(min_bytes, target_bytes));
+    bytes = std::min(bytes, (uint64_t)target_bytes);
+    uint64_t edges = std::max(bytes / edge_bytes, (uint64_t)1);
+    return std::min(edges, (uint64_t)UINT32_MAX);
+  }
+};
+
+// @DESCRIPTION
+//
+//  Cut a block of `num_vertices` vertices and `num_edges` edges into
+//  sub-blocks, where `degree(i)` is the out degree of the i-th vertex of the
+//  block. The local vertex bounds of the sub-blocks, from 0 to num_vertices,
+//  are written to `bounds`.
+//
+//  Without a cost model, the block is cut into sub-blocks of the same number
+//  of vertices, at most `max_vertices`, and their size is returned: readers
+//  find the sub-block of a vertex by a division. With one, sub-blocks have at
+//  most `max_vertices` vertices and GetTargetEdges() edges, except hubs which
+//  are alone in theirs, and 0 is returned: readers search the bounds.
+template <typename DegreeFunc>
+uint32_t CutSubBlocks(uint32_t num_vertices, uint64_t num_edges,
+                      uint32_t max_vertices, const SubBlockCostModel& model,
+                      DegreeFunc&& degree, std::vector<uint32_t>* bounds) {
+  bounds->assign(1, 0);
+  if (num_vertices == 0) return 1;
+  max_vertices = std::max(max_vertices, 1u);
+  if (!model.Enabled()) {
+    uint32_t p = ((num_vertices - 1) / max_vertices) + 1;
+    uint32_t size = (num_vertices + p - 1) / p;
+    for (uint32_t v = size; v < num_vertices; v += size) {
+      bounds->push_back(v);
+    }
+    bounds->push_back(num_vertices);
+    return size;
+  }
+
+  uint64_t target = model.GetTargetEdges(num_edges);
+  uint64_t hub = std::max((uint64_t)(target * model.hub_ratio), (uint64_t)1);
+  uint32_t begin = 0;
+  uint64_t edges = 0;
+  bool after_hub = false;
+  for (uint32_t v = 0; v < num_vertices; v++) {
+    uint64_t d = degree(v);
+    bool is_hub = d >= hub;
+    if (v > begin && (is_hub || after_hub || edges + d > target ||
+                      v - begin >= max_vertices)) {
+      bounds->push_back(v);
+      begin = v;
+      edges = 0;
+    }
+    edges += d;
+    after_hub = is_hub;
+  }
+  bounds->push_back(num_vertices);
+  return 0;
+}
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_SUB_BLOCK_PARTITION_H_
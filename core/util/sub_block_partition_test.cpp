@@ -0,0 +1,84 @@
+#include "sub_block_partition.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing the sizing of sub-blocks.
+class SubBlockPartitionTest : public ::testing::Test {
+ protected:
+  SubBlockPartitionTest() = default;
+
+  uint32_t Cut(uint32_t max_vertices, const SubBlockCostModel& model) {
+    uint64_t num_edges = 0;
+    for (auto d : degrees_) num_edges += d;
+    return CutSubBlocks(
+        degrees_.size(), num_edges, max_vertices, model,
+        [this](uint32_t v) { return degrees_[v]; }, &bounds_);
+  }
+
+  uint64_t Edges(size_t i) const {
+    uint64_t sum = 0;
+    for (auto v = bounds_[i]; v < bounds_[i + 1]; v++) sum += degrees_[v];
+    return sum;
+  }
+
+  std::vector<uint32_t> degrees_;
+  std::vector<uint32_t> bounds_;
+};
+
+TEST_F(SubBlockPartitionTest, WithoutModelCutsEqualVertices) {
+  degrees_.assign(10, 1);
+  EXPECT_EQ(Cut(4, SubBlockCostModel()), 4);
+  EXPECT_THAT(bounds_, ::testing::ElementsAre(0, 4, 8, 10));
+}
+
+TEST_F(SubBlockPartitionTest, TargetBytesAndIsolatedHubs) {
+  // 100 vertices of 10 edges, with a hub at 50.
+  degrees_.assign(100, 10);
+  degrees_[50] = 500;
+  SubBlockCostModel model;
+  model.target_bytes = 100 * sizeof(uint32_t);
+  model.min_bytes = 0;
+  EXPECT_EQ(Cut(1000, model), 0);
+  EXPECT_EQ(bounds_.front(), 0);
+  EXPECT_EQ(bounds_.back(), 100);
+  for (size_t i = 0; i + 1 < bounds_.size(); i++) {
+    EXPECT_LT(bounds_[i], bounds_[i + 1]);
+    if (bounds_[i] == 50) {
+      EXPECT_EQ(bounds_[i + 1], 51);
+    } else {
+      EXPECT_LE(Edges(i), 100);
+    }
+  }
+  EXPECT_THAT(bounds_, ::testing::Contains(50));
+  EXPECT_THAT(bounds_, ::testing::Contains(51));
+}
+
+TEST_F(SubBlockPartitionTest, SmallBlocksShrinkForAllThreads) {
+  degrees_.assign(64, 16);
+  SubBlockCostModel model;
+  model.target_bytes = 1 << 20;
+  model.min_bytes = 64 * sizeof(uint32_t);
+  model.parallelism = 2;
+  model.tasks_per_thread = 4;
+  Cut(1000, model);
+  // 1024 edges over 8 tasks, of 128 edges each.
+  EXPECT_EQ(bounds_.size(), 9);
+  for (size_t i = 0; i + 1 < bounds_.size(); i++) {
+    EXPECT_EQ(Edges(i), 128);
+  }
+  // But never below min_bytes.
+  model.parallelism = 8;
+  Cut(1000, model);
+  EXPECT_EQ(bounds_.size(), 17);
+  // Nor above max_vertices.
+  Cut(3, model);
+  EXPECT_EQ(bounds_.size(), 23);
+}
+
+}  // namespace sics::graph::core::util
@@ -0,0 +1,100 @@
+#ifndef CORE_UTIL_TASK_PARTITION_H_
+#define CORE_UTIL_TASK_PARTITION_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// A task over the vertex range [begin, end).
+//
+// A task that covers only a part of the out edges of one high-degree vertex
+// (a hub) has `begin + 1 == end` and processes the edges
+// [edge_begin, edge_end) of vertex `begin`. The chunks of one hub are emitted
+// consecutively, and `chunk_id` / `num_chunks` locate the chunk in the hub.
+struct TaskRange {
+  uint32_t begin = 0;
+  uint32_t end = 0;
+  uint32_t edge_begin = 0;
+  uint32_t edge_end = 0;
+  uint32_t chunk_id = 0;
+  uint32_t num_chunks = 0;
+
+  bool IsHubChunk() const { return num_chunks != 0; }
+};
+
+// @DESCRIPTION
+//
+//  Split the vertex range [begin, end) into about `num_tasks` tasks with an
+//  equal share of work, where the work of a vertex is its out degree plus one.
+//  `offset(v)` returns the prefix-sum edge offset of vertex v, and `degree(v)`
+//  its out degree. Both are only called for v in [begin, end), so a sparse
+//  offset index can be used as long as it is monotone over the range.
+//
+//  Vertices whose degree exceeds both `hub_degree` and the per task share are
+//  split into chunks of that many edges each. `hub_degree == 0` disables the
+//  splitting, which callers need when the function runs on whole vertices.
+//
+//  The tasks are appended to `tasks` in vertex order.
+template <typename OffsetFunc, typename DegreeFunc>
+void SplitByEdges(uint32_t begin, uint32_t end, size_t num_tasks,
+                  uint32_t hub_degree, OffsetFunc&& offset,
+                  DegreeFunc&& degree, std::vector<TaskRange>* tasks) {
+  if (begin >= end) return;
+  uint64_t end_offset = offset(end - 1) + degree(end - 1);
+  auto prefix = [&](uint32_t v) -> uint64_t {
+    return v == end ? end_offset : offset(v);
+  };
+  uint64_t base = offset(begin);
+  uint64_t work = end_offset - base + (end - begin);
+  uint64_t share = (work + num_tasks - 1) / std::max(num_tasks, (size_t)1);
+  if (share < 2) share = 2;
+  uint64_t threshold =
+      hub_degree == 0 ? UINT64_MAX : std::max((uint64_t)hub_degree, share);
+
+  uint32_t cur = begin;
+  uint64_t cur_offset = base;
+  while (cur < end) {
+    uint32_t deg = degree(cur);
+    if (deg > threshold) {
+      uint32_t num_chunks = (deg + threshold - 1) / threshold;
+      for (uint32_t i = 0; i < num_chunks; i++) {
+        TaskRange task;
+        task.begin = cur;
+        task.end = cur + 1;
+        task.edge_begin = i * threshold;
+        task.edge_end = std::min((uint64_t)deg, (i + 1) * threshold);
+        task.chunk_id = i;
+        task.num_chunks = num_chunks;
+        tasks->push_back(task);
+      }
+      cur_offset += deg;
+      cur++;
+      continue;
+    }
+    // Find the smallest `next` whose range [cur, next) reaches the share.
+    // Since the work of a range is monotone in `next`, binary search it.
+    uint32_t lo = cur + 1, hi = end;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (prefix(mid) - cur_offset + (mid - cur) >= share) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    uint32_t next = lo;
+    // A vertex whose work alone reaches the share can only close a range.
+    // Leave it to the next round, so that it gets a task of its own or is
+    // split if it is a hub.
+    if (next - 1 > cur && degree(next - 1) + 1 >= share) next--;
+    tasks->push_back({cur, next});
+    cur_offset = prefix(next);
+    cur = next;
+  }
+}
+
+}  // namespace sics::graph::core::util
+
+#endif  // CORE_UTIL_TASK_PARTITION_H_
@@ -0,0 +1,117 @@
+#include "task_partition.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace sics::graph::core::util {
+
+// The fixture for testing edge balanced task partitioning.
+class TaskPartitionTest : public ::testing::Test {
+ protected:
+  TaskPartitionTest() = default;
+
+  // Build the prefix-sum offsets of `degrees_`.
+  void SetDegrees(std::vector<uint32_t> degrees) {
+    degrees_ = std::move(degrees);
+    offsets_.assign(degrees_.size(), 0);
+    for (size_t i = 1; i < degrees_.size(); i++) {
+      offsets_[i] = offsets_[i - 1] + degrees_[i - 1];
+    }
+  }
+
+  std::vector<TaskRange> Split(size_t num_tasks, uint32_t hub_degree) {
+    std::vector<TaskRange> tasks;
+    SplitByEdges(
+        0, degrees_.size(), num_tasks, hub_degree,
+        [this](uint32_t v) { return offsets_[v]; },
+        [this](uint32_t v) { return degrees_[v]; }, &tasks);
+    return tasks;
+  }
+
+  // Every edge of every vertex is covered exactly once, in order.
+  void ExpectCoverage(const std::vector<TaskRange>& tasks) {
+    uint32_t vertex = 0, edge = 0;
+    for (auto& task : tasks) {
+      EXPECT_EQ(task.begin, vertex);
+      if (task.IsHubChunk()) {
+        EXPECT_EQ(task.end, task.begin + 1);
+        EXPECT_EQ(task.edge_begin, edge);
+        edge = task.edge_end;
+        if (task.chunk_id + 1 == task.num_chunks) {
+          EXPECT_EQ(edge, degrees_[vertex]);
+          vertex++;
+          edge = 0;
+        }
+      } else {
+        EXPECT_LT(task.begin, task.end);
+        vertex = task.end;
+      }
+    }
+    EXPECT_EQ(vertex, degrees_.size());
+  }
+
+  std::vector<uint32_t> degrees_;
+  std::vector<uint64_t> offsets_;
+};
+
+TEST_F(TaskPartitionTest, UniformDegreesGiveEqualRanges) {
+  SetDegrees(std::vector<uint32_t>(100, 3));
+  auto tasks = Split(10, 0);
+  ASSERT_EQ(tasks.size(), 10);
+  for (auto& task : tasks) {
+    EXPECT_FALSE(task.IsHubChunk());
+    EXPECT_EQ(task.end - task.begin, 10);
+  }
+  ExpectCoverage(tasks);
+}
+
+TEST_F(TaskPartitionTest, HeavyVertexGetsItsOwnRange) {
+  std::vector<uint32_t> degrees(64, 1);
+  degrees[5] = 1000;
+  SetDegrees(degrees);
+  auto tasks = Split(4, 0);
+  ExpectCoverage(tasks);
+  bool alone = false;
+  for (auto& task : tasks) {
+    if (task.begin == 5 && task.end == 6) alone = true;
+  }
+  EXPECT_TRUE(alone);
+}
+
+TEST_F(TaskPartitionTest, HubIsSplitIntoEdgeChunks) {
+  std::vector<uint32_t> degrees(64, 1);
+  degrees[0] = 10;
+  degrees[20] = 1000;
+  degrees[63] = 500;
+  SetDegrees(degrees);
+  auto tasks = Split(8, 100);
+  ExpectCoverage(tasks);
+  uint32_t chunks_20 = 0, chunks_63 = 0;
+  for (auto& task : tasks) {
+    if (!task.IsHubChunk()) continue;
+    EXPECT_LE(task.edge_end - task.edge_begin, 250);
+    if (task.begin == 20) chunks_20++;
+    if (task.begin == 63) chunks_63++;
+  }
+  EXPECT_GT(chunks_20, 1);
+  EXPECT_GT(chunks_63, 1);
+}
+
+TEST_F(TaskPartitionTest, SubRangeOfBlock) {
+  SetDegrees({4, 0, 0, 7, 2, 2, 9, 1});
+  std::vector<TaskRange> tasks;
+  SplitByEdges(
+      2, 7, 3, 0, [this](uint32_t v) { return offsets_[v]; },
+      [this](uint32_t v) { return degrees_[v]; }, &tasks);
+  ASSERT_FALSE(tasks.empty());
+  EXPECT_EQ(tasks.front().begin, 2);
+  EXPECT_EQ(tasks.back().end, 7);
+  for (size_t i = 1; i < tasks.size(); i++) {
+    EXPECT_EQ(tasks[i].begin, tasks[i - 1].end);
+  }
+}
+
+}  // namespace sics::graph::core::util
@@ -11,6 +11,7 @@
 #include "core/common/types.h"
 #include "core/data_structures/serializable.h"
 #include "core/util/logging.h"
+#include "core/util/profiler.h"
 #include "nvme/apis/block_api_base.h"
 #include "nvme/common/config.h"
 #include "nvme/components/discharge.h"
@@ -55,6 +56,11 @@ class BlockModel : public BlockModelBase {
       : root_path_(root_path),
         scheduler_(root_path),
         update_store_(scheduler_.GetGraphMetadata()) {
+    auto config = core::common::Configurations::Get();
+    if (!config->profile_path.empty()) {
+      core::util::Profiler::Get()->Enable(config->profile_path,
+                                          config->profile_format);
+    }
     task_package_factor_ =
         core::common::Configurations::Get()->task_package_factor;
     loader_ = std::make_unique<components::Loader<io::PramBlockReader>>(
@@ -106,9 +112,18 @@ class BlockModel : public BlockModelBase {
     LOG_INFO("MapVertex finished");
   }
 
+  // MapVertex over the blocks set in `blocks` only, the others are not read.
+  void MapVertex(std::function<void(VertexID)>* func_vertex,
+                 std::vector<bool> blocks) {
+    scheduler_.SetNextMapBlocks(std::move(blocks));
+    MapVertex(func_vertex);
+  }
+
   void MapVertexWithPrecomputing(FuncVertex* func_vertex) {
     ParallelVertexDo(*func_vertex);
     update_store_.Sync();
+    // Drop the mapped neighbor info until the next pass needs it.
+    neighbor_hop_info_.Release();
     LOG_INFO("MapVertexWithPrecomputing finishes");
   }
 
@@ -133,6 +148,9 @@ class BlockModel : public BlockModelBase {
     LOG_INFO("MapEdgeAndMutate finishes");
   }
 
+  // Delete the edges for which func_edge_del returns true. The edges of a hub
+  // are split between tasks, so func_edge_del runs concurrently on one source
+  // vertex and must not write to it without atomics.
   void MapAndMutateEdgeBool(
       std::function<bool(VertexID, VertexID)>* func_edge_del) {
     ExecuteMessage message;
@@ -212,8 +230,22 @@ class BlockModel : public BlockModelBase {
 
   const VertexID* GetEdges(VertexID id) { return scheduler_.GetEdges(id); }
 
+  // Edges of a vertex of any block in memory, see
+  // `PramScheduler::GetResidentEdges`.
+  const VertexID* GetResidentEdges(VertexID id, VertexDegree* degree) {
+    return scheduler_.GetResidentEdges(id, degree);
+  }
+
   VertexID GetNumVertices() { return scheduler_.GetVertexNumber(); }
 
+  GraphID GetNumBlocks() {
+    return scheduler_.GetGraphMetadata().get_num_subgraphs();
+  }
+
+  const core::data_structures::BlockMetadata& GetBlockMetadata(GraphID bid) {
+    return scheduler_.GetGraphMetadata().GetBlockMetadata(bid);
+  }
+
   VertexID GetMinOneHop(VertexID id) {
     return neighbor_hop_info_.GetMinOneHop(id);
   }
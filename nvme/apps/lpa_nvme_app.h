@@ -0,0 +1,65 @@
+#ifndef GRAPH_SYSTEMS_NVME_APPS_LPA_NVME_APP_H_
+#define GRAPH_SYSTEMS_NVME_APPS_LPA_NVME_APP_H_
+
+#include "core/apis/planar_app_base.h"
+#include "core/util/atomic.h"
+#include "core/util/label_histogram.h"
+#include "nvme/apis/block_api.h"
+#include "nvme/data_structures/graph/pram_block.h"
+
+namespace sics::graph::nvme::apps {
+
+using BlockGraph = data_structures::graph::BlockCSRGraphUInt32;
+
+// Label propagation on blocks: every vertex takes the most frequent label of
+// its neighbors, the smallest one on ties, starting from its own ID. Labels
+// of a MapVertex are read from the previous one, so the propagation is
+// synchronous. Needs a symmetric graph.
+class LpaNvmeApp : public apis::BlockModel<BlockGraph::VertexData> {
+  using VertexID = core::common::VertexID;
+  using VertexDegree = core::common::VertexDegree;
+
+  using FuncVertex = core::common::FuncVertex;
+
+ public:
+  LpaNvmeApp() = default;
+  LpaNvmeApp(const std::string& root_path) : BlockModel(root_path) {
+    max_iter_ = core::common::Configurations::Get()->lpa_iter;
+  }
+  ~LpaNvmeApp() override = default;
+
+  void Update(VertexID id) {
+    auto degree = GetOutDegree(id);
+    if (degree == 0) return;
+    auto edges = GetEdges(id);
+    thread_local core::util::LabelHistogram histogram;
+    auto label = histogram.MostFrequent(
+        degree, [this, edges](size_t i) { return Read(edges[i]); });
+    if (label == Read(id)) return;
+    Write(id, label);
+    core::util::atomic::WriteAdd(&num_changed_, (size_t)1);
+  }
+
+  void Compute() override {
+    LOG_INFO("LpaNvmeApp::Compute begin!");
+    FuncVertex update = [this](VertexID id) { this->Update(id); };
+
+    // Labels start as the vertex IDs, see PramNvmeUpdateStore.
+    for (uint32_t i = 0; i < max_iter_; i++) {
+      num_changed_ = 0;
+      MapVertex(&update);
+      LOGF_INFO("label propagation iteration {}, labels changed: {}", i,
+                num_changed_);
+      if (num_changed_ == 0) break;
+    }
+    LOG_INFO("LpaNvmeApp::Compute end!");
+  }
+
+ private:
+  uint32_t max_iter_ = 10;
+  size_t num_changed_ = 0;
+};
+
+}  // namespace sics::graph::nvme::apps
+
+#endif  // GRAPH_SYSTEMS_NVME_APPS_LPA_NVME_APP_H_
@@ -1,52 +1,138 @@
 #ifndef GRAPH_SYSTEMS_NVME_APPS_RANDOM_WALK_APP_H_
 #define GRAPH_SYSTEMS_NVME_APPS_RANDOM_WALK_APP_H_
 
+#include <fstream>
+#include <vector>
+
 #include "core/apis/planar_app_base.h"
+#include "core/util/random.h"
 #include "nvme/apis/block_api.h"
 #include "nvme/data_structures/graph/pram_block.h"
 
 namespace sics::graph::nvme::apps {
 
 using BlockGraph = data_structures::graph::BlockCSRGraphUInt32;
-using VertexID = core::common::VertexID;
-
-#define WALK_LENGTH 5
-
-struct Data {
-  VertexID next_id[5];
-};
 
+// Random walks on blocks, `walks_per_vertex` from every vertex, one step of
+// all walks per MapVertex. The walks are bucketed by their current vertex
+// between steps, so a vertex moves all of its walks while its block is
+// resident, and a step maps only the blocks holding walks. A walk stops at a
+// vertex without out edges.
+//
+// The positions of all walks after every step, from step 0, are streamed to
+// `walk_output` if set, MAX_VERTEX_ID for the stopped ones. The generator of
+// a step is derived from the seed, the walk and the step, as in the planar
+// RandomWalkAppOp.
 class RandomWalkApp : public apis::BlockModel<BlockGraph::VertexData> {
-  using VertexIndex = core::common::VertexIndex;
-  using EdgeIndex = core::common::EdgeIndex;
   using VertexID = core::common::VertexID;
+  using VertexDegree = core::common::VertexDegree;
+  using GraphID = core::common::GraphID;
 
   using FuncVertex = core::common::FuncVertex;
-  using FuncEdge = core::common::FuncEdge;
-  using FuncEdgeAndMutate = core::common::FuncEdgeAndMutate;
-  using FuncEdgeMutate = core::common::FuncEdgeMutate;
 
  public:
   RandomWalkApp() = default;
   RandomWalkApp(const std::string& root_path) : BlockModel(root_path) {
-    matrix_ = new VertexID[scheduler_.GetVertexNumber() * WALK_LENGTH];
+    auto config = core::common::Configurations::Get();
+    walk_length_ = config->walk;
+    walks_per_vertex_ = config->walks_per_vertex;
+    seed_ = config->walk_seed;
+    if (!config->walk_output.empty()) {
+      output_.open(config->walk_output, std::ios::binary);
+      if (!output_) LOGF_FATAL("Can not open {}", config->walk_output);
+    }
   }
   ~RandomWalkApp() override = default;
 
-  void Init(apps::VertexID id) {}
+  // Move the walks at `id` one step.
+  void Step(VertexID id) {
+    auto begin = walk_offsets_[id], end = walk_offsets_[id + 1];
+    if (begin == end) return;
+    auto degree = GetOutDegree(id);
+    auto edges = GetEdges(id);
+    for (auto i = begin; i < end; i++) {
+      auto walk_id = walk_ids_[i];
+      if (degree == 0) {
+        positions_[walk_id] = MAX_VERTEX_ID;
+        continue;
+      }
+      core::util::Xoshiro256 rng(seed_, walk_id, step_);
+      positions_[walk_id] = edges[rng.Uniform(degree)];
+    }
+  }
 
-  void Sample(VertexID id) {}
+  void Compute() override {
+    LOG_INFO("RandomWalkApp::Compute begin!");
+    FuncVertex step = [this](VertexID id) { this->Step(id); };
 
-  void Walk(VertexID id) {}
+    size_t num_walks = (size_t)GetNumVertices() * walks_per_vertex_;
+    positions_.resize(num_walks);
+    for (size_t i = 0; i < num_walks; i++) {
+      positions_[i] = i / walks_per_vertex_;
+    }
+    WritePositions();
+    for (step_ = 0; step_ < walk_length_; step_++) {
+      auto num_alive = BucketWalks();
+      LOGF_INFO("random walk step {}, walks left: {}", step_, num_alive);
+      if (num_alive == 0) break;
+      MapVertex(&step, GetBlocksWithWalks());
+      WritePositions();
+    }
+    if (output_.is_open()) output_.close();
+    LOG_INFO("RandomWalkApp::Compute end!");
+  }
 
  private:
-  VertexID* GetRoad(VertexID id) {
-    uint64_t index = (uint64_t)(id)*WALK_LENGTH;
-    return matrix_ + index;
+  // Sort the walks left by their current vertex, by counting. Returns the
+  // number of walks left.
+  size_t BucketWalks() {
+    auto num_vertices = GetNumVertices();
+    walk_offsets_.assign(num_vertices + 1, 0);
+    for (auto position : positions_) {
+      if (position != MAX_VERTEX_ID) walk_offsets_[position + 1]++;
+    }
+    for (VertexID id = 0; id < num_vertices; id++) {
+      walk_offsets_[id + 1] += walk_offsets_[id];
+    }
+    walk_ids_.resize(walk_offsets_[num_vertices]);
+    std::vector<size_t> cursor(walk_offsets_.begin(), walk_offsets_.end() - 1);
+    for (size_t i = 0; i < positions_.size(); i++) {
+      if (positions_[i] != MAX_VERTEX_ID) {
+        walk_ids_[cursor[positions_[i]]++] = i;
+      }
+    }
+    return walk_ids_.size();
+  }
+
+  // The blocks holding the current vertex of a walk left.
+  std::vector<bool> GetBlocksWithWalks() {
+    std::vector<bool> blocks(GetNumBlocks());
+    for (GraphID bid = 0; bid < blocks.size(); bid++) {
+      auto& block = GetBlockMetadata(bid);
+      blocks[bid] =
+          walk_offsets_[block.end_id] != walk_offsets_[block.begin_id];
+    }
+    return blocks;
+  }
+
+  void WritePositions() {
+    if (!output_.is_open()) return;
+    output_.write((char*)positions_.data(),
+                  positions_.size() * sizeof(VertexID));
   }
 
  private:
-  VertexID* matrix_ = nullptr;
+  uint32_t walk_length_ = 5;
+  uint32_t walks_per_vertex_ = 1;
+  uint64_t seed_ = 1;
+  uint32_t step_ = 0;
+
+  // current vertex of every walk, and the walks left by current vertex.
+  std::vector<VertexID> positions_;
+  std::vector<size_t> walk_offsets_;
+  std::vector<size_t> walk_ids_;
+
+  std::ofstream output_;
 };
 
 }  // namespace sics::graph::nvme::apps
@@ -0,0 +1,116 @@
+#ifndef GRAPH_SYSTEMS_NVME_APPS_TRIANGLE_COUNT_NVME_APP_H_
+#define GRAPH_SYSTEMS_NVME_APPS_TRIANGLE_COUNT_NVME_APP_H_
+
+#include <vector>
+
+#include "core/apis/planar_app_base.h"
+#include "core/util/intersection.h"
+#include "nvme/apis/block_api.h"
+#include "nvme/data_structures/graph/pram_block.h"
+
+namespace sics::graph::nvme::apps {
+
+using BlockGraph = data_structures::graph::BlockCSRGraphUInt32;
+
+// Triangle counting on blocks, with the number of triangles of every vertex
+// as its data, and the local clustering coefficients. Needs a symmetric graph
+// with sorted adjacency.
+//
+// Edges are oriented from lower to higher rank, by (degree, ID), and a
+// triangle u < v < w is counted once, for the edge (u, v), as a common
+// neighbor w of u and v of a rank above v. Blocks are not written back, so the
+// adjacency is not reordered and the rank is checked on the merged lists. The
+// neighbors of v may be in another block, so all blocks stay in memory
+// (`in_memory`): the first MapVertex reads them, the second counts.
+class TriangleCountNvmeApp : public apis::BlockModel<BlockGraph::VertexData> {
+  using VertexIndex = core::common::VertexIndex;
+  using EdgeIndex = core::common::EdgeIndex;
+  using VertexID = core::common::VertexID;
+  using VertexDegree = core::common::VertexDegree;
+
+  using FuncVertex = core::common::FuncVertex;
+
+ public:
+  TriangleCountNvmeApp() = default;
+  TriangleCountNvmeApp(const std::string& root_path) : BlockModel(root_path) {
+    if (!core::common::Configurations::Get()->in_memory) {
+      LOG_FATAL("triangle counting on blocks needs the in memory mode");
+    }
+    degrees_.resize(GetNumVertices(), 0);
+    clustering_.resize(GetNumVertices(), 0);
+  }
+  ~TriangleCountNvmeApp() override = default;
+
+  void Init(VertexID id) {
+    degrees_[id] = GetOutDegree(id);
+    Write(id, 0);
+  }
+
+  void Count(VertexID u) {
+    auto edges_u = GetEdges(u);
+    for (VertexDegree i = 0; i < degrees_[u]; i++) {
+      auto v = edges_u[i];
+      if (!IsHigher(v, u)) continue;
+      VertexDegree degree_v = 0;
+      auto edges_v = GetResidentEdges(v, &degree_v);
+      if (edges_v == nullptr) LOGF_FATAL("block of vertex {} is not read", v);
+      uint32_t num = 0;
+      core::util::IntersectSorted(edges_u, degrees_[u], edges_v, degree_v,
+                                  [this, v, &num](VertexID w) {
+                                    if (!IsHigher(w, v)) return;
+                                    WriteAdd(w, 1);
+                                    num++;
+                                  });
+      if (num == 0) continue;
+      WriteAdd(u, num);
+      WriteAdd(v, num);
+    }
+  }
+
+  void Clustering(VertexID id) {
+    uint64_t degree = degrees_[id];
+    if (degree < 2) return;
+    clustering_[id] = 2.0 * Read(id) / (degree * (degree - 1));
+  }
+
+  void Compute() override {
+    LOG_INFO("TriangleCountNvmeApp::Compute begin!");
+    FuncVertex init = [this](VertexID id) { this->Init(id); };
+    FuncVertex count = [this](VertexID id) { this->Count(id); };
+    FuncVertex clustering = [this](VertexID id) { this->Clustering(id); };
+
+    MapVertex(&init);
+    MapVertex(&count);
+    update_store_.Sync(true);
+    ParallelVertexDo(clustering);
+
+    uint64_t num_triangles = 0;
+    double clustering_sum = 0;
+    for (VertexID id = 0; id < GetNumVertices(); id++) {
+      num_triangles += Read(id);
+      clustering_sum += clustering_[id];
+    }
+    // Every triangle is counted at its 3 vertices.
+    LOGF_INFO("triangles: {}, average clustering coefficient: {}",
+              num_triangles / 3, clustering_sum / GetNumVertices());
+    LOG_INFO("TriangleCountNvmeApp::Compute end!");
+  }
+
+  float GetClusteringCoefficient(VertexID id) const {
+    return clustering_.at(id);
+  }
+
+ private:
+  // If `a` comes after `b` in the orientation.
+  bool IsHigher(VertexID a, VertexID b) const {
+    return degrees_[a] > degrees_[b] || (degrees_[a] == degrees_[b] && a > b);
+  }
+
+ private:
+  std::vector<VertexDegree> degrees_;
+  std::vector<float> clustering_;
+};
+
+}  // namespace sics::graph::nvme::apps
+
+#endif  // GRAPH_SYSTEMS_NVME_APPS_TRIANGLE_COUNT_NVME_APP_H_
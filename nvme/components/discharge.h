@@ -36,16 +36,18 @@ class Discharger : public Component {
         scheduler::WriteMessage message = writer_q_->PopOrWait();
         if (message.terminated) {
           // LOG_INFO("*** Discharger is signaled termination ***");
+          writer_.Flush();
           break;
         }
         // LOGF_INFO("Discharger starts writing block {}", message.graph_id);
         // First serialized.
         message.serialized = message.graph->Serialize(occupied_pool_).release();
-        // Then write to disk.
-        writer_.Write(&message);
-        // LOGF_INFO("Discharger completes writing block {}, size {} MB",
-                  // message.graph_id, message.bytes_written >> 20);
-        response_q_->Push(scheduler::Message(message));
+        // Then write to disk, and respond once written, so that the next
+        // block is serialized while this one is written.
+        writer_.WriteAsync(&message,
+                           [this](const scheduler::WriteMessage& written) {
+                             response_q_->Push(scheduler::Message(written));
+                           });
       }
     });
   }
@@ -12,6 +12,8 @@
 #include "core/common/types.h"
 #include "core/components/component.h"
 #include "core/util/logging.h"
+#include "core/util/profiler.h"
+#include "core/util/task_partition.h"
 #include "nvme/common/config.h"
 #include "nvme/components/component.h"
 #include "nvme/data_structures/graph/pram_block.h"
@@ -45,6 +47,7 @@ class Executor : public Component {
     in_memory_time_ = core::common::Configurations::Get()->in_memory;
     edge_mutate_ = core::common::Configurations::Get()->edge_mutate;
     task_size_ = core::common::Configurations::Get()->task_size;
+    hub_degree_ = core::common::Configurations::Get()->hub_degree;
   }
   ~Executor() final = default;
 
@@ -69,10 +72,14 @@ class Executor : public Component {
               in_memory_time_ = false;
             }
             if (message.map_type == scheduler::kMapVertex) {
+              PROFILE_SCOPE_ARG("executor.map_vertex", message.graph_id);
               ParallelVertexDo(message.graph, *message.func_vertex);
             } else if (message.map_type == scheduler::kMapEdge) {
+              PROFILE_SCOPE_ARG("executor.map_edge", message.graph_id);
               ParallelEdgeDo(message.graph, *message.func_edge);
             } else if (message.map_type == scheduler::kMapEdgeAndMutate) {
+              PROFILE_SCOPE_ARG("executor.map_edge_and_mutate",
+                                message.graph_id);
               ParallelEdgeAndMutateDo(message.graph,
                                       *message.func_edge_mutate_bool);
             } else {
@@ -112,29 +119,21 @@ class Executor : public Component {
                         const FuncVertex& vertex_func) {
     //    LOG_DEBUG("ParallelVertexDo begins!");
     auto block = static_cast<BLockCSR*>(graph);
-    uint32_t task_size = GetTaskSize(block->GetVertexNums());
-    //    uint32_t task_size = task_size_;
+    // Vertex functions run on whole vertices, so hubs are not split.
+    auto ranges = GetEdgeTasks(block, 0);
     core::common::TaskPackage tasks;
-    //    tasks.reserve(ceil((double)block->GetVertexNums() / task_size));
-    VertexIndex begin_index = 0, end_index = 0;
-    for (; begin_index < block->GetVertexNums();) {
-      end_index += task_size;
-      if (end_index > block->GetVertexNums()) {
-        end_index = block->GetVertexNums();
-      }
-      auto task = [&vertex_func, block, begin_index, end_index]() {
-        for (VertexIndex idx = begin_index; idx < end_index; idx++) {
+    tasks.reserve(ranges.size());
+    for (auto& range : ranges) {
+      auto task = [&vertex_func, block, range]() {
+        for (VertexIndex idx = range.begin; idx < range.end; idx++) {
           vertex_func(block->GetVertexID(idx));
         }
       };
       tasks.push_back(task);
-      begin_index = end_index;
     }
-    //    LOGF_INFO("ParallelVertexDo task_size: {}, num tasks: {}", task_size,
-    //              tasks.size());
+    //    LOGF_INFO("ParallelVertexDo num tasks: {}", tasks.size());
     //    block->LogBlockVertices();
     //    block->LogBlockEdges();
-    //    LOGF_INFO("task num: {}", tasks.size());
     task_runner_.SubmitSync(tasks);
     // TODO: sync of update_store and graph_ vertex data
     //    graph->SyncVertexData();
@@ -144,31 +143,27 @@ class Executor : public Component {
   void ParallelEdgeDo(core::data_structures::Serializable* graph,
                       const FuncEdge& edge_func) {
     //    LOG_DEBUG("ParallelEdgeDo begins!");
-    //    uint32_t task_size = GetTaskSize(block->GetVertexNums());
     auto block = static_cast<BLockCSR*>(graph);
-    uint32_t task_size = GetTaskSize(block->GetVertexNums());
-    //    uint32_t task_size = task_size_;
+    // Edge functions may update their source vertex without atomics, e.g.
+    // the pull of PageRank, and there is no step merging the chunks of a hub,
+    // so hubs are not split.
+    auto ranges = GetEdgeTasks(block, 0);
     core::common::TaskPackage tasks;
-    VertexIndex begin_index = 0, end_index = 0;
-    for (; begin_index < block->GetVertexNums();) {
-      end_index += task_size;
-      if (end_index > block->GetVertexNums()) {
-        end_index = block->GetVertexNums();
-      }
-      auto task = [&edge_func, block, begin_index, end_index]() {
-        for (VertexIndex idx = begin_index; idx < end_index; idx++) {
-          auto degree = block->GetOutDegreeByIndex(idx);
-          if (degree != 0) {
+    tasks.reserve(ranges.size());
+    for (auto& range : ranges) {
+      auto task = [&edge_func, block, range]() {
+        for (VertexIndex idx = range.begin; idx < range.end; idx++) {
+          auto [begin, end] = GetEdgeRange(block, range, idx);
+          if (begin != end) {
             auto src_id = block->GetVertexID(idx);
             VertexID* outEdges = block->GetOutEdgesBaseByIndex(idx);
-            for (VertexIndex j = 0; j < degree; j++) {
+            for (VertexIndex j = begin; j < end; j++) {
               edge_func(src_id, outEdges[j]);
             }
           }
         }
       };
       tasks.push_back(task);
-      begin_index = end_index;
     }
     //    LOGF_INFO("task num: {}", tasks.size());
     task_runner_.SubmitSync(tasks);
@@ -178,30 +173,24 @@ class Executor : public Component {
   void ParallelEdgeDoWithMutate(core::data_structures::Serializable* graph,
                                 const FuncEdge& edge_func) {
     //    LOG_DEBUG("ParallelEdgeDelDo begins!");
-    //    uint32_t task_size = GetTaskSize(block->GetVertexNums());
     auto block = static_cast<BLockCSR*>(graph);
-    uint32_t task_size = GetTaskSize(block->GetVertexNums());
-    //    uint32_t task_size = task_size_;
+    // As in ParallelEdgeDo, hubs are not split.
+    auto ranges = GetEdgeTasks(block, 0);
     core::common::TaskPackage tasks;
-    VertexIndex begin_index = 0, end_index = 0;
+    tasks.reserve(ranges.size());
     //    auto del_bitmap = block->GetEdgeDeleteBitmap();
     auto del_bitmap = new core::common::Bitmap();
     core::common::EdgeIndex edge_offset = block->GetBlockEdgeOffset();
 
-    for (; begin_index < block->GetVertexNums();) {
-      end_index += task_size;
-      if (end_index > block->GetVertexNums()) {
-        end_index = block->GetVertexNums();
-      }
-      auto task = [&edge_func, block, begin_index, end_index, del_bitmap,
-                   edge_offset]() {
-        for (VertexIndex idx = begin_index; idx < end_index; idx++) {
-          auto degree = block->GetOutDegreeByIndex(idx);
-          if (degree != 0) {
+    for (auto& range : ranges) {
+      auto task = [&edge_func, block, range, del_bitmap, edge_offset]() {
+        for (VertexIndex idx = range.begin; idx < range.end; idx++) {
+          auto [begin, end] = GetEdgeRange(block, range, idx);
+          if (begin != end) {
             auto src_id = block->GetVertexID(idx);
             EdgeIndex outOffset_base = block->GetOutOffsetByIndex(idx);
             VertexID* outEdges = block->GetOutEdgesBaseByIndex(idx);
-            for (VertexIndex j = 0; j < degree; j++) {
+            for (VertexIndex j = begin; j < end; j++) {
               EdgeIndex edge_index = outOffset_base + j + edge_offset;
               if (!del_bitmap->GetBit(edge_index)) {
                 edge_func(src_id, outEdges[j]);
@@ -211,7 +200,6 @@ class Executor : public Component {
         }
       };
       tasks.push_back(task);
-      begin_index = end_index;
     }
     //    LOGF_INFO("task num: {}", tasks.size());
     task_runner_.SubmitSync(tasks);
@@ -222,27 +210,24 @@ class Executor : public Component {
                                const FuncEdgeMutate& edge_del_func) {
     //    LOG_INFO("ParallelEdgeAndMutateDo begins!");
     auto block = static_cast<BLockCSR*>(graph);
-    uint32_t task_size = GetTaskSize(block->GetVertexNums());
-    //    uint32_t task_size = task_size_;
+    // The chunks of a hub delete edges of the same vertex concurrently, which
+    // `PramBlock::DeleteEdge` supports. See `BlockModel::MapAndMutateEdgeBool`
+    // for what edge_del_func may do.
+    auto ranges = GetEdgeTasks(block, hub_degree_);
     core::common::TaskPackage tasks;
-    VertexIndex begin_index = 0, end_index = 0;
+    tasks.reserve(ranges.size());
     //    auto del_bitmap = block->GetEdgeDeleteBitmap();
     //    core::common::EdgeIndex edge_offset = block->GetBlockEdgeOffset();
 
-    for (; begin_index < block->GetVertexNums();) {
-      end_index += task_size;
-      if (end_index > block->GetVertexNums()) {
-        end_index = block->GetVertexNums();
-      }
-
-      auto task = [&edge_del_func, block, begin_index, end_index]() {
-        for (VertexIndex idx = begin_index; idx < end_index; idx++) {
-          auto degree = block->GetOutDegreeByIndex(idx);
-          if (degree != 0) {
+    for (auto& range : ranges) {
+      auto task = [&edge_del_func, block, range]() {
+        for (VertexIndex idx = range.begin; idx < range.end; idx++) {
+          auto [begin, end] = GetEdgeRange(block, range, idx);
+          if (begin != end) {
             auto src_id = block->GetVertexID(idx);
             EdgeIndex outOffset_base = block->GetOutOffsetByIndex(idx);
             VertexID* outEdges = block->GetOutEdgesBaseByIndex(idx);
-            for (VertexIndex j = 0; j < degree; j++) {
+            for (VertexIndex j = begin; j < end; j++) {
               EdgeIndex edge_index = outOffset_base + j;
               if (edge_del_func(src_id, outEdges[j])) {
                 block->DeleteEdge(idx, edge_index);
@@ -252,7 +237,6 @@ class Executor : public Component {
         }
       };
       tasks.push_back(task);
-      begin_index = end_index;
     }
     //    LOGF_INFO("task num: {}", tasks.size());
     task_runner_.SubmitSync(tasks);
@@ -261,6 +245,29 @@ class Executor : public Component {
     //    LOG_INFO("ParallelEdgeAndMutateDo ends!");
   }
 
+  // Split the vertex indexes of `block` into about
+  // `parallelism * task_package_factor` tasks with an equal share of edges,
+  // using the per vertex offsets of the block. Vertices with more than
+  // `hub_degree` edges are split into edge range tasks, 0 disables it.
+  std::vector<core::util::TaskRange> GetEdgeTasks(BLockCSR* block,
+                                                  uint32_t hub_degree) const {
+    std::vector<core::util::TaskRange> ranges;
+    core::util::SplitByEdges(
+        0, block->GetVertexNums(), parallelism_ * task_package_factor_,
+        hub_degree,
+        [block](VertexIndex idx) { return block->GetOutOffsetByIndex(idx); },
+        [block](VertexIndex idx) { return block->GetOutDegreeByIndex(idx); },
+        &ranges);
+    return ranges;
+  }
+
+  // The out edges of vertex `idx` that task `range` covers.
+  static std::pair<VertexIndex, VertexIndex> GetEdgeRange(
+      BLockCSR* block, const core::util::TaskRange& range, VertexIndex idx) {
+    if (range.IsHubChunk()) return {range.edge_begin, range.edge_end};
+    return {0, block->GetOutDegreeByIndex(idx)};
+  }
+
   size_t GetTaskSize(VertexID max_vid) const {
     auto task_num = parallelism_ * task_package_factor_;
     size_t task_size = ceil((double)max_vid / task_num);
@@ -281,6 +288,7 @@ class Executor : public Component {
   const uint32_t task_package_factor_;
   bool edge_mutate_ = false;
   uint32_t task_size_ = 500000;
+  uint32_t hub_degree_ = 0;
 };
 
 }  // namespace sics::graph::nvme::components
@@ -2,6 +2,7 @@
 #define GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_GRAPH_PRAM_BLOCK_H_
 
 #include <memory>
+#include <vector>
 
 #include "core/common/bitmap.h"
 #include "core/common/bitmap_no_ownership.h"
@@ -13,6 +14,7 @@
 #include "core/util/atomic.h"
 #include "core/util/pointer_cast.h"
 #include "nvme/data_structures/graph/serialized_pram_block_csr.h"
+#include "nvme/data_structures/mutation_log.h"
 
 namespace sics::graph::nvme::data_structures::graph {
 
@@ -72,6 +74,13 @@ class PramBlock : public core::data_structures::Serializable {
         out_edges_base_new_ = nullptr;
       }
     }
+    // The deletions since the block was read, after its meta data and edges.
+    if (!mutation_log_.empty()) {
+      OwnedBuffer log(mutation_log_.size());
+      memcpy(log.Get(), mutation_log_.data(), mutation_log_.size());
+      graph_serialized_->GetCSRBuffer()->push_back(std::move(log));
+      mutation_log_.clear();
+    }
     return core::util::pointer_downcast<Serialized,
                                         SerializedPramBlockCSRGraph>(
         std::move(graph_serialized_));
@@ -184,6 +193,12 @@ class PramBlock : public core::data_structures::Serializable {
       //      num_outgoing_edges_new = 0;
       LOG_FATAL("delete edges number is more than left, stop!");
     }
+    if (del_edges != 0 &&
+        core::common::Configurations::Get()->mutation_log_ratio > 0) {
+      AppendMutationLogRecord(edge_delete_bitmap_.GetDataBasePointer(),
+                              block_metadata_->num_outgoing_edges,
+                              &mutation_log_);
+    }
 
     if (num_outgoing_edges_new != 0) {
       out_edges_base_new_ = new VertexID[num_outgoing_edges_new];
@@ -243,10 +258,8 @@ class PramBlock : public core::data_structures::Serializable {
 
   void DeleteEdge(VertexID idx, EdgeIndex eid) {
     edge_delete_bitmap_.SetBit(eid);
-    out_degree_base_new_[idx] = out_degree_base_new_[idx] - 1;
-    // TODO: Use atomic to update out_degree_base_new_ for discontinued vertex.
-    //    core::util::atomic::WriteMin(&out_degree_base_new_[idx],
-    //                                 out_degree_base_new_[idx] - 1);
+    // The edges of a hub may be deleted by several tasks at once.
+    core::util::atomic::WriteSub(&out_degree_base_new_[idx], (VertexDegree)1);
   }
 
   // TODO: add block methods like sub-graph
@@ -330,6 +343,8 @@ class PramBlock : public core::data_structures::Serializable {
   EdgeIndex* out_offset_base_new_;
   VertexID* out_edges_base_new_;
   core::common::Bitmap edge_delete_bitmap_;
+  // Records of the deletions not written yet, see mutation_log.h.
+  std::vector<uint8_t> mutation_log_;
 
   // configs
   uint32_t parallelism_;
@@ -0,0 +1,119 @@
+#ifndef GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_MUTATION_LOG_H_
+#define GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_MUTATION_LOG_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/common/types.h"
+#include "core/util/logging.h"
+
+namespace sics::graph::nvme::data_structures {
+
+// The edges deleted from block gid since its file was last written in full,
+// appended by io::PramBlockWriter and applied by io::PramBlockReader.
+//
+// The log is a sequence of records, one per mutation of the block. A record
+// is a MutationLogHeader followed by the indices of the deleted edges, in
+// increasing order, as LEB128 varints of the gap to the previous index. The
+// indices are those of the edges as they were before the mutation, i.e. of the
+// block file with the previous records applied.
+inline std::string GetMutationLogPath(const std::string& root_path,
+                                      core::common::GraphID gid) {
+  return root_path + "blocks/" + std::to_string(gid) + ".log";
+}
+
+struct MutationLogHeader {
+  // Edges of the block before the mutation, to check the record applies.
+  uint64_t num_edges;
+  uint64_t num_deleted;
+  // Bytes of the indices that follow.
+  uint64_t size;
+};
+
+// Append to `log` the record of deleting the edges whose bit is set in
+// `deleted`, a bitmap of `num_edges` bits.
+inline void AppendMutationLogRecord(const uint64_t* deleted,
+                                    core::common::EdgeIndex num_edges,
+                                    std::vector<uint8_t>* log) {
+  auto header_offset = log->size();
+  log->resize(header_offset + sizeof(MutationLogHeader));
+  MutationLogHeader header{num_edges, 0, 0};
+  uint64_t last = 0;
+  for (size_t w = 0; w * 64 < num_edges; w++) {
+    for (uint64_t word = deleted[w]; word != 0; word &= word - 1) {
+      uint64_t index = w * 64 + __builtin_ctzll(word);
+      if (index >= num_edges) break;
+      for (uint64_t gap = index - last; true; gap >>= 7) {
+        if (gap < 0x80) {
+          log->push_back(gap);
+          break;
+        }
+        log->push_back((gap & 0x7f) | 0x80);
+      }
+      last = index;
+      header.num_deleted++;
+    }
+  }
+  header.size = log->size() - header_offset - sizeof(MutationLogHeader);
+  memcpy(log->data() + header_offset, &header, sizeof(header));
+}
+
+// Apply the records of `log` to a block of `num_vertices` vertices and
+// `num_edges` edges, in place, and return the edges left. A trailing record
+// cut short, by a write that did not complete, is ignored.
+inline core::common::EdgeIndex ApplyMutationLog(
+    const uint8_t* log, size_t size, core::common::VertexID num_vertices,
+    core::common::VertexDegree* degree, core::common::EdgeIndex* offset,
+    core::common::VertexID* edges, core::common::EdgeIndex num_edges) {
+  using core::common::EdgeIndex;
+  size_t pos = 0;
+  while (pos + sizeof(MutationLogHeader) <= size) {
+    MutationLogHeader header;
+    memcpy(&header, log + pos, sizeof(header));
+    pos += sizeof(header);
+    if (pos + header.size > size) break;
+    if (header.num_edges != num_edges) {
+      LOGF_FATAL("Mutation log record of {} edges for a block of {} edges",
+                 header.num_edges, num_edges);
+    }
+    auto end = pos + header.size;
+    // Next deleted index, or num_edges once they are all consumed.
+    uint64_t next = 0, left = header.num_deleted;
+    auto read_next = [&]() {
+      if (left-- == 0) {
+        next = num_edges;
+        return;
+      }
+      uint64_t gap = 0;
+      for (int shift = 0; pos < end; shift += 7) {
+        auto byte = log[pos++];
+        gap |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) break;
+      }
+      next += gap;
+    };
+    read_next();
+    EdgeIndex kept = 0;
+    for (core::common::VertexID i = 0; i < num_vertices; i++) {
+      EdgeIndex begin = offset[i], stop = begin + degree[i];
+      offset[i] = kept;
+      for (EdgeIndex j = begin; j < stop; j++) {
+        if (j == next) {
+          read_next();
+        } else {
+          edges[kept++] = edges[j];
+        }
+      }
+      degree[i] = kept - offset[i];
+    }
+    num_edges = kept;
+    pos = end;
+  }
+  return num_edges;
+}
+
+}  // namespace sics::graph::nvme::data_structures
+
+#endif  // GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_MUTATION_LOG_H_
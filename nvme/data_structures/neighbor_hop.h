@@ -1,9 +1,16 @@
 #ifndef GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_NEIGHBOR_HOP_H_
 #define GRAPH_SYSTEMS_NVME_DATA_STRUCTURES_NEIGHBOR_HOP_H_
 
-#include <fstream>
-#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "core/common/types.h"
 #include "core/data_structures/graph_metadata.h"
@@ -17,66 +24,106 @@ using VertexIndex = core::common::VertexIndex;
 using EdgeIndex = core::common::EdgeIndex;
 using VertexDegree = core::common::VertexDegree;
 
+// The neighbor info of the vertices of block gid: four arrays of one VertexID
+// per vertex, the min one-hop, max one-hop, min two-hop and max two-hop
+// neighbor, each at the start of a section of GetNeighborInfoSectionSize
+// bytes.
+inline std::string GetNeighborInfoPath(const std::string& root_path,
+                                       GraphID gid) {
+  return root_path + "precomputing/" + std::to_string(gid) + "_hops.bin";
+}
+
+// Sections are page aligned, so that the pages of an array never read stay
+// out of memory.
+inline size_t GetNeighborInfoSectionSize(VertexID num_vertices) {
+  constexpr size_t kPageSize = 4096;
+  size_t size = (size_t)num_vertices * sizeof(VertexID);
+  return (size + kPageSize - 1) / kPageSize * kPageSize;
+}
+
+// The precomputed neighbor info of all blocks. The file of a block is mapped
+// on the first access to one of its vertices, so only the pages of the blocks
+// (and arrays) in use are read, and as clean file pages they are dropped
+// before any anonymous memory under pressure. Release() unmaps them all.
 struct NeighborHopInfo {
  public:
+  enum Array { kMinOneHop = 0, kMaxOneHop, kMinTwoHop, kMaxTwoHop };
+
   NeighborHopInfo() = default;
-  ~NeighborHopInfo() {
-    delete[] min_one_hop_neighbor;
-    delete[] max_one_hop_neighbor;
-    delete[] min_two_hop_neighbor;
-    delete[] max_two_hop_neighbor;
-  }
+  ~NeighborHopInfo() { Release(); }
 
   void Init(const std::string& root_path,
             const core::data_structures::GraphMetadata& metadata) {
-    min_one_hop_neighbor = new VertexID[metadata.get_num_vertices()];
-    min_two_hop_neighbor = new VertexID[metadata.get_num_vertices()];
-    for (GraphID i = 0; i < metadata.get_num_blocks(); i++) {
+    Release();
+    root_path_ = root_path;
+    auto num_blocks = metadata.get_num_blocks();
+    blocks_ = std::make_unique<BlockInfo[]>(num_blocks);
+    block_ends_.clear();
+    for (GraphID i = 0; i < num_blocks; i++) {
       auto& block = metadata.GetBlockMetadata(i);
-      Read(root_path + "precomputing/" + std::to_string(block.bid) +
-               "_min_one_hop.bin",
-           1, block.begin_id);
-      Read(root_path + "precomputing/" + std::to_string(block.bid) +
-               "_min_two_hop.bin",
-           3, block.begin_id);
+      blocks_[i].gid = block.bid;
+      blocks_[i].begin_id = block.begin_id;
+      blocks_[i].num_vertices = block.num_vertices;
+      block_ends_.push_back(block.end_id);
     }
   }
 
-  void Read(const std::string& path, int mode, VertexID block_begin_id) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
-      LOGF_FATAL("Cannot open binary file {}", path);
-    }
-    file.seekg(0, std::ios::end);
-    size_t size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    // auto num_vertices = size / sizeof(VertexID);
-    if (mode == 1) {
-      file.read(reinterpret_cast<char*>(min_one_hop_neighbor + block_begin_id),
-                size);
-    } else if (mode == 2) {
-      file.read(reinterpret_cast<char*>(max_one_hop_neighbor + block_begin_id),
-                size);
-    } else if (mode == 3) {
-      file.read(reinterpret_cast<char*>(min_two_hop_neighbor + block_begin_id),
-                size);
-    } else if (mode == 4) {
-      file.read(reinterpret_cast<char*>(max_two_hop_neighbor + block_begin_id),
-                size);
+  // Unmap the files of all blocks. They are mapped again if read.
+  void Release() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (size_t i = 0; i < block_ends_.size(); i++) {
+      auto base = blocks_[i].base.exchange(nullptr);
+      if (base != nullptr) {
+        munmap(base, 4 * GetNeighborInfoSectionSize(blocks_[i].num_vertices));
+      }
     }
-    file.close();
   }
 
-  VertexID GetMinOneHop(VertexID id) { return min_one_hop_neighbor[id]; }
-  VertexID GetMaxOneHop(VertexID id) { return max_one_hop_neighbor[id]; }
-  VertexID GetMinTwoHop(VertexID id) { return min_two_hop_neighbor[id]; }
-  VertexID GetMaxTwoHop(VertexID id) { return max_two_hop_neighbor[id]; }
+  VertexID Get(VertexID id, Array array) {
+    auto i = std::upper_bound(block_ends_.begin(), block_ends_.end(), id) -
+             block_ends_.begin();
+    auto& block = blocks_[i];
+    auto base = block.base.load(std::memory_order_acquire);
+    if (base == nullptr) base = Map(&block);
+    auto section =
+        base + array * GetNeighborInfoSectionSize(block.num_vertices);
+    return ((VertexID*)section)[id - block.begin_id];
+  }
 
- public:
-  VertexID* min_one_hop_neighbor = nullptr;
-  VertexID* max_one_hop_neighbor = nullptr;
-  VertexID* min_two_hop_neighbor = nullptr;
-  VertexID* max_two_hop_neighbor = nullptr;
+  VertexID GetMinOneHop(VertexID id) { return Get(id, kMinOneHop); }
+  VertexID GetMaxOneHop(VertexID id) { return Get(id, kMaxOneHop); }
+  VertexID GetMinTwoHop(VertexID id) { return Get(id, kMinTwoHop); }
+  VertexID GetMaxTwoHop(VertexID id) { return Get(id, kMaxTwoHop); }
+
+ private:
+  struct BlockInfo {
+    GraphID gid;
+    VertexID begin_id;
+    VertexID num_vertices;
+    std::atomic<char*> base = nullptr;
+  };
+
+  char* Map(BlockInfo* block) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto base = block->base.load(std::memory_order_acquire);
+    if (base != nullptr) return base;
+    auto path = GetNeighborInfoPath(root_path_, block->gid);
+    size_t size = 4 * GetNeighborInfoSectionSize(block->num_vertices);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) LOGF_FATAL("Cannot open binary file {}", path);
+    auto addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) LOGF_FATAL("Cannot map {}", path);
+    base = (char*)addr;
+    block->base.store(base, std::memory_order_release);
+    return base;
+  }
+
+  std::string root_path_;
+  std::unique_ptr<BlockInfo[]> blocks_;
+  // End ID of every block, to find the block of a vertex.
+  std::vector<VertexID> block_ends_;
+  std::mutex mtx_;
 };
 
 }  // namespace sics::graph::nvme::data_structures
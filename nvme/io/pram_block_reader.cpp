@@ -1,27 +1,38 @@
 #include "nvme/io/pram_block_reader.h"
 
+#include <cstring>
+
+#include "core/util/profiler.h"
+#include "nvme/data_structures/mutation_log.h"
+
 namespace sics::graph::nvme::io {
 using SerializedPramBlockCSRGraph =
     data_structures::graph::SerializedPramBlockCSRGraph;
 
 void PramBlockReader::Read(ReadMessage* message,
                            core::common::TaskRunner* /* runner */) {
-  // Init path.
-  std::string path = "";
-  if (message->changed) {
-    path =
-        root_path_ + "blocks/" + std::to_string(message->graph_id) + ".bin.new";
-  } else {
-    path = root_path_ + "blocks/" + std::to_string(message->graph_id) + ".bin";
+  PROFILE_SCOPE_ARG("io.read_block", message->graph_id);
+  // Init path. A mutated block is the last block file written in full, or the
+  // original one, with the deletions of its mutation log since.
+  std::string path =
+      root_path_ + "blocks/" + std::to_string(message->graph_id) + ".bin";
+  if (message->changed && std::filesystem::exists(path + ".new")) {
+    path += ".new";
   }
 
   // Read block info.
   Serialized* block_serialized = message->serialized;
   std::vector<OwnedBuffer> buffers;
   ReadBlockInfo(path, message->num_vertices, &buffers);
+  if (message->changed) {
+    ApplyMutationLog(
+        data_structures::GetMutationLogPath(root_path_, message->graph_id),
+        message->num_vertices, &buffers);
+  }
 
   block_serialized->ReceiveBuffers(std::move(buffers));
   message->bytes_read = read_size_;
+  PROFILE_COUNTER("io.read_mb", read_size_);
   read_size_ = 0;
 }
 
@@ -58,6 +69,36 @@ void PramBlockReader::ReadBlockInfo(const std::string& path,
   file.close();
 }
 
+void PramBlockReader::ApplyMutationLog(const std::string& path,
+                                       core::common::VertexCount num_vertices,
+                                       std::vector<OwnedBuffer>* buffers) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return;
+  std::vector<uint8_t> log(std::filesystem::file_size(path));
+  file.read((char*)log.data(), log.size());
+  if (!file) {
+    LOG_FATAL("Error reading mutation log: ", path.c_str());
+  }
+  file.close();
+  read_size_ += (log.size() >> 20);
+
+  auto meta = buffers->at(0).Get();
+  auto degree = (core::common::VertexDegree*)meta;
+  auto offset = (core::common::EdgeIndex*)(
+      meta + num_vertices * sizeof(core::common::VertexID));
+  auto edges = (core::common::VertexID*)buffers->at(1).Get();
+  core::common::EdgeIndex num_edges =
+      buffers->at(1).GetSize() / sizeof(core::common::VertexID);
+  auto num_edges_left = data_structures::ApplyMutationLog(
+      log.data(), log.size(), num_vertices, degree, offset, edges, num_edges);
+  if (num_edges_left != num_edges) {
+    // Keep the edges left only, so that the buffer is the size of the block.
+    OwnedBuffer edges_left(num_edges_left * sizeof(core::common::VertexID));
+    memcpy(edges_left.Get(), edges, edges_left.GetSize());
+    buffers->at(1) = std::move(edges_left);
+  }
+}
+
 void PramBlockReader::ReadNeighborInfo(const std::string& path,
                                        std::vector<OwnedBuffer>* buffers) {
   std::ifstream file(path, std::ios::binary);
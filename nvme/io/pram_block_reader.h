@@ -43,6 +43,12 @@ class PramBlockReader : public Reader {
                      core::common::VertexCount num_vertices,
                      std::vector<OwnedBuffer>* buffers);
 
+  // Delete the edges of the mutation log at `path`, if any, from the block
+  // read in `buffers`.
+  void ApplyMutationLog(const std::string& path,
+                        core::common::VertexCount num_vertices,
+                        std::vector<OwnedBuffer>* buffers);
+
   void ReadNeighborInfo(const std::string& path,
                         std::vector<OwnedBuffer>* buffers);
 
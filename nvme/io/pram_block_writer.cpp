@@ -1,52 +1,88 @@
 #include "nvme/io/pram_block_writer.h"
 
+#include <filesystem>
+
+#include "nvme/data_structures/mutation_log.h"
+
 namespace sics::graph::nvme::io {
 
 void PramBlockWriter::Write(WriteMessage* message,
                             core::common::TaskRunner* /* runner */) {
-  std::string file_path = "";
-  if (message->changed) {
-    file_path =
-        root_path_ + "blocks/" + std::to_string(message->graph_id) + ".bin.new";
-    if (message->serialized->HasNext()) {
-      auto a = message->serialized->PopNext();
-      WriteBlockInfo(file_path, a);
-    }
-    if (message->serialized->HasNext() &&
-        core::common::Configurations::Get()->use_two_hop) {
-      auto two_hop_infos = message->serialized->PopNext();
-      WriteBlockInfo(root_path_ + "precomputing/" +
-                         std::to_string(message->graph_id) + ".bin.new",
-                     two_hop_infos);
-    }
-  } else {
+  WriteAsync(message, [](const WriteMessage&) {});
+  file_writer_.Flush();
+}
+
+void PramBlockWriter::WriteAsync(
+    WriteMessage* message,
+    const std::function<void(const WriteMessage&)>& on_written) {
+  if (!message->changed) {
     // if not changed, just release the OwnedBuffer and return.
     while (message->serialized->HasNext()) {
       auto tmp = message->serialized->PopNext();
     }
+    on_written(*message);
+    return;
   }
-  message->bytes_written = write_size_;
-  write_size_ = 0;
-}
 
-void PramBlockWriter::WriteBlockInfo(const std::string& path,
-                                     const std::vector<OwnedBUffer>& buffers) {
-  std::ofstream file(path, std::ios::binary);
-  if (!file) {
-    LOG_FATAL("Error opening bin file: ", path.c_str());
-  }
-
-  file.write((char*)(buffers.at(0).Get()), buffers.at(0).GetSize());
-  if (!file) {
-    LOG_FATAL("Error writing meta data file: ", path.c_str());
+  // The buffers are kept until the files are written: the meta data, edges
+  // and mutation log of the block, then its neighbor info.
+  auto buffers = std::make_shared<std::vector<std::vector<OwnedBUffer>>>();
+  std::vector<core::io::AsyncFileWriter::File> files;
+  message->bytes_written = 0;
+  auto add_file = [&](const std::string& path, std::vector<size_t> indices,
+                      bool append) {
+    auto& file = files.emplace_back();
+    file.path = path;
+    file.append = append;
+    for (auto i : indices) {
+      auto& buffer = buffers->back().at(i);
+      file.iovecs.push_back({buffer.Get(), buffer.GetSize()});
+      message->bytes_written += buffer.GetSize();
+    }
+  };
+  auto gid = message->graph_id;
+  auto block_path = root_path_ + "blocks/" + std::to_string(gid) + ".bin.new";
+  auto log_path = data_structures::GetMutationLogPath(root_path_, gid);
+  bool compacted = false;
+  if (message->serialized->HasNext()) {
+    buffers->push_back(message->serialized->PopNext());
+    auto& csr = buffers->back();
+    auto it = log_size_.find(gid);
+    if (it == log_size_.end()) {
+      // First write of the block since it was mutated: the files left by an
+      // earlier run do not apply to its file read.
+      std::filesystem::remove(block_path);
+      std::filesystem::remove(log_path);
+      it = log_size_.emplace(gid, 0).first;
+    }
+    size_t block_size = csr.at(0).GetSize() + csr.at(1).GetSize();
+    size_t new_log_size = csr.size() > 2 ? csr.at(2).GetSize() : 0;
+    auto ratio = core::common::Configurations::Get()->mutation_log_ratio;
+    if (ratio > 0 && it->second + new_log_size <= ratio * block_size) {
+      // Append the deletions, or write nothing without any.
+      if (new_log_size != 0) add_file(log_path, {2}, true);
+      it->second += new_log_size;
+    } else {
+      // Compact the block file and its log, written in full.
+      add_file(block_path, {0, 1}, false);
+      it->second = 0;
+      compacted = true;
+    }
   }
-  write_size_ += buffers.at(0).GetSize();
-  file.write((char*)(buffers.at(1).Get()), buffers.at(1).GetSize());
-  if (!file) {
-    LOG_FATAL("Error writing label data file: ", path.c_str());
+  if (message->serialized->HasNext() &&
+      core::common::Configurations::Get()->use_two_hop) {
+    buffers->push_back(message->serialized->PopNext());
+    add_file(root_path_ + "precomputing/" + std::to_string(gid) + ".bin.new",
+             {0, 1}, false);
   }
-  write_size_ += buffers.at(1).GetSize();
-  file.close();
+
+  file_writer_.Submit(std::move(files), [buffers, compacted, log_path,
+                                         message = *message, on_written]() {
+    // The new block file has all the deletions of the log.
+    if (compacted) std::filesystem::remove(log_path);
+    buffers->clear();
+    on_written(message);
+  });
 }
 
-}  // namespace sics::graph::nvme::io
\ No newline at end of file
+}  // namespace sics::graph::nvme::io
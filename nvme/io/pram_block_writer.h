@@ -5,6 +5,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "core/common/config.h"
@@ -12,11 +13,19 @@
 #include "core/data_structures/buffer.h"
 #include "core/data_structures/graph_metadata.h"
 #include "core/data_structures/serialized.h"
+#include "core/io/async_file_writer.h"
 #include "nvme/io/reader_writer.h"
 #include "nvme/scheduler/message.h"
 
 namespace sics::graph::nvme::io {
 
+// Writes the changed blocks back, several blocks at once. The edges deleted
+// from a block are appended to its mutation log, `blocks/<gid>.log`, until the
+// log exceeds mutation_log_ratio of the block; the block is then written in
+// full to `blocks/<gid>.bin.new` and the log removed, so that the bytes written
+// follow the deletions rather than the block size. The neighbor info goes to
+// `precomputing/<gid>.bin.new` with two-hop precomputing. The buffers of a
+// block are released once it is written.
 class PramBlockWriter : public Writer {
  private:
   using OwnedBUffer = core::data_structures::OwnedBuffer;
@@ -24,18 +33,24 @@ class PramBlockWriter : public Writer {
 
  public:
   explicit PramBlockWriter(const std::string& root_path)
-      : root_path_(root_path) {}
+      : root_path_(root_path),
+        file_writer_(core::common::Configurations::Get()->write_back_depth,
+                     core::common::Configurations::Get()->sync_write_back) {}
 
   void Write(WriteMessage* message,
              core::common::TaskRunner* runner = nullptr) override;
 
- private:
-  void WriteBlockInfo(const std::string& path,
-                      const std::vector<OwnedBUffer>& buffers);
+  void WriteAsync(
+      WriteMessage* message,
+      const std::function<void(const WriteMessage&)>& on_written) override;
+
+  void Flush() override { file_writer_.Flush(); }
 
  private:
   const std::string root_path_;
-  size_t write_size_ = 0;
+  core::io::AsyncFileWriter file_writer_;
+  // Bytes of the mutation log of every block written since it was mutated.
+  std::unordered_map<core::common::GraphID, size_t> log_size_;
 };
 
 }  // namespace sics::graph::nvme::io
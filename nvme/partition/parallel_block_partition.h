@@ -0,0 +1,373 @@
+#ifndef GRAPH_SYSTEMS_NVME_PARTITION_PARALLEL_BLOCK_PARTITION_H_
+#define GRAPH_SYSTEMS_NVME_PARTITION_PARALLEL_BLOCK_PARTITION_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/common/multithreading/thread_pool.h"
+#include "core/data_structures/graph_metadata.h"
+#include "core/util/logging.h"
+#include "core/util/sub_block_partition.h"
+
+namespace sics::graph::nvme::partition {
+
+using sics::graph::core::common::BlockID;
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::GraphID;
+using sics::graph::core::common::VertexDegree;
+using sics::graph::core::common::VertexID;
+
+struct BlockPartitionOptions {
+  enum Mode { kEdgeEqual, kVertexEqual };
+
+  Mode mode = kEdgeEqual;
+  // kEdgeEqual: at most num_partitions blocks of about the same number of
+  // edges, or of about step_e edges each if it is not 0.
+  size_t num_partitions = 1;
+  EdgeIndex step_e = 0;
+  // kVertexEqual: blocks of step_v vertices.
+  VertexID step_v = 500000;
+  uint32_t parallelism = 8;
+  // Also write the sub-block layout of every block, graphs/<gid>_blocks/ and
+  // graphs/blocks_meta.yaml, as planar/partitioner does.
+  bool two_d = false;
+  uint32_t cut_v = 500000;
+  // If enabled, sizes the sub-blocks instead of cut_v alone.
+  core::util::SubBlockCostModel sub_block_model;
+  uint32_t offset_ratio = 64;
+  // Bytes of edges copied at once by a thread.
+  size_t chunk_size = 64 << 20;
+};
+
+namespace detail {
+
+inline void PReadFully(int fd, void* buffer, size_t size, size_t offset,
+                       const std::string& path) {
+  auto p = (char*)buffer;
+  while (size > 0) {
+    auto n = pread(fd, p, size, offset);
+    if (n <= 0) LOGF_FATAL("Read {} failed at offset {}", path, offset);
+    p += n;
+    offset += n;
+    size -= n;
+  }
+}
+
+inline void PWriteFully(int fd, const void* buffer, size_t size,
+                        size_t offset, const std::string& path) {
+  auto p = (const char*)buffer;
+  while (size > 0) {
+    auto n = pwrite(fd, p, size, offset);
+    if (n <= 0) LOGF_FATAL("Write {} failed at offset {}", path, offset);
+    p += n;
+    offset += n;
+    size -= n;
+  }
+}
+
+inline int OpenOrDie(const std::string& path, int flags) {
+  int fd = open(path.c_str(), flags, 0644);
+  if (fd < 0) LOGF_FATAL("Error opening bin file: {}", path);
+  return fd;
+}
+
+// Run `func(i)` for i in [0, n) on the pool, one task each.
+template <typename Func>
+void ParallelFor(size_t n, core::common::ThreadPool* pool, const Func& func) {
+  core::common::TaskPackage tasks;
+  tasks.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    tasks.push_back([&func, i]() { func(i); });
+  }
+  pool->SubmitSync(tasks);
+}
+
+// A range of edges of a block copied by one task, within one sub-block.
+struct CopyTask {
+  GraphID gid;
+  BlockID sid;
+  // Edges [begin, end) of the block.
+  EdgeIndex begin;
+  EdgeIndex end;
+};
+
+}  // namespace detail
+
+// @DESCRIPTION: split the CSR graph at root_path (one subgraph, graphs/0.bin)
+// into the blocks of the nvme engine, blocks/<gid>.bin and meta.yaml in
+// out_dir, in parallel and without loading the graph.
+//
+// Only the degree array is read into memory, by ranges in parallel. The
+// boundaries of the blocks are found from its prefix sums by range: a block
+// begins at the first vertex whose offset reaches a multiple of the edge
+// share (edge equal), or at every multiple of step_v (vertex equal). The
+// edges are then streamed from graphs/0.bin to their block files in chunks
+// of chunk_size bytes with pread and pwrite, by all threads at once, so a
+// large block is written by several threads. With two_d, the sub-block files
+// of the blocks, their index.bin with the offset_ratio sparse offsets, and
+// graphs/blocks_meta.yaml are written from the same chunks.
+inline void ParallelBlockPartition(const std::string& root_path,
+                                   const std::string& out_dir,
+                                   const BlockPartitionOptions& options) {
+  namespace fs = std::filesystem;
+  using detail::OpenOrDie;
+  using detail::ParallelFor;
+  using detail::PReadFully;
+  using detail::PWriteFully;
+
+  core::data_structures::GraphMetadata graph_metadata(root_path);
+  if (graph_metadata.get_num_subgraphs() != 1) {
+    LOG_FATAL("num subgraphs: ", graph_metadata.get_num_subgraphs());
+  }
+  auto subgraph = graph_metadata.GetSubgraphMetadata(0);
+  VertexID num_vertices = subgraph.num_vertices;
+  EdgeIndex num_edges = subgraph.num_outgoing_edges;
+  if (num_vertices == 0) LOG_FATAL("Can not partition an empty graph");
+  fs::create_directories(out_dir + "blocks");
+  if (options.two_d) fs::create_directories(out_dir + "graphs");
+
+  core::common::ThreadPool pool(options.parallelism);
+  size_t parallelism = options.parallelism;
+  std::string in_path = root_path + "graphs/0.bin";
+  int in_fd = OpenOrDie(in_path, O_RDONLY);
+  // Layout of graphs/0.bin: global IDs, degrees, offsets, edges.
+  size_t degree_base = num_vertices * sizeof(VertexID);
+  size_t edge_base = degree_base + num_vertices * sizeof(VertexDegree) +
+                     num_vertices * sizeof(EdgeIndex);
+
+  // Degrees and their sums, by range.
+  std::vector<VertexDegree> degree(num_vertices);
+  VertexID range_size = (num_vertices + parallelism - 1) / parallelism;
+  size_t num_ranges = (num_vertices + range_size - 1) / range_size;
+  std::vector<EdgeIndex> range_base(num_ranges + 1, 0);
+  ParallelFor(num_ranges, &pool, [&](size_t r) {
+    VertexID begin = r * range_size;
+    VertexID end = std::min(begin + range_size, num_vertices);
+    PReadFully(in_fd, degree.data() + begin,
+               (end - begin) * sizeof(VertexDegree),
+               degree_base + begin * sizeof(VertexDegree), in_path);
+    EdgeIndex sum = 0;
+    for (VertexID v = begin; v < end; v++) sum += degree[v];
+    range_base[r + 1] = sum;
+  });
+  for (size_t r = 0; r < num_ranges; r++) range_base[r + 1] += range_base[r];
+  if (range_base[num_ranges] != num_edges) {
+    LOGF_FATAL("Degrees sum up to {} edges, the metadata says {}",
+               range_base[num_ranges], num_edges);
+  }
+
+  // Block boundaries, as (first vertex, offset of its first edge).
+  EdgeIndex step = options.step_e;
+  if (step == 0) {
+    step = (num_edges + options.num_partitions - 1) / options.num_partitions;
+  }
+  step = std::max(step, (EdgeIndex)1);
+  std::vector<std::vector<std::pair<VertexID, EdgeIndex>>> range_cuts(
+      num_ranges);
+  ParallelFor(num_ranges, &pool, [&](size_t r) {
+    VertexID begin = r * range_size;
+    VertexID end = std::min(begin + range_size, num_vertices);
+    EdgeIndex offset = range_base[r];
+    for (VertexID v = begin; v < end; v++) {
+      bool cut;
+      if (options.mode == BlockPartitionOptions::kVertexEqual) {
+        cut = v % std::max(options.step_v, (VertexID)1) == 0;
+      } else {
+        // The offset of v passed a multiple of step since v - 1, and some
+        // edges are left for the block.
+        auto prev = v == 0 ? 0 : offset - degree[v - 1];
+        cut = v == 0 || (offset / step > prev / step && offset < num_edges);
+      }
+      if (cut) range_cuts[r].emplace_back(v, offset);
+      offset += degree[v];
+    }
+  });
+  std::vector<std::pair<VertexID, EdgeIndex>> bounds;
+  for (auto& cuts : range_cuts) {
+    bounds.insert(bounds.end(), cuts.begin(), cuts.end());
+  }
+  bounds.emplace_back(num_vertices, num_edges);
+  GraphID num_blocks = bounds.size() - 1;
+  LOGF_INFO("{} blocks", num_blocks);
+
+  // Block headers, index.bin files and sub-blocks.
+  core::data_structures::TwoDMetadata two_d_metadata;
+  two_d_metadata.num_vertices = num_vertices;
+  two_d_metadata.num_edges = num_edges;
+  two_d_metadata.num_blocks = num_blocks;
+  two_d_metadata.blocks.resize(num_blocks);
+  auto block_path = [&out_dir](GraphID gid) {
+    return out_dir + "blocks/" + std::to_string(gid) + ".bin";
+  };
+  auto sub_block_path = [&out_dir](GraphID gid, BlockID sid) {
+    return out_dir + "graphs/" + std::to_string(gid) + "_blocks/" +
+           std::to_string(sid) + ".bin";
+  };
+  // Offset of the edges in a block file.
+  auto header_size = [](VertexID n) {
+    return n * (sizeof(VertexDegree) + sizeof(EdgeIndex));
+  };
+  ParallelFor(num_blocks, &pool, [&](size_t gid) {
+    VertexID bid = bounds[gid].first, eid = bounds[gid + 1].first;
+    VertexID n = eid - bid;
+    EdgeIndex block_edges = bounds[gid + 1].second - bounds[gid].second;
+    std::vector<EdgeIndex> offset(n);
+    EdgeIndex sum = 0;
+    for (VertexID i = 0; i < n; i++) {
+      offset[i] = sum;
+      sum += degree[bid + i];
+    }
+    auto path = block_path(gid);
+    int fd = OpenOrDie(path, O_WRONLY | O_CREAT | O_TRUNC);
+    PWriteFully(fd, degree.data() + bid, n * sizeof(VertexDegree), 0, path);
+    PWriteFully(fd, offset.data(), n * sizeof(EdgeIndex),
+                n * sizeof(VertexDegree), path);
+    if (ftruncate(fd, header_size(n) + block_edges * sizeof(VertexID)) != 0) {
+      LOGF_FATAL("Can not resize {}", path);
+    }
+    close(fd);
+    if (!options.two_d) return;
+
+    auto& block = two_d_metadata.blocks[gid];
+    block.id = gid;
+    block.num_vertices = n;
+    block.num_edges = block_edges;
+    block.offset_ratio = options.offset_ratio;
+    block.begin_id = bid;
+    block.end_id = eid;
+    std::vector<VertexID> sub_block_bounds;
+    block.vertex_offset = core::util::CutSubBlocks(
+        n, block_edges, options.cut_v, options.sub_block_model,
+        [&degree, bid](VertexID i) { return degree[bid + i]; },
+        &sub_block_bounds);
+    fs::create_directories(out_dir + "graphs/" + std::to_string(gid) +
+                           "_blocks");
+    for (uint32_t i = 0; i + 1 < sub_block_bounds.size(); i++) {
+      VertexID begin_id = sub_block_bounds[i];
+      VertexID end_id = sub_block_bounds[i + 1];
+      EdgeIndex end_offset = end_id == n ? block_edges : offset[end_id];
+      if (end_offset - offset[begin_id] > UINT32_MAX) {
+        LOGF_FATAL("Sub-block {} of block {} has {} edges, reduce --cut_v", i,
+                   gid, end_offset - offset[begin_id]);
+      }
+      core::data_structures::SubBlock sub_block;
+      sub_block.id = i;
+      sub_block.begin_id = begin_id + bid;
+      sub_block.end_id = end_id + bid;
+      sub_block.num_edges = end_offset - offset[begin_id];
+      sub_block.num_vertices = end_id - begin_id;
+      sub_block.begin_offset = offset[begin_id];
+      block.sub_blocks.push_back(sub_block);
+      auto path = sub_block_path(gid, i);
+      int fd = OpenOrDie(path, O_WRONLY | O_CREAT | O_TRUNC);
+      if (ftruncate(fd, sub_block.num_edges * sizeof(VertexID)) != 0) {
+        LOGF_FATAL("Can not resize {}", path);
+      }
+      close(fd);
+    }
+    block.num_sub_blocks = block.sub_blocks.size();
+    auto ratio = options.offset_ratio;
+    std::vector<EdgeIndex> offset_reduce(((n - 1) / ratio) + 1);
+    for (size_t i = 0; i < offset_reduce.size(); i++) {
+      offset_reduce[i] = offset[i * ratio];
+    }
+    std::ofstream index_file(
+        out_dir + "graphs/" + std::to_string(gid) + "_blocks/index.bin",
+        std::ios::binary);
+    index_file.write((char*)offset_reduce.data(),
+                     offset_reduce.size() * sizeof(EdgeIndex));
+    index_file.write((char*)(degree.data() + bid), n * sizeof(VertexDegree));
+  });
+
+  // Copy the edges, in chunks that do not cross sub-blocks.
+  EdgeIndex chunk_edges =
+      std::max(options.chunk_size / sizeof(VertexID), (size_t)1);
+  std::vector<detail::CopyTask> copies;
+  for (GraphID gid = 0; gid < num_blocks; gid++) {
+    EdgeIndex block_edges = bounds[gid + 1].second - bounds[gid].second;
+    if (!options.two_d) {
+      for (EdgeIndex e = 0; e < block_edges; e += chunk_edges) {
+        copies.push_back(
+            {gid, 0, e, std::min(e + chunk_edges, block_edges)});
+      }
+      continue;
+    }
+    for (auto& sub_block : two_d_metadata.blocks[gid].sub_blocks) {
+      EdgeIndex end = sub_block.begin_offset + sub_block.num_edges;
+      for (EdgeIndex e = sub_block.begin_offset; e < end; e += chunk_edges) {
+        copies.push_back(
+            {gid, sub_block.id, e, std::min(e + chunk_edges, end)});
+      }
+    }
+  }
+  std::vector<int> block_fds(num_blocks);
+  for (GraphID gid = 0; gid < num_blocks; gid++) {
+    block_fds[gid] = OpenOrDie(block_path(gid), O_WRONLY);
+  }
+  ParallelFor(parallelism, &pool, [&](size_t t) {
+    std::vector<VertexID> buffer;
+    for (size_t c = t; c < copies.size(); c += parallelism) {
+      auto& copy = copies[c];
+      auto n = copy.end - copy.begin;
+      buffer.resize(n);
+      auto first = bounds[copy.gid].second + copy.begin;
+      PReadFully(in_fd, buffer.data(), n * sizeof(VertexID),
+                 edge_base + first * sizeof(VertexID), in_path);
+      VertexID block_vertices =
+          bounds[copy.gid + 1].first - bounds[copy.gid].first;
+      PWriteFully(block_fds[copy.gid], buffer.data(), n * sizeof(VertexID),
+                  header_size(block_vertices) + copy.begin * sizeof(VertexID),
+                  block_path(copy.gid));
+      if (!options.two_d) continue;
+      auto& sub_block = two_d_metadata.blocks[copy.gid].sub_blocks[copy.sid];
+      auto path = sub_block_path(copy.gid, copy.sid);
+      int fd = OpenOrDie(path, O_WRONLY);
+      PWriteFully(fd, buffer.data(), n * sizeof(VertexID),
+                  (copy.begin - sub_block.begin_offset) * sizeof(VertexID),
+                  path);
+      close(fd);
+    }
+  });
+  for (auto fd : block_fds) close(fd);
+  close(in_fd);
+  LOG_INFO("Finish writing blocks info");
+
+  std::vector<core::data_structures::BlockMetadata> block_metadata_vec;
+  for (GraphID gid = 0; gid < num_blocks; gid++) {
+    core::data_structures::BlockMetadata block_metadata;
+    block_metadata.bid = gid;
+    block_metadata.begin_id = bounds[gid].first;
+    block_metadata.end_id = bounds[gid + 1].first;
+    block_metadata.num_outgoing_edges =
+        bounds[gid + 1].second - bounds[gid].second;
+    block_metadata.num_vertices = bounds[gid + 1].first - bounds[gid].first;
+    block_metadata_vec.push_back(block_metadata);
+  }
+  graph_metadata.set_type("block");
+  graph_metadata.set_num_subgraphs(num_blocks);
+  graph_metadata.set_block_metadata_vec(block_metadata_vec);
+  YAML::Node meta;
+  meta["GraphMetadata"] = graph_metadata;
+  std::ofstream meta_file(out_dir + "meta.yaml");
+  meta_file << meta;
+  meta_file.close();
+
+  if (options.two_d) {
+    YAML::Node blocks_meta;
+    blocks_meta["GraphMetadata"] = two_d_metadata;
+    std::ofstream blocks_meta_file(out_dir + "graphs/blocks_meta.yaml");
+    blocks_meta_file << blocks_meta;
+    blocks_meta_file.close();
+  }
+  LOG_INFO("Finish writing meta file");
+}
+
+}  // namespace sics::graph::nvme::partition
+
+#endif  // GRAPH_SYSTEMS_NVME_PARTITION_PARALLEL_BLOCK_PARTITION_H_
@@ -9,7 +9,9 @@
 #include <unordered_set>
 #include <vector>
 
+#include "core/common/multithreading/thread_pool.h"
 #include "core/data_structures/graph_metadata.h"
+#include "nvme/data_structures/neighbor_hop.h"
 
 namespace sics::graph::nvme::precomputing {
 
@@ -19,6 +21,8 @@ using sics::graph::core::common::GraphID;
 using sics::graph::core::common::VertexDegree;
 using sics::graph::core::common::VertexID;
 using sics::graph::core::common::VertexIndex;
+using sics::graph::nvme::data_structures::GetNeighborInfoPath;
+using sics::graph::nvme::data_structures::GetNeighborInfoSectionSize;
 
 namespace fs = std::filesystem;
 
@@ -28,30 +32,33 @@ struct Block {
         num_edges_(num_edges),
         bid_(bid),
         eid_(eid) {}
-  void Read(const std::string& path) {
-    if (isRead_) return;
+  // Read the degrees, offsets and edges of the block.
+  void ReadTopology(const std::string& path) {
     degree_ = new VertexID[num_vertices_];
     offset_ = new EdgeIndex[num_vertices_];
     edges_ = new VertexID[num_edges_];
     std::ifstream datafile(path, std::ios::binary);
+    if (!datafile) LOGF_FATAL("Cannot open block file {}", path);
     datafile.read(reinterpret_cast<char*>(degree_),
                   num_vertices_ * sizeof(VertexID));
     datafile.read(reinterpret_cast<char*>(offset_),
                   num_vertices_ * sizeof(EdgeIndex));
     datafile.read(reinterpret_cast<char*>(edges_),
                   num_edges_ * sizeof(VertexID));
+  }
+  void Read(const std::string& path) {
+    if (isRead_) return;
+    ReadTopology(path);
     // init two_hop_neighbors_
     min_one_hop_neighbor_ = new VertexID[num_vertices_];
     max_one_hop_neighbor_ = new VertexID[num_vertices_];
     min_two_hop_neighbor_ = new VertexID[num_vertices_];
     max_two_hop_neighbor_ = new VertexID[num_vertices_];
-    has_two_hop_neighbor_.resize(num_vertices_);
     for (VertexIndex i = 0; i < num_vertices_; i++) {
       min_one_hop_neighbor_[i] = MAX_VERTEX_ID;
       max_one_hop_neighbor_[i] = i + bid_;
       min_two_hop_neighbor_[i] = MAX_VERTEX_ID;
       max_two_hop_neighbor_[i] = i + bid_;
-      has_two_hop_neighbor_[i] = false;
     }
     isRead_ = true;
   }
@@ -62,44 +69,25 @@ struct Block {
         min_one_hop_neighbor_[i] = i + bid_;
         max_one_hop_neighbor_[i] = i + bid_;
       }
-      if (!has_two_hop_neighbor_[i]) {
+      // No two-hop neighbor, as IDs are below MAX_VERTEX_ID.
+      if (min_two_hop_neighbor_[i] == MAX_VERTEX_ID) {
         min_two_hop_neighbor_[i] = i + bid_;
         max_two_hop_neighbor_[i] = i + bid_;
       }
     }
 
-    std::ofstream min_one_hop_file(
-        root_path + "precomputing/" + std::to_string(gid) + "_min_one_hop.bin",
-        std::ios::binary);
-    min_one_hop_file
-        .write(reinterpret_cast<char*>(min_one_hop_neighbor_),
-               num_vertices_ * sizeof(VertexID))
-        .flush();
-    min_one_hop_file.close();
-    std::ofstream max_one_hop_file(
-        root_path + "precomputing/" + std::to_string(gid) + "_max_one_hop.bin",
-        std::ios::binary);
-    max_one_hop_file
-        .write(reinterpret_cast<char*>(max_one_hop_neighbor_),
-               num_vertices_ * sizeof(VertexID))
-        .flush();
-    max_one_hop_file.close();
-    std::ofstream min_two_hop_file(
-        root_path + "precomputing/" + std::to_string(gid) + "_min_two_hop.bin",
-        std::ios::binary);
-    min_two_hop_file
-        .write(reinterpret_cast<char*>(min_two_hop_neighbor_),
-               num_vertices_ * sizeof(VertexID))
-        .flush();
-    min_two_hop_file.close();
-    std::ofstream max_two_hop_file(
-        root_path + "precomputing/" + std::to_string(gid) + "_max_two_hop.bin",
-        std::ios::binary);
-    max_two_hop_file
-        .write(reinterpret_cast<char*>(max_two_hop_neighbor_),
-               num_vertices_ * sizeof(VertexID))
-        .flush();
-    max_two_hop_file.close();
+    auto path = GetNeighborInfoPath(root_path, gid);
+    std::ofstream file(path, std::ios::binary);
+    auto section_size = GetNeighborInfoSectionSize(num_vertices_);
+    std::vector<char> padding(section_size - num_vertices_ * sizeof(VertexID));
+    for (auto info : {min_one_hop_neighbor_, max_one_hop_neighbor_,
+                      min_two_hop_neighbor_, max_two_hop_neighbor_}) {
+      file.write(reinterpret_cast<char*>(info),
+                 num_vertices_ * sizeof(VertexID));
+      file.write(padding.data(), padding.size());
+    }
+    if (!file) LOGF_FATAL("Write {} failed", path);
+    file.close();
 
     delete[] min_one_hop_neighbor_;
     min_one_hop_neighbor_ = nullptr;
@@ -162,7 +150,6 @@ struct Block {
         std::min(min_two_hop_neighbor_[id], two_hop_nerighbor_id);
     max_two_hop_neighbor_[id] =
         std::max(max_two_hop_neighbor_[id], two_hop_nerighbor_id);
-    has_two_hop_neighbor_[id] = true;
   }
 
   bool CheckIsOneHop(VertexID id, VertexID neighbor) {
@@ -189,7 +176,6 @@ struct Block {
   VertexID* max_one_hop_neighbor_ = nullptr;
   VertexID* min_two_hop_neighbor_ = nullptr;
   VertexID* max_two_hop_neighbor_ = nullptr;
-  std::vector<bool> has_two_hop_neighbor_;
 };
 
 struct Blocks {
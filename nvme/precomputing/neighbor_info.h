@@ -1,12 +1,58 @@
 #ifndef GRAPH_SYSTEMS_NVME_PRECOMPUTING_NEIGHBOR_INFO_H_
 #define GRAPH_SYSTEMS_NVME_PRECOMPUTING_NEIGHBOR_INFO_H_
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
 #include "core/common/bitmap.h"
 #include "core/common/multithreading/thread_pool.h"
 #include "nvme/precomputing/basic.h"
 
 namespace sics::graph::nvme::precomputing {
 
+namespace detail {
+
+// Run func(begin, end) over [0, n) in chunks of about n / num_chunks, which
+// the threads of the pool take from a shared cursor until none is left, so
+// that the chunks of hubs do not hold back a whole static share.
+template <typename Func>
+void ForEachChunk(VertexID n, size_t num_chunks, core::common::ThreadPool* pool,
+                  const Func& func) {
+  VertexID chunk = (n + num_chunks - 1) / std::max(num_chunks, (size_t)1);
+  chunk = std::max(chunk, (VertexID)1);
+  std::atomic<size_t> next(0);
+  core::common::TaskPackage tasks;
+  for (size_t i = 0; i < pool->GetParallelism(); i++) {
+    tasks.push_back([&]() {
+      while (true) {
+        size_t begin = next.fetch_add(chunk);
+        if (begin >= n) break;
+        func(begin, std::min((size_t)n, begin + chunk));
+      }
+    });
+  }
+  pool->SubmitSync(tasks);
+}
+
+}  // namespace detail
+
+// @DESCRIPTION: compute the min and max one-hop and two-hop out neighbors of
+// every vertex of the blocks at root_path, and write them to one file per
+// block, see GetNeighborInfoPath.
+//
+// Min and max compose: the two-hop bounds of a vertex are the bounds of the
+// one-hop bounds of its neighbors. So rather than joining the edges of every
+// pair of blocks, the edges are streamed twice, one block at a time while the
+// next one is read:
+//  1. the min and max neighbor of every vertex (of degree > 0) are computed
+//     from its own edges, into two arrays over all vertices;
+//  2. the neighbor info of the vertices of a block is computed from their
+//     edges and those two arrays, and written.
+// The vertices of a block are processed in chunks taken by all threads from a
+// shared cursor. Only two blocks and the two arrays (8 bytes per vertex) are
+// in memory at once.
 void ComputeNeighborInfo(const std::string& root_path,
                          uint32_t task_package_factor = 10,
                          uint32_t parallelism = 1) {
@@ -20,71 +66,83 @@ void ComputeNeighborInfo(const std::string& root_path,
 
   // read GraphMetadata
   core::data_structures::GraphMetadata graph_metadata(root_path);
-  // auto num_vertices = graph_metadata.get_num_vertices();
-  // auto num_edges = graph_metadata.get_num_edges();
+  auto num_vertices = graph_metadata.get_num_vertices();
   auto num_block = graph_metadata.get_num_blocks();
 
-  LOG_INFO("Begin counting two-hop neighbors");
+  LOG_INFO("Begin computing neighbor info");
   Blocks blocks(graph_metadata);
-  YAML::Node two_hop_info_yaml;
-  TwoHopInfos two_hop_infos;
-  two_hop_infos.infos.resize(num_block);
-
   core::common::ThreadPool pool(parallelism);
+  size_t num_chunks = (size_t)parallelism * task_package_factor;
+  auto block_path = [&root_path](GraphID gid) {
+    return root_path + "blocks/" + std::to_string(gid) + ".bin";
+  };
 
-  for (GraphID i = 0; i < num_block; i++) {
-    auto& block = blocks.blocks[i];
-    block.Read(root_path + "blocks/" + std::to_string(i) + ".bin");
-  }
+  // Visit the blocks in order, reading the next one while the current one is
+  // processed.
+  auto for_each_block = [&](bool with_info, auto&& func) {
+    auto read = [&](GraphID gid) {
+      auto& block = blocks.blocks[gid];
+      with_info ? block.Read(block_path(gid))
+                : block.ReadTopology(block_path(gid));
+    };
+    if (num_block == 0) return;
+    auto pending = std::async(std::launch::async, read, 0);
+    for (GraphID gid = 0; gid < num_block; gid++) {
+      pending.get();
+      if (gid + 1 < num_block) {
+        pending = std::async(std::launch::async, read, gid + 1);
+      }
+      func(gid, blocks.blocks[gid]);
+      blocks.blocks[gid].Release();
+    }
+  };
 
-  // iter block i to join block j
-  for (GraphID i = 0; i < num_block; i++) {
-    LOGF_INFO("== Processing block: {} ==", i);
-    auto& block_i = blocks.blocks.at(i);
-    core::common::TaskPackage tasks;
-    // iter block j for the join of block i
-    auto task_num = parallelism * task_package_factor;
-    auto task_size = (block_i.num_vertices_ + task_num - 1) / task_num;
-    LOGF_INFO("task size: {}", task_size);
-    // iter vertex in block i
-    VertexID k = 0;
-    while (k < block_i.num_vertices_) {
-      auto b_k = k;
-      auto e_k = std::min(k + task_size, block_i.num_vertices_);
-      auto task = [&blocks, &block_i, b_k, e_k]() {
-        auto idx = 0;
-        for (auto k = b_k; k < e_k; k++) {
-          auto degree_k = block_i.degree_[k];
-          if (degree_k == 0) continue;
-          auto one_hop_edges = block_i.GetEdges(k);
-          for (VertexID l = 0; l < degree_k; l++) {
-            auto hop_1 = one_hop_edges[l];
-            block_i.UpdateOneHopInfo(k, hop_1);
-            auto block_j_id = blocks.GetBlockID(hop_1);
-            auto& block_j = blocks.blocks.at(block_j_id);
-            auto degree_2 = block_j.GetDegreeByID(hop_1);
-            if (degree_2 == 0) continue;
-            auto two_hop_edges = block_j.GetEdgesByID(hop_1);
-            for (VertexDegree m = 0; m < degree_2; m++) {
-              block_i.UpdateTwoHopInfo(k, two_hop_edges[m]);
+  // Min and max neighbor of every vertex, or MAX_VERTEX_ID and 0 if it has
+  // none.
+  std::vector<VertexID> min_neighbor(num_vertices, MAX_VERTEX_ID);
+  std::vector<VertexID> max_neighbor(num_vertices, 0);
+  for_each_block(false, [&](GraphID gid, Block& block) {
+    LOGF_INFO("== One-hop pass of block: {} ==", gid);
+    detail::ForEachChunk(
+        block.num_vertices_, num_chunks, &pool, [&](VertexID b, VertexID e) {
+          for (VertexID k = b; k < e; k++) {
+            auto edges = block.GetEdges(k);
+            auto degree = block.GetDegree(k);
+            // Branch-free, so that it vectorizes.
+            VertexID min_id = MAX_VERTEX_ID, max_id = 0;
+            for (VertexDegree l = 0; l < degree; l++) {
+              min_id = std::min(min_id, edges[l]);
+              max_id = std::max(max_id, edges[l]);
             }
+            min_neighbor[block.bid_ + k] = min_id;
+            max_neighbor[block.bid_ + k] = max_id;
           }
-          idx++;
-          if (idx % 10000 == 0) {
-            LOGF_INFO("{}->{}: Processed {} vertices", b_k, e_k, idx);
-          }
-        }
-      };
-      tasks.push_back(task);
-      k = e_k;
-    }
-    LOGF_INFO("Task num: {}", tasks.size());
-    pool.SubmitSync(tasks);
+        });
+  });
 
-    LOG_INFO("Begin write two-hop info to disk");
-    // write two-hop info of block i to disk
-    block_i.Write(root_path, i, &pool);
-  }
+  for_each_block(true, [&](GraphID gid, Block& block) {
+    LOGF_INFO("== Two-hop pass of block: {} ==", gid);
+    detail::ForEachChunk(
+        block.num_vertices_, num_chunks, &pool, [&](VertexID b, VertexID e) {
+          for (VertexID k = b; k < e; k++) {
+            auto id = block.bid_ + k;
+            block.min_one_hop_neighbor_[k] = min_neighbor[id];
+            block.max_one_hop_neighbor_[k] = std::max(id, max_neighbor[id]);
+            auto edges = block.GetEdges(k);
+            auto degree = block.GetDegree(k);
+            VertexID min_id = MAX_VERTEX_ID, max_id = id;
+            for (VertexDegree l = 0; l < degree; l++) {
+              // A neighbor without neighbors has MAX_VERTEX_ID and 0 here,
+              // which change neither bound.
+              min_id = std::min(min_id, min_neighbor[edges[l]]);
+              max_id = std::max(max_id, max_neighbor[edges[l]]);
+            }
+            block.min_two_hop_neighbor_[k] = min_id;
+            block.max_two_hop_neighbor_[k] = max_id;
+          }
+        });
+    block.Write(root_path, gid, &pool);
+  });
   LOG_INFO("Two-hop neighbors are precomputed.");
 }
 
@@ -101,24 +101,19 @@ int main(int argc, char** argv) {
       auto num_vertices = block_metadata.num_vertices;
 
       std::ifstream data_file(
-          root_path + "precomputing/" + std::to_string(i) + "_min_one_hop.bin",
+          sics::graph::nvme::precomputing::GetNeighborInfoPath(root_path, i),
           std::ios::binary);
-      data_file.seekg(0, std::ios::end);
-      size_t file_size = data_file.tellg();
-      data_file.seekg(0, std::ios::beg);
-      auto data_all = new char[file_size];
-      data_file.read(data_all, file_size);
-      VertexID* min_one_hop_addr = (VertexID*)(data_all);
-
-      std::ifstream data_file2(
-          root_path + "precomputing/" + std::to_string(i) + "_max_one_hop.bin",
-          std::ios::binary);
-      data_file2.seekg(0, std::ios::end);
-      size_t file_size2 = data_file2.tellg();
-      data_file2.seekg(0, std::ios::beg);
-      auto data_all2 = new char[file_size2];
-      data_file2.read(data_all2, file_size2);
-      VertexID* max_one_hop_addr = (VertexID*)(data_all2);
+      auto section = sics::graph::nvme::data_structures::
+                         GetNeighborInfoSectionSize(num_vertices) /
+                     sizeof(VertexID);
+      std::vector<VertexID> data_all(4 * section);
+      data_file.read((char*)data_all.data(),
+                     data_all.size() * sizeof(VertexID));
+      if (!data_file) LOGF_FATAL("Error reading neighbor info of block {}", i);
+      VertexID* min_one_hop_addr = data_all.data();
+      VertexID* max_one_hop_addr = min_one_hop_addr + section;
+      auto min_two_hop_addr = max_one_hop_addr + section;
+      auto max_two_hop_addr = min_two_hop_addr + section;
 
       LOG_INFO("One Hop Infos =============");
       for (size_t idx = 0; idx < num_vertices; idx++) {
@@ -130,26 +125,6 @@ int main(int argc, char** argv) {
       }
 
       LOG_INFO("two Hop Infos =============");
-      // read the file of two hop
-      std::ifstream data_file3(
-          root_path + "precomputing/" + std::to_string(i) + "_min_two_hop.bin",
-          std::ios::binary);
-      data_file3.seekg(0, std::ios::end);
-      size_t file_size3 = data_file3.tellg();
-      data_file3.seekg(0, std::ios::beg);
-      auto data_all3 = new char[file_size3];
-      data_file3.read(data_all3, file_size3);
-      auto min_two_hop_addr = (VertexID*)(data_all3);
-
-      std::ifstream data_file4(
-          root_path + "precomputing/" + std::to_string(i) + "_max_two_hop.bin",
-          std::ios::binary);
-      data_file4.seekg(0, std::ios::end);
-      size_t file_size4 = data_file4.tellg();
-      data_file4.seekg(0, std::ios::beg);
-      auto data_all4 = new char[file_size4];
-      data_file4.read(data_all4, file_size4);
-      auto max_two_hop_addr = (VertexID*)(data_all4);
       for (VertexIndex idx = 0; idx < num_vertices; idx++) {
         auto id = idx + begin_id;
         auto min_two_hop = min_two_hop_addr[idx];
@@ -17,6 +17,9 @@ DEFINE_uint32(iter, 3, "pagerank iteration");
 DEFINE_uint32(l, 4, "pagerank iteration");
 DEFINE_uint32(k, 1, "pagerank iteration");
 DEFINE_string(mode, "float", "pagerank mode (float or int)");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -41,6 +44,9 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->gnn_l = FLAGS_l;
   core::common::Configurations::GetMutable()->gnn_k = FLAGS_k;
   core::common::Configurations::GetMutable()->sync = false;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   if (FLAGS_mode == "float") {
     LOG_INFO("System begin GNN float");
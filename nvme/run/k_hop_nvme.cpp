@@ -13,6 +13,9 @@ DEFINE_uint32(memory_size, 64, "memory size (GB)");
 DEFINE_uint32(limits, 0, "subgrah limits for pre read");
 DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_uint32(task_size, 500000, "task size");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -33,6 +36,9 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->task_size = FLAGS_task_size;
   core::common::Configurations::GetMutable()->vertex_data_type =
       core::common::VertexDataType::kVertexDataTypeUInt32;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
 
@@ -0,0 +1,46 @@
+#include <gflags/gflags.h>
+
+#include "core/common/config.h"
+#include "core/planar_system.h"
+#include "nvme/apps/lpa_nvme_app.h"
+
+DEFINE_string(i, "/testfile", "graph files root path");
+DEFINE_uint32(p, 1, "parallelism");
+DEFINE_uint32(task_package_factor, 50, "task package factor");
+DEFINE_uint32(memory_size, 64, "memory size (GB)");
+DEFINE_bool(in_memory, false, "in memory mode");
+DEFINE_uint32(task_size, 500000, "task size");
+DEFINE_uint32(iter, 10, "maximum number of iterations");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  core::common::Configurations::GetMutable()->root_path = FLAGS_i;
+  core::common::Configurations::GetMutable()->parallelism = FLAGS_p;
+  core::common::Configurations::GetMutable()->task_package_factor =
+      FLAGS_task_package_factor;
+  core::common::Configurations::GetMutable()->memory_size =
+      FLAGS_memory_size * 1024;
+  core::common::Configurations::GetMutable()->in_memory = FLAGS_in_memory;
+
+  // label propagation nvme specific configurations
+  core::common::Configurations::GetMutable()->application =
+      core::common::LabelPropagation;
+  core::common::Configurations::GetMutable()->is_block_mode = true;
+  core::common::Configurations::GetMutable()->task_size = FLAGS_task_size;
+  core::common::Configurations::GetMutable()->lpa_iter = FLAGS_iter;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
+
+  LOG_INFO("System begin");
+
+  nvme::apps::LpaNvmeApp app(FLAGS_i);
+  app.Run();
+  return 0;
+}
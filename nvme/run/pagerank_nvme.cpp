@@ -14,6 +14,11 @@ DEFINE_uint32(limits, 0, "subgrah limits for pre read");
 DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_uint32(task_size, 500000, "task size");
 DEFINE_uint32(iter, 10, "pagerank iteration");
+DEFINE_uint32(hub_degree, 65536,
+             "split vertices with more out edges into edge range tasks");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -36,6 +41,10 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->vertex_data_type =
       core::common::VertexDataType::kVertexDataTypeFloat;
   core::common::Configurations::GetMutable()->pr_iter = FLAGS_iter;
+  core::common::Configurations::GetMutable()->hub_degree = FLAGS_hub_degree;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   nvme::apps::PageRankVCApp app(FLAGS_i);
@@ -1,11 +1,12 @@
 #include <gflags/gflags.h>
 
 #include "core/planar_system.h"
-#include "nvme/partition/edge_equal_block_partition.h"
-#include "nvme/partition/vertex_equal_block_partition.h"
+#include "nvme/partition/parallel_block_partition.h"
 #include "nvme/precomputing/neighbor_info.h"
 #include "nvme/precomputing/two_hop_neighbor.h"
 
+using sics::graph::nvme::partition::BlockPartitionOptions;
+
 DEFINE_string(i, "/testfile", "graph files root path");
 DEFINE_string(o, "/", "output dir for block files");
 DEFINE_uint32(p, 8, "parallelism");
@@ -13,6 +14,15 @@ DEFINE_uint32(n, 1, "number of partition");
 DEFINE_string(mode, "vertex", "vertex or edge");
 DEFINE_uint32(step_v, 500000, "vertex step for block");
 DEFINE_uint32(step_e, 0, "vertex step for block");
+DEFINE_bool(two_d, false,
+            "also write the sub-block layout (graphs/<gid>_blocks/ and "
+            "graphs/blocks_meta.yaml) of the blocks");
+DEFINE_uint32(cut_v, 500000, "maximum number of vertices of a sub-block");
+DEFINE_uint32(offset_ratio, 64, "offset compress ratio of the sub-blocks");
+DEFINE_uint64(sub_block_kb, 0,
+              "target size in KB of a sub-block, 0 to cut them by cut_v");
+DEFINE_uint64(min_sub_block_kb, 1024, "minimum size in KB of a sub-block");
+DEFINE_uint32(tasks_per_thread, 4, "sub-blocks per thread of a block");
 DEFINE_bool(precomputing, false, "precomputing mode");
 DEFINE_uint32(task_package_factor, 10, "task package factor");
 
@@ -35,13 +45,27 @@ int main(int argc, char** argv) {
              num_partitions);
   }
 
+  BlockPartitionOptions options;
+  options.num_partitions = num_partitions;
+  options.step_e = step_e;
+  options.step_v = step_v;
+  options.parallelism = parallelism;
+  options.two_d = FLAGS_two_d;
+  options.cut_v = FLAGS_cut_v;
+  options.offset_ratio = FLAGS_offset_ratio;
+  options.sub_block_model.target_bytes = FLAGS_sub_block_kb << 10;
+  options.sub_block_model.min_bytes = FLAGS_min_sub_block_kb << 10;
+  options.sub_block_model.parallelism = parallelism;
+  options.sub_block_model.tasks_per_thread = FLAGS_tasks_per_thread;
   if (FLAGS_mode == "edge") {
     // use edge equal block partition
-    sics::graph::nvme::partition::EdgeEqualBlockPartition(
-        root_path, out_dir, num_partitions, parallelism, step_e);
+    options.mode = BlockPartitionOptions::kEdgeEqual;
+    sics::graph::nvme::partition::ParallelBlockPartition(root_path, out_dir,
+                                                         options);
   } else if (FLAGS_mode == "vertex") {
-    sics::graph::nvme::partition::VertexEqualBlockPartition(
-        root_path, out_dir, num_partitions, parallelism, step_v);
+    options.mode = BlockPartitionOptions::kVertexEqual;
+    sics::graph::nvme::partition::ParallelBlockPartition(root_path, out_dir,
+                                                         options);
   }
 
   if (FLAGS_precomputing) {
@@ -14,6 +14,9 @@ DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_uint32(task_size, 500000, "task size");
 DEFINE_uint32(iter, 10, "pagerank iteration");
 DEFINE_bool(pram, false, "pagerank async mode");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -36,6 +39,9 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->vertex_data_type =
       core::common::VertexDataType::kVertexDataTypeFloat;
   core::common::Configurations::GetMutable()->pr_iter = FLAGS_iter;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
 
@@ -15,6 +15,15 @@ DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_uint32(task_size, 500000, "task size");
 DEFINE_bool(use_graft_vertex, false, "use graft vertex");
 DEFINE_bool(use_two_hop, false, "use two hop info");
+DEFINE_uint32(write_back_depth, 8, "blocks written back at once");
+DEFINE_bool(sync_write_back, false,
+            "sync the blocks written back before replacing the old ones");
+DEFINE_double(mutation_log_ratio, 0.25,
+              "log the deleted edges of a block until the log exceeds this "
+              "ratio of the block size, 0 to always write blocks in full");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -36,6 +45,15 @@ int main(int argc, char** argv) {
       core::common::VertexDataType::kVertexDataTypeUInt32;
   core::common::Configurations::GetMutable()->use_graft_vertex =
       FLAGS_use_graft_vertex;
+  core::common::Configurations::GetMutable()->write_back_depth =
+      FLAGS_write_back_depth;
+  core::common::Configurations::GetMutable()->sync_write_back =
+      FLAGS_sync_write_back;
+  core::common::Configurations::GetMutable()->mutation_log_ratio =
+      FLAGS_mutation_log_ratio;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   if (!FLAGS_use_two_hop) {
     LOG_INFO("System begin");
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/common/config.h"
+#include "core/common/ready_set.h"
 #include "core/common/types.h"
 #include "core/data_structures/graph/serialized_mutable_csr_graph.h"
 #include "core/data_structures/serializable.h"
@@ -32,63 +33,80 @@ struct GraphState {
     graphs_.resize(num_subgraphs);
     current_round_pending_.resize(num_subgraphs, true);
     block_mutate_state_.resize(num_subgraphs, false);
+    for (auto& pending : pending_in_state_) pending.Init(num_subgraphs);
+    pending_in_state_[OnDisk].Fill();
+    num_in_state_[OnDisk] = num_subgraphs;
+    num_pending_ = num_subgraphs;
   }
 
   void ResetCurrentRoundPending() {
     // all blocks should be iterated in current round
     for (size_t i = 0; i < num_blocks_; ++i) {
-      current_round_pending_.at(i) = true;
+      SetPending(i, true);
     }
   }
 
+  // The first block pending in the current round and in state `type`, or
+  // INVALID_GRAPH_ID if there is none.
+  core::common::GraphID GetFirstPending(StorageStateType type) const {
+    auto gid = pending_in_state_[type].FindNext();
+    return gid < num_blocks_ ? gid : INVALID_GRAPH_ID;
+  }
+
+  size_t GetNumPending() const { return num_pending_; }
+
+  size_t GetNumInState(StorageStateType type) const {
+    return num_in_state_[type];
+  }
+
   StorageStateType GetSubgraphState(core::common::GraphID gid) const {
     return subgraph_storage_state_.at(gid);
   }
 
   void SetOnDiskToSerialized(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Serialized;
+    SetState(gid, Serialized);
   }
 
   void SetOnDiskToReading(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Reading;
+    SetState(gid, Reading);
   }
 
   void SetReadingToSerialized(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Serialized;
+    SetState(gid, Serialized);
   }
 
   void SetSerializedToDeserialized(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Deserialized;
+    SetState(gid, Deserialized);
   }
 
   void SetDeserializedToComputed(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Computed;
-    current_round_pending_.at(gid) = false;
+    SetState(gid, Computed);
+    SetPending(gid, false);
   }
 
   void SetComputedToSerialized(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Serialized;
+    SetState(gid, Serialized);
   }
 
   void SetSerializedToOnDisk(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = OnDisk;
+    SetState(gid, OnDisk);
   }
 
   void SetComputedSerializedToReadSerialized(core::common::GraphID gid) {
-    subgraph_storage_state_.at(gid) = Serialized;
+    SetState(gid, Serialized);
   }
 
   void SetGraphState(core::common::GraphID gid, StorageStateType type) {
-    subgraph_storage_state_.at(gid) = type;
+    SetState(gid, type);
   }
 
   void SetCurrentRoundPendingFinish(core::common::GraphID gid) {
-    current_round_pending_.at(gid) = false;
+    SetPending(gid, false);
   }
 
   void SyncCurrentRoundPending() {
     for (size_t i = 0; i < num_blocks_; i++) {
-      current_round_pending_.at(i) = true;
+      SetPending(i, true);
     }
   }
 
@@ -115,12 +133,34 @@ struct GraphState {
   // release unique_ptr of serializable graph
 //  void ReleaseSubgraph(core::common::GraphID gid) { graphs_.at(gid).reset(); }
 
+ private:
+  void SetState(core::common::GraphID gid, StorageStateType type) {
+    auto& state = subgraph_storage_state_.at(gid);
+    if (current_round_pending_.at(gid)) {
+      pending_in_state_[state].Erase(gid);
+      pending_in_state_[type].Insert(gid);
+    }
+    num_in_state_[state]--;
+    num_in_state_[type]++;
+    state = type;
+  }
+
+  void SetPending(core::common::GraphID gid, bool pending) {
+    if (current_round_pending_.at(gid) == pending) return;
+    current_round_pending_.at(gid) = pending;
+    auto state = subgraph_storage_state_.at(gid);
+    if (pending) {
+      pending_in_state_[state].Insert(gid);
+      num_pending_++;
+    } else {
+      pending_in_state_[state].Erase(gid);
+      num_pending_--;
+    }
+  }
+
  public:
   size_t num_blocks_;
-  std::vector<StorageStateType> subgraph_storage_state_;
 
-  // label for if current round graph is executed
-  std::vector<bool> current_round_pending_;
   std::vector<int> round_;
   std::vector<bool> block_mutate_state_;
   // memory size and graph size
@@ -129,6 +169,17 @@ struct GraphState {
   const size_t memory_size_;
 
  private:
+  // Written only by SetState and SetPending, which keep the indices below in
+  // sync, so that the scheduler finds the next block without a scan.
+  std::vector<StorageStateType> subgraph_storage_state_;
+  // label for if current round graph is executed
+  std::vector<bool> current_round_pending_;
+  // The blocks pending in the current round, by state, indexed by the values
+  // of StorageStateType, which start at 1.
+  core::common::ReadySet pending_in_state_[Writing + 1];
+  size_t num_in_state_[Writing + 1] = {};
+  size_t num_pending_ = 0;
+
   std::vector<std::unique_ptr<core::data_structures::Serializable>> graphs_;
 };
 }  // namespace sics::graph::nvme::scheduler
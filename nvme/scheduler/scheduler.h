@@ -150,6 +150,13 @@ class PramScheduler {
     message_hub_.get_response_queue()->Push(scheduler::Message(execute_msg));
   }
 
+  // Restrict the next map to the blocks set in `blocks`. The others are done
+  // for that round before it starts, so they are neither read nor executed.
+  // Call it before RunMapExecute, which hands it to the scheduler thread.
+  void SetNextMapBlocks(std::vector<bool> blocks) {
+    next_map_blocks_ = std::move(blocks);
+  }
+
   size_t GetGraphEdges() const { return graph_metadata_info_.get_num_edges(); }
 
   const core::data_structures::GraphMetadata& GetGraphMetadata() {
@@ -175,6 +182,22 @@ class PramScheduler {
     return graph->GetOutEdgesByID(id);
   }
 
+  // Edges of `id` in the block holding it, which need not be the current
+  // one. nullptr if that block is not in memory.
+  const VertexID* GetResidentEdges(VertexID id, VertexDegree* degree) {
+    for (GraphID bid = 0; bid < graph_metadata_info_.get_num_subgraphs();
+         bid++) {
+      if (id >= graph_metadata_info_.GetBlockMetadata(bid).end_id) continue;
+      if (graph_state_.GetSubgraphState(bid) != GraphState::Deserialized) {
+        return nullptr;
+      }
+      auto graph = static_cast<BlockCSRGraph*>(GetBlock(bid));
+      *degree = graph->GetOutDegreeByID(id);
+      return graph->GetOutEdgesByID(id);
+    }
+    return nullptr;
+  }
+
  protected:
   virtual bool ReadMessageResponseAndExecute(const ReadMessage& read_resp) {
     // Read finish, to execute the loaded graph.
@@ -208,6 +231,18 @@ class PramScheduler {
           LOG_ERROR("Map type is not supported!");
           break;
       }
+      if (!next_map_blocks_.empty()) {
+        for (GraphID bid = 0; bid < next_map_blocks_.size(); bid++) {
+          if (!next_map_blocks_[bid]) {
+            graph_state_.SetCurrentRoundPendingFinish(bid);
+          }
+        }
+        next_map_blocks_.clear();
+        if (IsCurrentRoundFinish()) {
+          FinishMap();
+          return true;
+        }
+      }
       // Read first block.
       if (in_memory_) {
         // If in-memory mode, first round read, than keep the block in memory.
@@ -229,12 +264,7 @@ class PramScheduler {
         SendWriteMessage(execute_resp.graph_id);  // Write back to disk.
       }
       if (IsCurrentRoundFinish()) {
-        graph_state_.ResetCurrentRoundPending();
-        update_store_->Sync();
-        step_++;
-        ResetMapFunction();
-        // Return current map function scheduling.
-        UnlockAndReleaseResult();
+        FinishMap();
       } else {
         ExecuteNextGraphInMemory();
       }
@@ -324,69 +354,29 @@ class PramScheduler {
   }
 
   GraphID GetNextReadGraphInCurrentRound() const {
-    for (GraphID gid = 0; gid < graph_metadata_info_.get_num_subgraphs();
-         gid++) {
-      if (graph_state_.current_round_pending_.at(gid) &&
-          graph_state_.subgraph_storage_state_.at(gid) == GraphState::OnDisk) {
-        return gid;
-      }
-    }
-    return INVALID_GRAPH_ID;
+    return graph_state_.GetFirstPending(GraphState::OnDisk);
   }
 
   GraphID GetNextExecuteGraph() const {
-    for (GraphID gid = 0; gid < graph_metadata_info_.get_num_subgraphs();
-         gid++) {
-      if (graph_state_.current_round_pending_.at(gid) &&
-          graph_state_.subgraph_storage_state_.at(gid) ==
-              GraphState::StorageStateType::Serialized) {
-        return gid;
-      }
-    }
-    return INVALID_GRAPH_ID;
+    return graph_state_.GetFirstPending(GraphState::Serialized);
   }
 
   GraphID GetNextExecuteGraphInMemory() const {
-    for (GraphID gid = 0; gid < graph_metadata_info_.get_num_subgraphs();
-         gid++) {
-      if (graph_state_.current_round_pending_.at(gid) &&
-          graph_state_.subgraph_storage_state_.at(gid) ==
-              GraphState::StorageStateType::Deserialized) {
-        return gid;
-      }
-    }
-    return INVALID_GRAPH_ID;
+    return graph_state_.GetFirstPending(GraphState::Deserialized);
   }
 
   size_t GetLeftPendingGraphNums() const {
-    size_t res = 0;
-    for (GraphID gid = 0; gid < graph_metadata_info_.get_num_subgraphs();
-         gid++) {
-      if (graph_state_.current_round_pending_.at(gid)) {
-        res++;
-      }
-    }
-    return res;
+    return graph_state_.GetNumPending();
   }
 
   bool IsCurrentRoundFinish() const {
-    for (GraphID i = 0; i < graph_metadata_info_.get_num_subgraphs(); i++) {
-      if (graph_state_.current_round_pending_.at(i)) {
-        return false;
-      }
-    }
-    return true;
+    return graph_state_.GetNumPending() == 0;
   }
 
   // If current and next round both have no graph to read, system stop.
   bool IsSchedulerStop() const {
-    for (GraphID i = 0; i < graph_metadata_info_.get_num_subgraphs(); i++) {
-      if (graph_state_.subgraph_storage_state_.at(i) !=
-          GraphState::StorageStateType::OnDisk) {
-        return false;
-      }
-    }
-    return true;
+    return graph_state_.GetNumInState(GraphState::OnDisk) ==
+           graph_metadata_info_.get_num_subgraphs();
   }
 
   void SetExecuteMessageMapFunction(ExecuteMessage* message) {
@@ -412,6 +402,15 @@ class PramScheduler {
     }
   }
 
+  void FinishMap() {
+    graph_state_.ResetCurrentRoundPending();
+    update_store_->Sync();
+    step_++;
+    ResetMapFunction();
+    // Return current map function scheduling.
+    UnlockAndReleaseResult();
+  }
+
   void ResetMapFunction() {
     current_Map_type_ = MapType::kDefault;
     func_vertex_ = nullptr;
@@ -507,6 +506,8 @@ class PramScheduler {
   core::common::GraphID current_bid_ = 0;
 
   size_t step_ = 0;
+  // Blocks of the next map, all if empty. See SetNextMapBlocks.
+  std::vector<bool> next_map_blocks_;
 
   size_t memory_left_size_;
   int limits_ = 0;
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "nvme/partition/parallel_block_partition.h"
+
+namespace sics::graph::nvme::partition {
+
+// The fixture for testing the parallel block partitioner.
+class BlockPartitionTest : public ::testing::Test {
+ protected:
+  BlockPartitionTest() {
+    std::filesystem::create_directories(root_ + "graphs");
+    std::mt19937 rng(11);
+    for (VertexID v = 0; v < kNumVertices; v++) {
+      // Skewed degrees, with some isolated vertices.
+      degree_.push_back(v % 7 == 3 ? 0 : rng() % (v % 50 == 0 ? 200 : 20));
+      for (VertexDegree i = 0; i < degree_.back(); i++) {
+        edges_.push_back(rng() % kNumVertices);
+      }
+    }
+    // graphs/0.bin: global IDs, degrees, offsets, edges.
+    std::vector<VertexID> ids(kNumVertices);
+    std::vector<EdgeIndex> offset(kNumVertices);
+    EdgeIndex sum = 0;
+    for (VertexID v = 0; v < kNumVertices; v++) {
+      ids[v] = v;
+      offset[v] = sum;
+      sum += degree_[v];
+    }
+    std::ofstream graph(root_ + "graphs/0.bin", std::ios::binary);
+    graph.write((char*)ids.data(), kNumVertices * sizeof(VertexID));
+    graph.write((char*)degree_.data(), kNumVertices * sizeof(VertexDegree));
+    graph.write((char*)offset.data(), kNumVertices * sizeof(EdgeIndex));
+    graph.write((char*)edges_.data(), edges_.size() * sizeof(VertexID));
+
+    YAML::Node subgraph;
+    subgraph["gid"] = 0;
+    subgraph["num_vertices"] = kNumVertices;
+    subgraph["num_incoming_edges"] = 0;
+    subgraph["num_outgoing_edges"] = edges_.size();
+    subgraph["max_vid"] = kNumVertices - 1;
+    subgraph["min_vid"] = 0;
+    YAML::Node meta;
+    meta["GraphMetadata"]["num_vertices"] = kNumVertices;
+    meta["GraphMetadata"]["num_edges"] = edges_.size();
+    meta["GraphMetadata"]["max_vid"] = kNumVertices - 1;
+    meta["GraphMetadata"]["min_vid"] = 0;
+    meta["GraphMetadata"]["count_border_vertices"] = 0;
+    meta["GraphMetadata"]["num_subgraphs"] = 1;
+    meta["GraphMetadata"]["subgraphs"].push_back(subgraph);
+    std::ofstream meta_file(root_ + "meta.yaml");
+    meta_file << meta;
+  }
+
+  ~BlockPartitionTest() override { std::filesystem::remove_all(root_); }
+
+  // Check that blocks/<gid>.bin hold the degrees, offsets and edges of the
+  // vertices of every block.
+  void ExpectBlocks(const std::string& out_dir) {
+    auto meta = YAML::LoadFile(out_dir + "meta.yaml")["GraphMetadata"];
+    auto blocks = meta["blocks"];
+    VertexID next_id = 0;
+    EdgeIndex next_edge = 0;
+    for (size_t gid = 0; gid < blocks.size(); gid++) {
+      auto begin_id = blocks[gid]["begin_id"].as<VertexID>();
+      auto end_id = blocks[gid]["end_id"].as<VertexID>();
+      auto num_edges = blocks[gid]["num_outgoing_edges"].as<EdgeIndex>();
+      EXPECT_EQ(begin_id, next_id);
+      VertexID n = end_id - begin_id;
+      std::vector<VertexDegree> degree(n);
+      std::vector<EdgeIndex> offset(n);
+      std::vector<VertexID> edges(num_edges);
+      std::ifstream file(out_dir + "blocks/" + std::to_string(gid) + ".bin",
+                         std::ios::binary);
+      file.read((char*)degree.data(), n * sizeof(VertexDegree));
+      file.read((char*)offset.data(), n * sizeof(EdgeIndex));
+      file.read((char*)edges.data(), num_edges * sizeof(VertexID));
+      EXPECT_TRUE(file.good());
+      EdgeIndex sum = 0;
+      for (VertexID i = 0; i < n; i++) {
+        EXPECT_EQ(degree[i], degree_[begin_id + i]);
+        EXPECT_EQ(offset[i], sum);
+        sum += degree[i];
+      }
+      EXPECT_EQ(sum, num_edges);
+      for (EdgeIndex e = 0; e < num_edges; e++) {
+        ASSERT_EQ(edges[e], edges_[next_edge + e]);
+      }
+      next_id = end_id;
+      next_edge += num_edges;
+    }
+    EXPECT_EQ(next_id, kNumVertices);
+    EXPECT_EQ(next_edge, edges_.size());
+  }
+
+  static constexpr VertexID kNumVertices = 3000;
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/block_partition_test_" + std::to_string(getpid()) +
+                      "/";
+  std::vector<VertexDegree> degree_;
+  std::vector<VertexID> edges_;
+};
+
+TEST_F(BlockPartitionTest, EdgeEqualBlocksWithSubBlocks) {
+  BlockPartitionOptions options;
+  options.num_partitions = 5;
+  options.parallelism = 4;
+  options.two_d = true;
+  options.cut_v = 128;
+  options.offset_ratio = 16;
+  options.chunk_size = 256;
+  ParallelBlockPartition(root_, root_, options);
+  ExpectBlocks(root_);
+
+  core::data_structures::TwoDMetadata meta(root_);
+  EXPECT_LE(meta.num_blocks, 5);
+  EXPECT_GE(meta.num_blocks, 4);
+  EdgeIndex share = (edges_.size() + 4) / 5;
+  EdgeIndex next_edge = 0;
+  for (auto& block : meta.blocks) {
+    // A block overshoots its share by less than one vertex.
+    EXPECT_LT(block.num_edges, share + 200);
+    auto dir = root_ + "graphs/" + std::to_string(block.id) + "_blocks/";
+    std::vector<EdgeIndex> offset_reduce((block.num_vertices - 1) / 16 + 1);
+    std::ifstream index(dir + "index.bin", std::ios::binary);
+    index.read((char*)offset_reduce.data(),
+               offset_reduce.size() * sizeof(EdgeIndex));
+    EdgeIndex offset = 0;
+    for (VertexID i = 0; i < block.num_vertices; i++) {
+      if (i % 16 == 0) EXPECT_EQ(offset_reduce[i / 16], offset);
+      offset += degree_[block.begin_id + i];
+    }
+    for (auto& sub_block : block.sub_blocks) {
+      EXPECT_LE(sub_block.num_vertices, 128);
+      std::vector<VertexID> edges(sub_block.num_edges);
+      std::ifstream file(dir + std::to_string(sub_block.id) + ".bin",
+                         std::ios::binary);
+      file.read((char*)edges.data(), edges.size() * sizeof(VertexID));
+      EXPECT_TRUE(file.good());
+      for (size_t e = 0; e < edges.size(); e++) {
+        ASSERT_EQ(edges[e], edges_[next_edge + sub_block.begin_offset + e]);
+      }
+    }
+    next_edge += block.num_edges;
+  }
+  EXPECT_EQ(next_edge, edges_.size());
+}
+
+TEST_F(BlockPartitionTest, SubBlocksSizedByCostModel) {
+  BlockPartitionOptions options;
+  options.num_partitions = 2;
+  options.parallelism = 4;
+  options.two_d = true;
+  options.sub_block_model.target_bytes = 300 * sizeof(VertexID);
+  options.sub_block_model.min_bytes = 0;
+  ParallelBlockPartition(root_, root_, options);
+  ExpectBlocks(root_);
+
+  core::data_structures::TwoDMetadata meta(root_);
+  for (auto& block : meta.blocks) {
+    EXPECT_EQ(block.vertex_offset, 0);
+    VertexID next_id = block.begin_id;
+    for (auto& sub_block : block.sub_blocks) {
+      EXPECT_EQ(sub_block.begin_id, next_id);
+      next_id = sub_block.end_id;
+      // Only a hub, alone in its sub-block, may exceed the target.
+      if (sub_block.num_vertices > 1) EXPECT_LE(sub_block.num_edges, 300);
+      for (auto v = sub_block.begin_id; v < sub_block.end_id; v++) {
+        if (degree_[v] >= 150) EXPECT_EQ(sub_block.num_vertices, 1);
+      }
+    }
+    EXPECT_EQ(next_id, block.end_id);
+  }
+}
+
+TEST_F(BlockPartitionTest, VertexEqualBlocks) {
+  BlockPartitionOptions options;
+  options.mode = BlockPartitionOptions::kVertexEqual;
+  options.step_v = 700;
+  options.parallelism = 3;
+  options.chunk_size = 1000;
+  ParallelBlockPartition(root_, root_, options);
+  ExpectBlocks(root_);
+  auto meta = YAML::LoadFile(root_ + "meta.yaml")["GraphMetadata"];
+  EXPECT_EQ(meta["blocks"].size(), 5);
+  EXPECT_EQ(meta["blocks"][1]["begin_id"].as<VertexID>(), 700);
+}
+
+}  // namespace sics::graph::nvme::partition
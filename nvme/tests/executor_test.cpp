@@ -0,0 +1,77 @@
+#include "nvme/components/executor.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "nvme/data_structures/graph/serialized_pram_block_csr.h"
+
+namespace sics::graph::nvme::components {
+
+using core::common::EdgeIndex;
+using core::common::VertexID;
+using core::data_structures::OwnedBuffer;
+
+class ExecutorTest : public ::testing::Test {
+ protected:
+  ExecutorTest() = default;
+};
+
+TEST_F(ExecutorTest, PullsHubsWithoutLostUpdates) {
+  auto config = core::common::Configurations::GetMutable();
+  config->parallelism = 8;
+  config->hub_degree = 1024;
+  // Vertex 1 is a hub far above hub_degree.
+  std::vector<VertexID> degree = {3, 200000, 0, 5000};
+  std::vector<EdgeIndex> offset;
+  std::vector<VertexID> edges;
+  for (VertexID i = 0; i < degree.size(); i++) {
+    offset.push_back(edges.size());
+    for (VertexID j = 0; j < degree[i]; j++) edges.push_back(j % 4);
+  }
+  core::data_structures::BlockMetadata meta{0, 0, 4, 4, edges.size(), 0};
+
+  std::vector<OwnedBuffer> buffers;
+  buffers.emplace_back(degree.size() * (sizeof(VertexID) + sizeof(EdgeIndex)));
+  memcpy(buffers.back().Get(), degree.data(), degree.size() * sizeof(VertexID));
+  memcpy(buffers.back().Get(degree.size() * sizeof(VertexID)), offset.data(),
+         offset.size() * sizeof(EdgeIndex));
+  buffers.emplace_back(edges.size() * sizeof(VertexID));
+  memcpy(buffers.back().Get(), edges.data(), buffers.back().GetSize());
+  auto serialized =
+      std::make_unique<data_structures::graph::SerializedPramBlockCSRGraph>();
+  serialized->ReceiveBuffers(std::move(buffers));
+
+  scheduler::MessageHub hub;
+  Executor<VertexID, core::common::DefaultEdgeDataType> executor(&hub);
+  data_structures::graph::PramBlock<VertexID,
+                                    core::common::DefaultEdgeDataType>
+      block(&meta);
+  block.Deserialize(*executor.GetTaskRunner(), std::move(serialized));
+
+  // A pull as in PageRank: a plain update of the source vertex, which is only
+  // safe if the edges of a vertex all run on one thread.
+  std::vector<uint64_t> sum(degree.size(), 0);
+  std::vector<std::thread::id> threads(degree.size());
+  std::mutex mtx;
+  bool shared = false;
+  executor.ParallelEdgeDo(&block, [&](VertexID src, VertexID dst) {
+    sum[src] += dst + 1;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto id = std::this_thread::get_id();
+    if (threads[src] == std::thread::id()) threads[src] = id;
+    shared |= threads[src] != id;
+  });
+  EXPECT_FALSE(shared);
+  for (VertexID i = 0; i < degree.size(); i++) {
+    uint64_t expected = 0;
+    for (VertexID j = 0; j < degree[i]; j++) expected += j % 4 + 1;
+    EXPECT_EQ(sum[i], expected) << "vertex " << i;
+  }
+}
+
+}  // namespace sics::graph::nvme::components
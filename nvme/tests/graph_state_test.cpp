@@ -0,0 +1,45 @@
+#include "nvme/scheduler/graph_state.h"
+
+#include <gtest/gtest.h>
+
+namespace sics::graph::nvme::scheduler {
+
+class GraphStateTest : public ::testing::Test {
+ protected:
+  GraphStateTest() = default;
+};
+
+TEST_F(GraphStateTest, FindsPendingBlocksByState) {
+  GraphState state(200);
+  EXPECT_EQ(state.GetFirstPending(GraphState::OnDisk), 0);
+  EXPECT_EQ(state.GetFirstPending(GraphState::Serialized), INVALID_GRAPH_ID);
+  EXPECT_EQ(state.GetNumInState(GraphState::OnDisk), 200);
+
+  state.SetOnDiskToReading(0);
+  state.SetOnDiskToReading(130);
+  EXPECT_EQ(state.GetFirstPending(GraphState::OnDisk), 1);
+  state.SetGraphState(130, GraphState::Deserialized);
+  state.SetGraphState(0, GraphState::Deserialized);
+  EXPECT_EQ(state.GetFirstPending(GraphState::Deserialized), 0);
+
+  // A block done in the current round is not pending in any state.
+  state.SetCurrentRoundPendingFinish(0);
+  EXPECT_EQ(state.GetFirstPending(GraphState::Deserialized), 130);
+  state.SetGraphState(0, GraphState::OnDisk);
+  EXPECT_EQ(state.GetFirstPending(GraphState::OnDisk), 1);
+  EXPECT_EQ(state.GetNumPending(), 199);
+  EXPECT_EQ(state.GetNumInState(GraphState::OnDisk), 199);
+
+  for (core::common::GraphID gid = 1; gid < 200; gid++) {
+    state.SetCurrentRoundPendingFinish(gid);
+  }
+  EXPECT_EQ(state.GetNumPending(), 0);
+  EXPECT_EQ(state.GetFirstPending(GraphState::OnDisk), INVALID_GRAPH_ID);
+
+  state.ResetCurrentRoundPending();
+  EXPECT_EQ(state.GetNumPending(), 200);
+  EXPECT_EQ(state.GetFirstPending(GraphState::OnDisk), 0);
+  EXPECT_EQ(state.GetFirstPending(GraphState::Deserialized), 130);
+}
+
+}  // namespace sics::graph::nvme::scheduler
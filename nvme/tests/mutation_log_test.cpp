@@ -0,0 +1,159 @@
+#include "nvme/data_structures/mutation_log.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "core/common/bitmap.h"
+#include "nvme/data_structures/graph/serialized_pram_block_csr.h"
+#include "nvme/io/pram_block_reader.h"
+#include "nvme/io/pram_block_writer.h"
+
+namespace sics::graph::nvme::data_structures {
+
+using core::common::Bitmap;
+using core::common::EdgeIndex;
+using core::common::VertexDegree;
+using core::common::VertexID;
+using core::data_structures::OwnedBuffer;
+
+// The fixture for testing the mutation log of the blocks: a block of 4
+// vertices, with the edges i * 10 + j of vertex i.
+class MutationLogTest : public ::testing::Test {
+ protected:
+  MutationLogTest() {
+    std::filesystem::create_directories(root_ + "blocks");
+    degree_ = {3, 0, 130, 2};
+    for (VertexID i = 0; i < degree_.size(); i++) {
+      offset_.push_back(edges_.size());
+      for (VertexID j = 0; j < degree_[i]; j++) edges_.push_back(i * 10 + j);
+    }
+  }
+
+  ~MutationLogTest() override { std::filesystem::remove_all(root_); }
+
+  // Delete the edges of `indices` from the block, and log it.
+  void Delete(const std::vector<EdgeIndex>& indices) {
+    Bitmap deleted(edges_.size());
+    for (auto index : indices) deleted.SetBit(index);
+    AppendMutationLogRecord(deleted.GetDataBasePointer(), edges_.size(), &log_);
+    std::vector<VertexID> edges;
+    for (VertexID i = 0; i < degree_.size(); i++) {
+      auto begin = offset_[i], end = begin + degree_[i];
+      offset_[i] = edges.size();
+      for (auto j = begin; j < end; j++) {
+        if (!deleted.GetBit(j)) edges.push_back(edges_[j]);
+      }
+      degree_[i] = edges.size() - offset_[i];
+    }
+    edges_ = edges;
+  }
+
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/mutation_log_test_" + std::to_string(getpid()) + "/";
+  std::vector<VertexDegree> degree_;
+  std::vector<EdgeIndex> offset_;
+  std::vector<VertexID> edges_;
+  std::vector<uint8_t> log_;
+};
+
+TEST_F(MutationLogTest, ReplaysTheDeletions) {
+  auto degree = degree_;
+  auto offset = offset_;
+  auto edges = edges_;
+  // Gaps of one and two varint bytes, the first and last edges.
+  Delete({0, 2, 3, 131, 134});
+  Delete({1, 2, 3, 120, 124});
+  auto expected_degree = degree_;
+  auto expected_offset = offset_;
+  auto expected_edges = edges_;
+  // A record cut short is ignored.
+  Delete({0});
+  log_.resize(log_.size() - 1);
+
+  auto left =
+      ApplyMutationLog(log_.data(), log_.size(), degree.size(), degree.data(),
+                       offset.data(), edges.data(), edges.size());
+  ASSERT_EQ(left, 125);
+  edges.resize(left);
+  EXPECT_EQ(degree, expected_degree);
+  EXPECT_EQ(offset, expected_offset);
+  EXPECT_EQ(edges, expected_edges);
+}
+
+TEST_F(MutationLogTest, WrittenBackAsLogThenCompacted) {
+  core::common::Configurations::GetMutable()->mutation_log_ratio = 0.1;
+  io::PramBlockWriter writer(root_);
+  io::PramBlockReader reader(root_);
+  std::vector<uint8_t> meta(degree_.size() *
+                            (sizeof(VertexID) + sizeof(EdgeIndex)));
+  auto serialize = [&]() {
+    std::vector<OwnedBuffer> buffers;
+    buffers.emplace_back(meta.size());
+    memcpy(buffers.back().Get(), degree_.data(),
+           degree_.size() * sizeof(VertexID));
+    memcpy(buffers.back().Get(degree_.size() * sizeof(VertexID)),
+           offset_.data(), offset_.size() * sizeof(EdgeIndex));
+    buffers.emplace_back(edges_.size() * sizeof(VertexID));
+    memcpy(buffers.back().Get(), edges_.data(), buffers.back().GetSize());
+    buffers.emplace_back(log_.size());
+    memcpy(buffers.back().Get(), log_.data(), log_.size());
+    log_.clear();
+    return buffers;
+  };
+  auto write_and_read = [&]() {
+    graph::SerializedPramBlockCSRGraph serialized;
+    serialized.ReceiveBuffers(serialize());
+    scheduler::WriteMessage write;
+    write.serialized = &serialized;
+    write.changed = true;
+    writer.Write(&write);
+
+    graph::SerializedPramBlockCSRGraph read_serialized;
+    scheduler::ReadMessage read;
+    read.num_vertices = degree_.size();
+    read.serialized = &read_serialized;
+    read.changed = true;
+    reader.Read(&read);
+    auto& buffers = *read_serialized.GetCSRBuffer();
+    EXPECT_EQ(memcmp(buffers.at(0).Get(), degree_.data(),
+                     degree_.size() * sizeof(VertexID)),
+              0);
+    EXPECT_EQ(buffers.at(1).GetSize(), edges_.size() * sizeof(VertexID));
+    EXPECT_EQ(memcmp(buffers.at(1).Get(), edges_.data(),
+                     std::min(buffers.at(1).GetSize(),
+                              edges_.size() * sizeof(VertexID))),
+              0);
+    return write.bytes_written;
+  };
+
+  std::ofstream original(root_ + "blocks/0.bin", std::ios::binary);
+  original.write((char*)degree_.data(), degree_.size() * sizeof(VertexID));
+  original.write((char*)offset_.data(), offset_.size() * sizeof(EdgeIndex));
+  original.write((char*)edges_.data(), edges_.size() * sizeof(VertexID));
+  original.close();
+  // Stale files of an earlier run.
+  std::ofstream(root_ + "blocks/0.bin.new") << "stale";
+  std::ofstream(root_ + "blocks/0.log") << "stale";
+
+  Delete({5, 6});
+  auto log_size = log_.size();
+  EXPECT_EQ(write_and_read(), log_size);
+  EXPECT_FALSE(std::filesystem::exists(root_ + "blocks/0.bin.new"));
+  // Nothing deleted, nothing written.
+  EXPECT_EQ(write_and_read(), 0);
+
+  // Past the ratio, the block is written in full.
+  std::vector<EdgeIndex> indices;
+  for (EdgeIndex i = 0; i < edges_.size(); i += 2) indices.push_back(i);
+  Delete(indices);
+  EXPECT_EQ(write_and_read(), meta.size() + edges_.size() * sizeof(VertexID));
+  EXPECT_TRUE(std::filesystem::exists(root_ + "blocks/0.bin.new"));
+  EXPECT_FALSE(std::filesystem::exists(root_ + "blocks/0.log"));
+}
+
+}  // namespace sics::graph::nvme::data_structures
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "nvme/data_structures/neighbor_hop.h"
+#include "nvme/partition/parallel_block_partition.h"
+#include "nvme/precomputing/neighbor_info.h"
+
+namespace sics::graph::nvme::precomputing {
+
+// The fixture for testing the precomputed neighbor info of the blocks.
+class NeighborInfoTest : public ::testing::Test {
+ protected:
+  NeighborInfoTest() {
+    std::filesystem::create_directories(root_ + "graphs");
+    std::mt19937 rng(5);
+    adjacency_.resize(kNumVertices);
+    for (VertexID v = 0; v < kNumVertices; v++) {
+      // Some vertices without neighbors, and some with only such neighbors.
+      if (v % 5 == 0) continue;
+      auto degree = rng() % 8;
+      for (VertexDegree i = 0; i < degree; i++) {
+        adjacency_[v].push_back(rng() % kNumVertices);
+      }
+    }
+    adjacency_[7] = {10, 15};
+
+    std::vector<VertexID> ids, degree, edges;
+    std::vector<EdgeIndex> offset;
+    for (VertexID v = 0; v < kNumVertices; v++) {
+      ids.push_back(v);
+      degree.push_back(adjacency_[v].size());
+      offset.push_back(edges.size());
+      edges.insert(edges.end(), adjacency_[v].begin(), adjacency_[v].end());
+    }
+    std::ofstream graph(root_ + "graphs/0.bin", std::ios::binary);
+    graph.write((char*)ids.data(), kNumVertices * sizeof(VertexID));
+    graph.write((char*)degree.data(), kNumVertices * sizeof(VertexID));
+    graph.write((char*)offset.data(), kNumVertices * sizeof(EdgeIndex));
+    graph.write((char*)edges.data(), edges.size() * sizeof(VertexID));
+    graph.close();
+
+    YAML::Node subgraph;
+    subgraph["gid"] = 0;
+    subgraph["num_vertices"] = kNumVertices;
+    subgraph["num_incoming_edges"] = 0;
+    subgraph["num_outgoing_edges"] = edges.size();
+    subgraph["max_vid"] = kNumVertices - 1;
+    subgraph["min_vid"] = 0;
+    YAML::Node meta;
+    meta["GraphMetadata"]["num_vertices"] = kNumVertices;
+    meta["GraphMetadata"]["num_edges"] = edges.size();
+    meta["GraphMetadata"]["max_vid"] = kNumVertices - 1;
+    meta["GraphMetadata"]["min_vid"] = 0;
+    meta["GraphMetadata"]["count_border_vertices"] = 0;
+    meta["GraphMetadata"]["num_subgraphs"] = 1;
+    meta["GraphMetadata"]["subgraphs"].push_back(subgraph);
+    std::ofstream meta_file(root_ + "meta.yaml");
+    meta_file << meta;
+    meta_file.close();
+
+    partition::BlockPartitionOptions options;
+    options.mode = partition::BlockPartitionOptions::kVertexEqual;
+    options.step_v = 150;
+    options.parallelism = 2;
+    partition::ParallelBlockPartition(root_, root_, options);
+  }
+
+  ~NeighborInfoTest() override { std::filesystem::remove_all(root_); }
+
+  static constexpr VertexID kNumVertices = 400;
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/neighbor_info_test_" + std::to_string(getpid()) + "/";
+  std::vector<std::vector<VertexID>> adjacency_;
+};
+
+TEST_F(NeighborInfoTest, MatchesTheNestedJoin) {
+  ComputeNeighborInfo(root_, 3, 4);
+
+  core::data_structures::GraphMetadata metadata(root_);
+  ASSERT_EQ(metadata.get_num_blocks(), 3);
+  for (GraphID gid = 0; gid < metadata.get_num_blocks(); gid++) {
+    auto& block = metadata.GetBlockMetadata(gid);
+    VertexID n = GetNeighborInfoSectionSize(block.num_vertices) /
+                 sizeof(VertexID);
+    std::vector<VertexID> info(4 * n);
+    std::ifstream file(GetNeighborInfoPath(root_, gid), std::ios::binary);
+    file.read((char*)info.data(), info.size() * sizeof(VertexID));
+    ASSERT_TRUE(file.good());
+    for (VertexID k = 0; k < block.num_vertices; k++) {
+      VertexID id = block.begin_id + k;
+      // One-hop: the min neighbor and the max of the vertex and its
+      // neighbors, or the vertex if it has none. Likewise for two-hop,
+      // over the neighbors of its neighbors.
+      VertexID min1 = MAX_VERTEX_ID, max1 = id;
+      VertexID min2 = MAX_VERTEX_ID, max2 = id;
+      for (auto u : adjacency_[id]) {
+        min1 = std::min(min1, u);
+        max1 = std::max(max1, u);
+        for (auto w : adjacency_[u]) {
+          min2 = std::min(min2, w);
+          max2 = std::max(max2, w);
+        }
+      }
+      if (min1 == MAX_VERTEX_ID) min1 = id;
+      if (min2 == MAX_VERTEX_ID) min2 = id;
+      EXPECT_EQ(info[k], min1) << id;
+      EXPECT_EQ(info[n + k], max1) << id;
+      EXPECT_EQ(info[2 * n + k], min2) << id;
+      EXPECT_EQ(info[3 * n + k], max2) << id;
+    }
+  }
+}
+
+TEST_F(NeighborInfoTest, MappedOnFirstRead) {
+  ComputeNeighborInfo(root_, 3, 4);
+
+  core::data_structures::GraphMetadata metadata(root_);
+  data_structures::NeighborHopInfo info;
+  info.Init(root_, metadata);
+  for (int round = 0; round < 2; round++) {
+    // Vertex 7 has the neighbors 10 and 15, which have none.
+    EXPECT_EQ(info.GetMinOneHop(7), 10);
+    EXPECT_EQ(info.GetMaxOneHop(7), 15);
+    EXPECT_EQ(info.GetMinTwoHop(7), 7);
+    EXPECT_EQ(info.GetMaxTwoHop(7), 7);
+    // A vertex of the last block has no greater neighbor.
+    EXPECT_EQ(info.GetMaxOneHop(kNumVertices - 1), kNumVertices - 1);
+    EXPECT_EQ(info.GetMinOneHop(0), 0);
+    info.Release();
+  }
+}
+
+}  // namespace sics::graph::nvme::precomputing
@@ -50,7 +50,15 @@ class PramNvmeUpdateStore : public core::update_stores::UpdateStoreBase {
             edge_delete_map_.Init(edges_count_);
             break;
           }
-          case core::common::ApplicationType::Coloring: {
+          case core::common::ApplicationType::LabelPropagation: {
+            for (uint32_t i = 0; i < vertex_count_; i++) {
+              read_data_[i] = i;
+              write_data_[i] = i;
+            }
+            break;
+          }
+          case core::common::ApplicationType::Coloring:
+          case core::common::ApplicationType::TriangleCount: {
             for (uint32_t i = 0; i < vertex_count_; i++) {
               read_data_[i] = 0;
               write_data_[i] = 0;
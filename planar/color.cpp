@@ -10,6 +10,10 @@ DEFINE_bool(in_memory, false, "in memory mode");
 DEFINE_uint32(rand_max, 100, "rand max");
 DEFINE_uint32(memory_size, 64, "memory size (GB)");
 DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
+DEFINE_string(mode, "normal", "mode (normal, static or random)");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 // web-sk rand_max = 100
 
@@ -29,6 +33,13 @@ int main(int argc, char** argv) {
       FLAGS_memory_size * 1024;
   core::common::Configurations::GetMutable()->edge_buffer_size =
       core::common::GetBufferSize(FLAGS_buffer_size);
+  core::common::Configurations::GetMutable()->mode =
+      FLAGS_mode == "normal"   ? core::common::Normal
+      : FLAGS_mode == "static" ? core::common::Static
+                               : core::common::Random;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::ColoringAppOp> system(
@@ -13,6 +13,10 @@ DEFINE_bool(fast, false, "fast mode (no output)");
 DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
 DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_bool(skip, false, "skip first sub_block");
+DEFINE_string(mode, "normal", "mode (normal, static or random)");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 
 using namespace sics::graph;
@@ -33,6 +37,13 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->edge_buffer_size =
       core::common::GetBufferSize(FLAGS_buffer_size);
   core::common::Configurations::GetMutable()->short_cut = FLAGS_short_cut;
+  core::common::Configurations::GetMutable()->mode =
+      FLAGS_mode == "normal"   ? core::common::Normal
+      : FLAGS_mode == "static" ? core::common::Static
+                               : core::common::Random;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::MstAppOp> system(
@@ -0,0 +1,54 @@
+#include <gflags/gflags.h>
+
+#include <sstream>
+
+#include "core/apps/multi_source_bfs_app_op.h"
+#include "core/planar_system.h"
+
+DEFINE_string(i, "/testfile", "graph files root path");
+DEFINE_uint32(p, 1, "parallelism");
+DEFINE_uint32(task_package_factor, 50, "task package factor");
+DEFINE_bool(in_memory, false, "in memory mode");
+DEFINE_uint32(memory_size, 64, "memory size (GB)");
+DEFINE_string(sources, "0", "comma separated source vertex ids, at most 64");
+DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
+DEFINE_string(permutation, "",
+              "vertex permutation of a relabeled graph, the sources are "
+              "input IDs");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
+
+using namespace sics::graph;
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  core::common::Configurations::GetMutable()->root_path = FLAGS_i;
+  core::common::Configurations::GetMutable()->parallelism = FLAGS_p;
+  core::common::Configurations::GetMutable()->in_memory = FLAGS_in_memory;
+  core::common::Configurations::GetMutable()->task_package_factor =
+      FLAGS_task_package_factor;
+  core::common::Configurations::GetMutable()->application =
+      core::common::ApplicationType::MultiSourceBfs;
+  core::common::Configurations::GetMutable()->memory_size =
+      FLAGS_memory_size * 1024;
+  std::stringstream sources(FLAGS_sources);
+  for (std::string source; std::getline(sources, source, ',');) {
+    core::common::Configurations::GetMutable()->sources.push_back(
+        std::stoul(source));
+  }
+  core::common::Configurations::GetMutable()->permutation_path =
+      FLAGS_permutation;
+  core::common::Configurations::GetMutable()->edge_buffer_size =
+      core::common::GetBufferSize(FLAGS_buffer_size);
+  core::common::Configurations::GetMutable()->mode = core::common::Normal;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
+
+  LOG_INFO("System begin");
+  core::planar_system::Planar<core::apps::MultiSourceBfsAppOp> system(
+      core::common::Configurations::Get()->root_path);
+  system.Start();
+  return 0;
+}
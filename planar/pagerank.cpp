@@ -18,6 +18,12 @@ DEFINE_uint32(limits, 0, "subgrah limits for pre read");
 DEFINE_bool(no_short_cut, true, "no short cut");
 DEFINE_uint32(iter, 10, "iteration");
 DEFINE_bool(radical, false, "radical");
+DEFINE_uint32(hub_degree, 65536,
+             "split vertices with more out edges into edge range tasks");
+DEFINE_string(mode, "normal", "mode (normal, static or random)");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -38,9 +44,17 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->memory_size =
       FLAGS_memory_size * 1024;
   core::common::Configurations::GetMutable()->pr_iter = FLAGS_iter;
+  core::common::Configurations::GetMutable()->hub_degree = FLAGS_hub_degree;
   core::common::Configurations::GetMutable()->radical = FLAGS_radical;
   core::common::Configurations::GetMutable()->edge_buffer_size =
       core::common::GetBufferSize(FLAGS_buffer_size);
+  core::common::Configurations::GetMutable()->mode =
+      FLAGS_mode == "normal"   ? core::common::Normal
+      : FLAGS_mode == "static" ? core::common::Static
+                               : core::common::Random;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::PageRankApp> system(
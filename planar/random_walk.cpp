@@ -12,12 +12,24 @@ DEFINE_uint32(memory_size, 64, "memory size (GB)");
 DEFINE_uint32(limits, 0, "subgrah limits for pre read");
 DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_uint32(walk, 5, "walk length of random walk");
+DEFINE_uint32(walks_per_vertex, 1, "walks started from every vertex");
+DEFINE_uint64(seed, 1, "random seed of the walks");
+DEFINE_string(o, "", "file the walks are written to, none if empty");
 DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
+DEFINE_string(mode, "normal", "mode, only normal is supported");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  // Walkers are bucketed by the subgraphs of the normal mode, while the
+  // static and random modes schedule sub-blocks instead.
+  if (FLAGS_mode != "normal") {
+    LOGF_FATAL("Random walk does not support mode {}", FLAGS_mode);
+  }
   core::common::Configurations::GetMutable()->root_path = FLAGS_i;
   core::common::Configurations::GetMutable()->parallelism = FLAGS_p;
   core::common::Configurations::GetMutable()->in_memory = FLAGS_in_memory;
@@ -30,9 +42,17 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->limits = FLAGS_limits;
   core::common::Configurations::GetMutable()->short_cut = FLAGS_short_cut;
   core::common::Configurations::GetMutable()->walk = FLAGS_walk;
+  core::common::Configurations::GetMutable()->walks_per_vertex =
+      FLAGS_walks_per_vertex;
+  core::common::Configurations::GetMutable()->walk_seed = FLAGS_seed;
+  core::common::Configurations::GetMutable()->walk_output = FLAGS_o;
   core::common::Configurations::GetMutable()->no_data_need = true;
   core::common::Configurations::GetMutable()->edge_buffer_size =
       core::common::GetBufferSize(FLAGS_buffer_size);
+  core::common::Configurations::GetMutable()->mode = core::common::Normal;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::RandomWalkAppOp> system(
@@ -11,6 +11,12 @@ DEFINE_uint32(memory_size, 64, "memory size (GB)");
 DEFINE_uint32(source, 0, "source vertex id");
 DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
 DEFINE_string(mode, "normal", "mode");
+DEFINE_string(permutation, "",
+              "vertex permutation of a relabeled graph, the source is an "
+              "input ID");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -26,12 +32,17 @@ int main(int argc, char** argv) {
   core::common::Configurations::GetMutable()->memory_size =
       FLAGS_memory_size * 1024;
   core::common::Configurations::GetMutable()->source = FLAGS_source;
+  core::common::Configurations::GetMutable()->permutation_path =
+      FLAGS_permutation;
   core::common::Configurations::GetMutable()->edge_buffer_size =
       core::common::GetBufferSize(FLAGS_buffer_size);
   core::common::Configurations::GetMutable()->mode =
       FLAGS_mode == "normal"   ? core::common::Normal
       : FLAGS_mode == "static" ? core::common::Static
                                : core::common::Random;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::SsspAppOp> system(
@@ -15,6 +15,9 @@ DEFINE_uint32(limits, 0, "subgrah limits for pre read");
 DEFINE_bool(short_cut, false, "no short cut");
 DEFINE_string(buffer_size, "32G", "buffer size for edge blocks");
 DEFINE_string(mode, "normal", "mode");
+DEFINE_string(profile, "",
+              "write a per-phase profile to this path at exit and on SIGUSR1");
+DEFINE_string(profile_format, "json", "profile format (json or chrome)");
 
 using namespace sics::graph;
 
@@ -40,6 +43,9 @@ int main(int argc, char** argv) {
       FLAGS_mode == "normal"   ? core::common::Normal
       : FLAGS_mode == "static" ? core::common::Static
                                : core::common::Random;
+  core::common::Configurations::GetMutable()->profile_path = FLAGS_profile;
+  core::common::Configurations::GetMutable()->profile_format =
+      FLAGS_profile_format;
 
   LOG_INFO("System begin");
   core::planar_system::Planar<core::apps::WCCAppOp> system(
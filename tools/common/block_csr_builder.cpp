@@ -0,0 +1,368 @@
+#include "tools/common/block_csr_builder.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "core/data_structures/graph_metadata.h"
+#include "core/util/atomic.h"
+#include "core/util/logging.h"
+#include "core/util/sub_block_partition.h"
+#include "tools/common/data_structures.h"
+#include "tools/common/edgelist_reader.h"
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::BlockID;
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::GraphID;
+using sics::graph::core::common::TaskPackage;
+using sics::graph::core::common::ThreadPool;
+using sics::graph::core::common::VertexDegree;
+using sics::graph::core::common::VertexID;
+using sics::graph::core::data_structures::Block;
+using sics::graph::core::data_structures::SubBlock;
+using sics::graph::core::data_structures::TwoDMetadata;
+using sics::graph::core::util::atomic::FetchAdd;
+using sics::graph::core::util::atomic::WriteAdd;
+
+namespace {
+
+// A run of whole sub-blocks, sorted in memory at once.
+struct Bucket {
+  VertexID begin_id;
+  VertexID end_id;
+  // Global offset of the first edge, which is also the start of the region
+  // of the bucket in the spill file.
+  EdgeIndex begin_edge;
+  EdgeIndex num_edges = 0;
+  // Sub-blocks [first, last) in the order of all the blocks.
+  size_t first_sub_block;
+  size_t last_sub_block;
+};
+
+// A sub-block in the order of all the blocks.
+struct SubBlockRef {
+  GraphID gid;
+  BlockID sid;
+  VertexID begin_id;
+  EdgeIndex begin_edge;
+  EdgeIndex num_edges;
+};
+
+void PWriteFully(int fd, const char* buffer, size_t size, size_t offset,
+                 const std::string& path) {
+  while (size > 0) {
+    auto n = pwrite(fd, buffer, size, offset);
+    if (n <= 0) LOGF_FATAL("Write {} failed at offset {}", path, offset);
+    buffer += n;
+    offset += n;
+    size -= n;
+  }
+}
+
+std::string GetBlockDir(const std::string& output_path, GraphID gid) {
+  return output_path + "graphs/" + std::to_string(gid) + "_blocks";
+}
+
+// Cut the blocks where the edge offset crosses a multiple of the share, as
+// the generators of bench/ do. Returns the first vertex of every block, and
+// num_vertices.
+std::vector<VertexID> GetBlockBounds(const std::vector<VertexDegree>& degree,
+                                     EdgeIndex num_edges,
+                                     uint32_t num_blocks) {
+  VertexID num_vertices = degree.size();
+  num_blocks = std::max(std::min(num_blocks, num_vertices), (uint32_t)1);
+  std::vector<VertexID> bounds = {0};
+  EdgeIndex share = (num_edges + num_blocks - 1) / num_blocks;
+  EdgeIndex offset = degree[0];
+  for (VertexID v = 1; v < num_vertices && bounds.size() < num_blocks; v++) {
+    if (offset >= share * bounds.size()) bounds.push_back(v);
+    offset += degree[v];
+  }
+  bounds.push_back(num_vertices);
+  return bounds;
+}
+
+// Fill in the sub-blocks of `block` and write its index.bin.
+void LayoutBlock(const std::vector<VertexDegree>& degree,
+                 const std::string& output_path, const BlockCSROptions& options,
+                 Block* block) {
+  VertexID num_vertices = block->end_id - block->begin_id;
+  auto block_degree = degree.data() + block->begin_id;
+  EdgeIndex num_edges = 0;
+  for (VertexID idx = 0; idx < num_vertices; idx++) {
+    num_edges += block_degree[idx];
+  }
+  std::vector<VertexID> sub_block_bounds;
+  block->vertex_offset = core::util::CutSubBlocks(
+      num_vertices, num_edges, options.cut_v, options.sub_block_model,
+      [block_degree](VertexID idx) { return block_degree[idx]; },
+      &sub_block_bounds);
+  auto ratio = options.offset_ratio;
+  std::vector<EdgeIndex> offset_reduce(((num_vertices - 1) / ratio) + 1);
+  EdgeIndex offset = 0;
+  for (uint32_t i = 0; i + 1 < sub_block_bounds.size(); i++) {
+    VertexID begin_id = sub_block_bounds[i];
+    VertexID end_id = sub_block_bounds[i + 1];
+    SubBlock sub_block;
+    sub_block.id = i;
+    sub_block.begin_id = begin_id + block->begin_id;
+    sub_block.end_id = end_id + block->begin_id;
+    sub_block.num_vertices = end_id - begin_id;
+    sub_block.begin_offset = offset;
+    for (VertexID idx = begin_id; idx < end_id; idx++) {
+      if (idx % ratio == 0) offset_reduce[idx / ratio] = offset;
+      offset += block_degree[idx];
+    }
+    if (offset - sub_block.begin_offset > UINT32_MAX) {
+      LOGF_FATAL("Sub-block {} of block {} has {} edges, reduce --cut_v", i,
+                 block->id, offset - sub_block.begin_offset);
+    }
+    sub_block.num_edges = offset - sub_block.begin_offset;
+    block->sub_blocks.push_back(sub_block);
+  }
+  block->num_sub_blocks = block->sub_blocks.size();
+  block->num_edges = offset;
+
+  auto dir = GetBlockDir(output_path, block->id);
+  std::filesystem::create_directories(dir);
+  std::ofstream index_file(dir + "/index.bin", std::ios::binary);
+  if (!index_file) LOGF_FATAL("Open file failed: {}/index.bin", dir);
+  index_file.write((char*)offset_reduce.data(),
+                   offset_reduce.size() * sizeof(EdgeIndex));
+  index_file.write((char*)(degree.data() + block->begin_id),
+                   num_vertices * sizeof(VertexDegree));
+}
+
+// Group the sub-blocks into buckets of at most `limit` edges, except for
+// single sub-blocks above it.
+std::vector<Bucket> GetBuckets(const std::vector<SubBlockRef>& sub_blocks,
+                               EdgeIndex limit) {
+  std::vector<Bucket> buckets;
+  for (size_t i = 0; i < sub_blocks.size(); i++) {
+    auto& sub_block = sub_blocks[i];
+    // Sub-blocks without edges join the next bucket.
+    if (buckets.empty() || (buckets.back().num_edges != 0 &&
+                            buckets.back().num_edges + sub_block.num_edges >
+                                limit)) {
+      Bucket bucket;
+      bucket.begin_id = sub_block.begin_id;
+      bucket.begin_edge = sub_block.begin_edge;
+      bucket.first_sub_block = i;
+      buckets.push_back(bucket);
+    }
+    buckets.back().num_edges += sub_block.num_edges;
+    buckets.back().last_sub_block = i + 1;
+  }
+  for (size_t b = 0; b + 1 < buckets.size(); b++) {
+    buckets[b].end_id = buckets[b + 1].begin_id;
+  }
+  return buckets;
+}
+
+}  // namespace
+
+void BuildBlockCSR(const std::string& input_path,
+                   const std::string& output_path,
+                   const BlockCSROptions& options, ThreadPool* thread_pool) {
+  LOG_INFO("BuildBlockCSR");
+  YAML::Node node = YAML::LoadFile(input_path + "meta.yaml");
+  EdgeIndex num_edges = node["EdgelistBin"]["num_edges"].as<EdgeIndex>();
+  VertexID num_vertices = node["EdgelistBin"]["max_vid"].as<VertexID>() + 1;
+  if (num_vertices == 0) LOG_FATAL("Can not write an empty graph");
+  auto edgelist_path = input_path + "edgelist.bin";
+  auto parallelism = thread_pool->GetParallelism();
+  size_t chunk_edges = options.chunk_size / sizeof(Edge);
+
+  // Pass 1: out degrees.
+  std::vector<VertexDegree> degree(num_vertices, 0);
+  ForEachEdgeChunk(edgelist_path, num_edges, chunk_edges, thread_pool,
+                   [&](EdgeIndex, Edge* edges, size_t size) {
+                     for (size_t i = 0; i < size; i++) {
+                       if (edges[i].src >= num_vertices ||
+                           edges[i].dst >= num_vertices) {
+                         LOGF_FATAL("Edge ({}, {}) out of range",
+                                    edges[i].src, edges[i].dst);
+                       }
+                       WriteAdd(&degree[edges[i].src], (VertexDegree)1);
+                     }
+                   });
+
+  // Blocks, sub-blocks and index.bin files.
+  auto bounds = GetBlockBounds(degree, num_edges, options.num_blocks);
+  GraphID num_blocks = bounds.size() - 1;
+  TwoDMetadata metadata;
+  metadata.num_vertices = num_vertices;
+  metadata.num_edges = num_edges;
+  metadata.num_blocks = num_blocks;
+  metadata.blocks.resize(num_blocks);
+  TaskPackage task_package;
+  for (GraphID gid = 0; gid < num_blocks; gid++) {
+    auto& block = metadata.blocks[gid];
+    block.id = gid;
+    block.num_vertices = bounds[gid + 1] - bounds[gid];
+    block.offset_ratio = options.offset_ratio;
+    block.begin_id = bounds[gid];
+    block.end_id = bounds[gid + 1];
+    task_package.push_back([&, gid]() {
+      LayoutBlock(degree, output_path, options, &metadata.blocks[gid]);
+    });
+  }
+  thread_pool->SubmitSync(task_package);
+  task_package.clear();
+
+  std::vector<SubBlockRef> sub_blocks;
+  EdgeIndex block_begin_edge = 0;
+  for (auto& block : metadata.blocks) {
+    for (auto& sub_block : block.sub_blocks) {
+      sub_blocks.push_back({block.id, sub_block.id, sub_block.begin_id,
+                            block_begin_edge + sub_block.begin_offset,
+                            sub_block.num_edges});
+    }
+    block_begin_edge += block.num_edges;
+  }
+  // A bucket in memory takes its edges and their destinations in CSR order.
+  EdgeIndex bucket_limit =
+      std::max(options.memory_budget / parallelism /
+                   (sizeof(Edge) + sizeof(VertexID)),
+               (size_t)1);
+  auto buckets = GetBuckets(sub_blocks, bucket_limit);
+  buckets.back().end_id = num_vertices;
+  std::vector<VertexID> bucket_begin_ids;
+  for (auto& bucket : buckets) bucket_begin_ids.push_back(bucket.begin_id);
+  LOGF_INFO("{} blocks, {} sub-blocks, {} buckets", num_blocks,
+            sub_blocks.size(), buckets.size());
+
+  // Pass 2: scatter the edges to the regions of their buckets in the spill.
+  auto spill_path = output_path + "graphs/edges.spill.bin";
+  int spill_fd = open(spill_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (spill_fd < 0) LOGF_FATAL("Open file failed: {}", spill_path);
+  std::vector<EdgeIndex> cursors(buckets.size(), 0);
+  ForEachEdgeChunk(
+      edgelist_path, num_edges, chunk_edges, thread_pool,
+      [&](EdgeIndex, Edge* edges, size_t size) {
+        thread_local std::vector<uint32_t> bucket_ids;
+        thread_local std::vector<size_t> counts;
+        thread_local std::vector<Edge> sorted;
+        bucket_ids.resize(size);
+        counts.assign(buckets.size() + 1, 0);
+        sorted.resize(size);
+        for (size_t i = 0; i < size; i++) {
+          bucket_ids[i] = std::upper_bound(bucket_begin_ids.begin(),
+                                           bucket_begin_ids.end(),
+                                           edges[i].src) -
+                          bucket_begin_ids.begin() - 1;
+          counts[bucket_ids[i] + 1]++;
+        }
+        for (size_t b = 0; b < buckets.size(); b++) counts[b + 1] += counts[b];
+        for (size_t i = 0; i < size; i++) {
+          sorted[counts[bucket_ids[i]]++] = edges[i];
+        }
+        // counts[b] is now the end of bucket b in `sorted`.
+        size_t begin = 0;
+        for (size_t b = 0; b < buckets.size(); b++) {
+          auto n = counts[b] - begin;
+          if (n == 0) continue;
+          auto position = FetchAdd(&cursors[b], (EdgeIndex)n);
+          PWriteFully(spill_fd, (char*)(sorted.data() + begin),
+                      n * sizeof(Edge),
+                      (buckets[b].begin_edge + position) * sizeof(Edge),
+                      spill_path);
+          begin = counts[b];
+        }
+      });
+  for (size_t b = 0; b < buckets.size(); b++) {
+    if (cursors[b] != buckets[b].num_edges) {
+      LOGF_FATAL("Bucket {}: {} edges scattered, {} expected", b, cursors[b],
+                 buckets[b].num_edges);
+    }
+  }
+
+  // Pass 3: sort the buckets by source and write their sub-blocks.
+  for (unsigned int i = 0; i < parallelism; i++) {
+    task_package.push_back([&, i]() {
+      std::vector<Edge> edges;
+      std::vector<VertexID> csr;
+      std::vector<EdgeIndex> offset;
+      for (size_t b = i; b < buckets.size(); b += parallelism) {
+        auto& bucket = buckets[b];
+        edges.resize(bucket.num_edges);
+        size_t bytes = bucket.num_edges * sizeof(Edge);
+        for (size_t done = 0; done < bytes;) {
+          auto n = pread(spill_fd, (char*)edges.data() + done, bytes - done,
+                         bucket.begin_edge * sizeof(Edge) + done);
+          if (n <= 0) LOGF_FATAL("Read file failed: {}", spill_path);
+          done += n;
+        }
+        VertexID bucket_vertices = bucket.end_id - bucket.begin_id;
+        offset.assign(bucket_vertices + 1, 0);
+        for (VertexID v = 0; v < bucket_vertices; v++) {
+          offset[v + 1] = offset[v] + degree[bucket.begin_id + v];
+        }
+        csr.resize(bucket.num_edges);
+        for (auto& edge : edges) {
+          csr[offset[edge.src - bucket.begin_id]++] = edge.dst;
+        }
+        // offset[v] is now the end of vertex v.
+        EdgeIndex begin = 0;
+        for (VertexID v = 0; v < bucket_vertices; v++) {
+          std::sort(csr.begin() + begin, csr.begin() + offset[v]);
+          begin = offset[v];
+        }
+        for (size_t s = bucket.first_sub_block; s < bucket.last_sub_block;
+             s++) {
+          auto& sub_block = sub_blocks[s];
+          auto path = GetBlockDir(output_path, sub_block.gid) + "/" +
+                      std::to_string(sub_block.sid) + ".bin";
+          std::ofstream out_file(path, std::ios::binary);
+          if (!out_file) LOGF_FATAL("Open file failed: {}", path);
+          out_file.write(
+              (char*)(csr.data() + sub_block.begin_edge - bucket.begin_edge),
+              sub_block.num_edges * sizeof(VertexID));
+        }
+      }
+    });
+  }
+  thread_pool->SubmitSync(task_package);
+  close(spill_fd);
+  std::filesystem::remove(spill_path);
+
+  YAML::Node blocks_meta;
+  blocks_meta["GraphMetadata"] = metadata;
+  std::ofstream blocks_meta_file(output_path + "graphs/blocks_meta.yaml");
+  blocks_meta_file << blocks_meta;
+  blocks_meta_file.close();
+
+  std::vector<core::data_structures::BlockMetadata> block_metadata_vec;
+  for (auto& block : metadata.blocks) {
+    core::data_structures::BlockMetadata block_metadata;
+    block_metadata.bid = block.id;
+    block_metadata.begin_id = block.begin_id;
+    block_metadata.end_id = block.end_id;
+    block_metadata.num_vertices = block.num_vertices;
+    block_metadata.num_outgoing_edges = block.num_edges;
+    block_metadata_vec.push_back(block_metadata);
+  }
+  core::data_structures::GraphMetadata graph_metadata;
+  graph_metadata.set_type("block");
+  graph_metadata.set_num_vertices(num_vertices);
+  graph_metadata.set_num_edges(num_edges);
+  graph_metadata.set_min_vid(0);
+  graph_metadata.set_max_vid(num_vertices - 1);
+  graph_metadata.set_num_subgraphs(num_blocks);
+  graph_metadata.set_block_metadata_vec(block_metadata_vec);
+  YAML::Node meta;
+  meta["GraphMetadata"] = graph_metadata;
+  std::ofstream meta_file(output_path + "meta.yaml");
+  meta_file << meta;
+  meta_file.close();
+  LOG_INFO("Finish writing blocks info!");
+}
+
+}  // namespace sics::graph::tools::common
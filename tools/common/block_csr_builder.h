@@ -0,0 +1,53 @@
+#ifndef SICS_GRAPH_SYSTEMS_TOOLS_COMMON_BLOCK_CSR_BUILDER_H_
+#define SICS_GRAPH_SYSTEMS_TOOLS_COMMON_BLOCK_CSR_BUILDER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "core/common/multithreading/thread_pool.h"
+#include "core/common/types.h"
+#include "core/util/sub_block_partition.h"
+
+namespace sics::graph::tools::common {
+
+struct BlockCSROptions {
+  // Blocks of about the same number of edges.
+  uint32_t num_blocks = 1;
+  // Maximum number of vertices of a sub-block.
+  uint32_t cut_v = 500000;
+  // If enabled, sub-blocks are sized by the model instead, still with at most
+  // cut_v vertices.
+  sics::graph::core::util::SubBlockCostModel sub_block_model;
+  // One out offset every offset_ratio vertices is kept in index.bin.
+  uint32_t offset_ratio = 64;
+  // Bytes of edges in memory at once while sorting, over all threads.
+  size_t memory_budget = (size_t)1 << 30;
+  // Bytes of a chunk of the binary edge list read at once by a thread.
+  size_t chunk_size = 64 << 20;
+};
+
+// @DESCRIPTION: build the block CSR layout read by MutableBlockCSRGraph, i.e.
+// graphs/<gid>_blocks/ with index.bin and the sub-block files, plus
+// graphs/blocks_meta.yaml and meta.yaml, from the binary edge list at
+// input_path (edgelist.bin and meta.yaml) into output_path, in external
+// memory. Only the out degrees of all vertices are held in memory.
+//
+// The edges are streamed three times:
+//  1. to count the out degree of every vertex, which fixes the blocks, the
+//     sub-blocks and the offsets of all edges;
+//  2. to scatter them into a spill file, by bucket, i.e. a run of whole
+//     sub-blocks of at most memory_budget / parallelism bytes of edges. The
+//     region of a bucket in the spill is known from the degrees, so threads
+//     reserve space in it by an atomic cursor and write with pwrite;
+//  3. to load the buckets, one per thread at a time, sort their edges by
+//     source with a counting sort and by destination within a vertex, and
+//     write their sub-block files.
+// The spill file, as large as the binary edge list, is removed at the end.
+void BuildBlockCSR(const std::string& input_path,
+                   const std::string& output_path,
+                   const BlockCSROptions& options,
+                   sics::graph::core::common::ThreadPool* thread_pool);
+
+}  // namespace sics::graph::tools::common
+
+#endif  // SICS_GRAPH_SYSTEMS_TOOLS_COMMON_BLOCK_CSR_BUILDER_H_
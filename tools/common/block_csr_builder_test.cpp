@@ -0,0 +1,138 @@
+#include "tools/common/block_csr_builder.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "core/data_structures/graph_metadata.h"
+#include "tools/common/data_structures.h"
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::VertexDegree;
+using sics::graph::core::common::VertexID;
+using sics::graph::core::data_structures::TwoDMetadata;
+
+// The fixture for testing the external-memory block CSR builder.
+class BlockCSRBuilderTest : public ::testing::Test {
+ protected:
+  BlockCSRBuilderTest() : thread_pool_(4) {
+    std::filesystem::create_directories(input_path_);
+    std::filesystem::create_directories(output_path_);
+  }
+
+  ~BlockCSRBuilderTest() override { std::filesystem::remove_all(root_); }
+
+  void WriteEdgelist(const std::vector<Edge>& edges, VertexID max_vid) {
+    std::ofstream data(input_path_ + "edgelist.bin", std::ios::binary);
+    data.write((char*)edges.data(), edges.size() * sizeof(Edge));
+    YAML::Node node;
+    node["EdgelistBin"]["num_vertices"] = max_vid + 1;
+    node["EdgelistBin"]["num_edges"] = edges.size();
+    node["EdgelistBin"]["max_vid"] = max_vid;
+    std::ofstream meta(input_path_ + "meta.yaml");
+    meta << node << std::endl;
+  }
+
+  // Read the adjacency lists back from the index and sub-block files.
+  std::vector<std::vector<VertexID>> ReadBlocks(const TwoDMetadata& meta) {
+    std::vector<std::vector<VertexID>> adjacency(meta.num_vertices);
+    for (auto& block : meta.blocks) {
+      auto dir = output_path_ + "graphs/" + std::to_string(block.id) +
+                 "_blocks/";
+      auto num_offsets = ((block.num_vertices - 1) / block.offset_ratio) + 1;
+      std::vector<EdgeIndex> offset_reduce(num_offsets);
+      std::vector<VertexDegree> degree(block.num_vertices);
+      std::ifstream index(dir + "index.bin", std::ios::binary);
+      index.read((char*)offset_reduce.data(), num_offsets * sizeof(EdgeIndex));
+      index.read((char*)degree.data(),
+                 block.num_vertices * sizeof(VertexDegree));
+      EXPECT_TRUE(index.good());
+
+      EdgeIndex offset = 0;
+      for (VertexID idx = 0; idx < block.num_vertices; idx++) {
+        if (idx % block.offset_ratio == 0) {
+          EXPECT_EQ(offset_reduce[idx / block.offset_ratio], offset);
+        }
+        offset += degree[idx];
+      }
+      EXPECT_EQ(offset, block.num_edges);
+
+      for (auto& sub_block : block.sub_blocks) {
+        std::vector<VertexID> edges(sub_block.num_edges);
+        std::ifstream file(dir + std::to_string(sub_block.id) + ".bin",
+                           std::ios::binary);
+        file.read((char*)edges.data(), edges.size() * sizeof(VertexID));
+        EXPECT_TRUE(file.good());
+        size_t i = 0;
+        for (auto v = sub_block.begin_id; v < sub_block.end_id; v++) {
+          auto d = degree[v - block.begin_id];
+          adjacency[v].assign(edges.begin() + i, edges.begin() + i + d);
+          i += d;
+        }
+        EXPECT_EQ(i, edges.size());
+      }
+    }
+    return adjacency;
+  }
+
+  std::string root_ = std::filesystem::temp_directory_path() /
+                      ("block_csr_builder_test_" + std::to_string(getpid()));
+  std::string input_path_ = root_ + "/in/";
+  std::string output_path_ = root_ + "/out/";
+  core::common::ThreadPool thread_pool_;
+};
+
+TEST_F(BlockCSRBuilderTest, SmallBucketsRebuildTheGraph) {
+  VertexID num_vertices = 1000;
+  std::mt19937 rng(7);
+  std::vector<Edge> edges;
+  std::vector<std::vector<VertexID>> expected(num_vertices);
+  for (int i = 0; i < 20000; i++) {
+    // Skewed sources, and no edges at all from the last vertices.
+    VertexID src = rng() % (rng() % (num_vertices - 100) + 1);
+    VertexID dst = rng() % num_vertices;
+    edges.emplace_back(src, dst);
+    expected[src].push_back(dst);
+  }
+  for (auto& neighbors : expected) {
+    std::sort(neighbors.begin(), neighbors.end());
+  }
+  WriteEdgelist(edges, num_vertices - 1);
+
+  BlockCSROptions options;
+  options.num_blocks = 3;
+  options.cut_v = 70;
+  options.offset_ratio = 16;
+  // Buckets of about 1000 edges, and chunks of 1024 edges.
+  options.memory_budget = 1000 * 12 * 4;
+  options.chunk_size = 1024 * sizeof(Edge);
+  BuildBlockCSR(input_path_, output_path_, options, &thread_pool_);
+
+  TwoDMetadata meta(output_path_);
+  EXPECT_EQ(meta.num_vertices, num_vertices);
+  EXPECT_EQ(meta.num_edges, edges.size());
+  EXPECT_EQ(meta.num_blocks, 3);
+  VertexID next_id = 0;
+  for (auto& block : meta.blocks) {
+    EXPECT_EQ(block.begin_id, next_id);
+    next_id = block.end_id;
+    for (auto& sub_block : block.sub_blocks) {
+      EXPECT_LE(sub_block.num_vertices, options.cut_v);
+    }
+  }
+  EXPECT_EQ(next_id, num_vertices);
+  EXPECT_EQ(ReadBlocks(meta), expected);
+  EXPECT_FALSE(
+      std::filesystem::exists(output_path_ + "graphs/edges.spill.bin"));
+}
+
+}  // namespace sics::graph::tools::common
@@ -0,0 +1,220 @@
+#include "tools/common/edgelist_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "core/util/logging.h"
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::TaskPackage;
+using sics::graph::core::common::ThreadPool;
+using sics::graph::core::common::VertexID;
+
+namespace {
+
+// Bytes read at once while looking for the end of the last line of a chunk.
+constexpr size_t kLineTailSize = 64 << 10;
+
+// Decimal digits of the largest VertexID.
+constexpr size_t kMaxVertexIDDigits = 10;
+
+inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* SkipBlanks(const char* p, const char* end) {
+  while (p < end && IsBlank(*p)) p++;
+  return p;
+}
+
+void PReadFully(int fd, char* buffer, size_t size, size_t offset,
+                const std::string& path) {
+  while (size > 0) {
+    auto n = pread(fd, buffer, size, offset);
+    if (n <= 0) LOGF_FATAL("Read {} failed at offset {}", path, offset);
+    buffer += n;
+    offset += n;
+    size -= n;
+  }
+}
+
+}  // namespace
+
+CSVEdgeReader::CSVEdgeReader(const std::string& path, char sep,
+                             bool read_head, size_t chunk_size)
+    : path_(path),
+      sep_(sep),
+      read_head_(read_head),
+      chunk_size_(std::max(chunk_size, (size_t)1)) {
+  fd_ = open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) LOGF_FATAL("File not found: {}", path);
+  auto size = lseek(fd_, 0, SEEK_END);
+  if (size < 0) LOGF_FATAL("Can not get the size of {}", path);
+  file_size_ = size;
+  posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+CSVEdgeReader::~CSVEdgeReader() {
+  if (fd_ >= 0) close(fd_);
+}
+
+void CSVEdgeReader::Read(ThreadPool* thread_pool, const ChunkFunc& func) {
+  size_t num_chunks = (file_size_ + chunk_size_ - 1) / chunk_size_;
+  size_t parallelism = thread_pool->GetParallelism();
+  // Per slot of a round, reused across the rounds.
+  std::vector<std::vector<char>> buffers(parallelism);
+  std::vector<std::vector<Edge>> edges(parallelism);
+  std::vector<VertexID> max_vids(parallelism, 0);
+  std::vector<size_t> num_skipped(parallelism, 0);
+
+  num_edges_ = 0;
+  for (size_t first = 0; first < num_chunks; first += parallelism) {
+    size_t num_slots = std::min(parallelism, num_chunks - first);
+    TaskPackage task_package;
+    task_package.reserve(num_slots);
+    for (size_t i = 0; i < num_slots; i++) {
+      task_package.push_back([&, i, first]() {
+        ParseChunk(first + i, &buffers[i], &edges[i], &max_vids[i],
+                   &num_skipped[i]);
+      });
+    }
+    thread_pool->SubmitSync(task_package);
+    for (size_t i = 0; i < num_slots; i++) {
+      num_edges_ += edges[i].size();
+      func(edges[i].data(), edges[i].size());
+    }
+  }
+  max_vid_ = *std::max_element(max_vids.begin(), max_vids.end());
+  num_skipped_lines_ = 0;
+  for (auto n : num_skipped) num_skipped_lines_ += n;
+  if (num_skipped_lines_ != 0) {
+    LOGF_INFO("{}: skipped {} malformed lines", path_, num_skipped_lines_);
+  }
+}
+
+void CSVEdgeReader::PRead(char* buffer, size_t size, size_t offset) const {
+  PReadFully(fd_, buffer, size, offset, path_);
+}
+
+void CSVEdgeReader::ReadChunk(size_t index, std::vector<char>* buffer,
+                              size_t* begin, size_t* end) const {
+  size_t chunk_begin = index * chunk_size_;
+  size_t chunk_end = std::min(chunk_begin + chunk_size_, file_size_);
+  // Read the byte before the chunk too, to see if a line starts with it.
+  size_t read_begin = chunk_begin == 0 ? 0 : chunk_begin - 1;
+  buffer->resize(chunk_end - read_begin);
+  PRead(buffer->data(), buffer->size(), read_begin);
+
+  *begin = 0;
+  if (chunk_begin != 0) {
+    auto newline =
+        (const char*)memchr(buffer->data(), '\n', chunk_end - read_begin);
+    // The chunk is inside a line started before it.
+    if (newline == nullptr || newline + 1 == buffer->data() + buffer->size()) {
+      *begin = *end = 0;
+      return;
+    }
+    *begin = newline + 1 - buffer->data();
+  }
+
+  // Complete the last line, which may end in the next chunks.
+  size_t read_end = chunk_end;
+  while (buffer->back() != '\n' && read_end < file_size_) {
+    size_t size = std::min(kLineTailSize, file_size_ - read_end);
+    size_t old_size = buffer->size();
+    buffer->resize(old_size + size);
+    PRead(buffer->data() + old_size, size, read_end);
+    read_end += size;
+    auto newline =
+        (const char*)memchr(buffer->data() + old_size, '\n', size);
+    if (newline != nullptr) {
+      buffer->resize(newline + 1 - buffer->data());
+      break;
+    }
+  }
+  *end = buffer->size();
+}
+
+void CSVEdgeReader::ParseChunk(size_t index, std::vector<char>* buffer,
+                               std::vector<Edge>* edges, VertexID* max_vid,
+                               size_t* num_skipped_lines) const {
+  edges->clear();
+  size_t begin, end;
+  ReadChunk(index, buffer, &begin, &end);
+  const char* p = buffer->data() + begin;
+  const char* stop = buffer->data() + end;
+  bool skip_line = index == 0 && read_head_;
+  VertexID max = *max_vid;
+  while (p < stop) {
+    auto line_end = (const char*)memchr(p, '\n', stop - p);
+    if (line_end == nullptr) line_end = stop;
+    Edge edge;
+    if (skip_line) {
+      skip_line = false;
+    } else if (ParseLine(p, line_end, &edge)) {
+      edges->push_back(edge);
+      max = std::max(max, std::max(edge.src, edge.dst));
+    } else {
+      auto q = SkipBlanks(p, line_end);
+      if (q != line_end && *q != '#' && *q != '%') (*num_skipped_lines)++;
+    }
+    p = line_end + 1;
+  }
+  *max_vid = max;
+}
+
+bool CSVEdgeReader::ParseLine(const char* p, const char* end,
+                              Edge* edge) const {
+  uint64_t src, dst;
+  p = SkipBlanks(p, end);
+  auto q = ParseUInt(p, end, &src);
+  if (q == p || q - p > kMaxVertexIDDigits) return false;
+  p = SkipBlanks(q, end);
+  // A blank separator was skipped already.
+  if (p < end && *p == sep_) {
+    p = SkipBlanks(p + 1, end);
+  } else if (p == q) {
+    return false;
+  }
+  q = ParseUInt(p, end, &dst);
+  if (q == p || q - p > kMaxVertexIDDigits) return false;
+  if (q < end && !IsBlank(*q) && *q != sep_) return false;
+  if (src >= MAX_VERTEX_ID || dst >= MAX_VERTEX_ID) {
+    LOGF_FATAL("Vertex ID out of range in {}: {} {}", path_, src, dst);
+  }
+  edge->src = src;
+  edge->dst = dst;
+  return true;
+}
+
+void ForEachEdgeChunk(
+    const std::string& path, EdgeIndex num_edges, size_t chunk_edges,
+    ThreadPool* thread_pool,
+    const std::function<void(EdgeIndex, Edge*, size_t)>& func) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) LOGF_FATAL("File not found: {}", path);
+  chunk_edges = std::max(chunk_edges, (size_t)1);
+  EdgeIndex num_chunks = (num_edges + chunk_edges - 1) / chunk_edges;
+  auto parallelism = thread_pool->GetParallelism();
+  TaskPackage task_package;
+  task_package.reserve(parallelism);
+  for (unsigned int i = 0; i < parallelism; i++) {
+    task_package.push_back([&, i]() {
+      std::vector<Edge> edges;
+      for (EdgeIndex c = i; c < num_chunks; c += parallelism) {
+        EdgeIndex first = c * chunk_edges;
+        size_t size = std::min((EdgeIndex)chunk_edges, num_edges - first);
+        edges.resize(size);
+        PReadFully(fd, (char*)edges.data(), size * sizeof(Edge),
+                   first * sizeof(Edge), path);
+        func(first, edges.data(), size);
+      }
+    });
+  }
+  thread_pool->SubmitSync(task_package);
+  close(fd);
+}
+
+}  // namespace sics::graph::tools::common
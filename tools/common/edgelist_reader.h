@@ -0,0 +1,138 @@
+#ifndef SICS_GRAPH_SYSTEMS_TOOLS_COMMON_EDGELIST_READER_H_
+#define SICS_GRAPH_SYSTEMS_TOOLS_COMMON_EDGELIST_READER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/common/multithreading/thread_pool.h"
+#include "core/common/types.h"
+#include "tools/common/data_structures.h"
+
+namespace sics::graph::tools::common {
+
+// @DESCRIPTION: parse the unsigned decimal at [p, end) into `value`. Returns
+// the end of the digits, which is p if there are none. Up to 8 digits are
+// parsed at once on little endian hosts (SWAR), if 8 bytes are readable.
+inline const char* ParseUInt(const char* p, const char* end, uint64_t* value) {
+  uint64_t result = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  while (end - p >= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, p, sizeof(chunk));
+    // A byte is a digit iff it xor '0' is below 10: set the high bit of the
+    // other bytes, without carries between the bytes.
+    uint64_t t = chunk ^ 0x3030303030303030ULL;
+    uint64_t non_digits =
+        (((t & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | t) &
+        0x8080808080808080ULL;
+    size_t n = non_digits == 0 ? 8 : __builtin_ctzll(non_digits) >> 3;
+    if (n == 0) break;
+    // Move the n digits to the high bytes, so the low ones parse as zeros.
+    t <<= (8 - n) * 8;
+    t = t * 10 + (t >> 8);
+    t = (((t & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((t >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+        32;
+    static constexpr uint64_t kPow10[] = {1,      10,      100,      1000,
+                                          10000,  100000,  1000000,  10000000,
+                                          100000000};
+    result = result * kPow10[n] + t;
+    p += n;
+    if (n < 8) {
+      *value = result;
+      return p;
+    }
+  }
+#endif
+  while (p < end && (unsigned)(*p - '0') < 10) {
+    result = result * 10 + (*p - '0');
+    p++;
+  }
+  *value = result;
+  return p;
+}
+
+// @DESCRIPTION
+//
+//  Streaming reader of edge list CSV files, one "src<sep>dst" edge per line.
+//  The file is read with pread in chunks of `chunk_size` bytes, split at line
+//  boundaries: a chunk holds the lines starting in it. Rounds of as many
+//  chunks as threads are parsed in parallel, and the edges are handed to the
+//  caller round by round in file order, so the memory used is bounded by
+//  about parallelism * chunk_size * (1 + sizeof(Edge) / line length),
+//  whatever the size of the file.
+//
+//  Blanks and '\r' around the IDs are ignored, as well as the columns after
+//  the second one, e.g. weights. Empty lines and lines starting with '#' or
+//  '%' are comments. Other lines without two IDs are skipped and counted. An
+//  ID that does not fit in a VertexID is fatal.
+class CSVEdgeReader {
+ private:
+  using VertexID = sics::graph::core::common::VertexID;
+  using EdgeIndex = sics::graph::core::common::EdgeIndex;
+  using ThreadPool = sics::graph::core::common::ThreadPool;
+
+ public:
+  static constexpr size_t kDefaultChunkSize = 64 << 20;
+
+  // Called with the edges of a chunk, in file order, from the calling thread.
+  // The edges may be modified in place.
+  using ChunkFunc = std::function<void(Edge* edges, size_t num_edges)>;
+
+  CSVEdgeReader(const std::string& path, char sep, bool read_head = false,
+                size_t chunk_size = kDefaultChunkSize);
+  ~CSVEdgeReader();
+
+  void Read(ThreadPool* thread_pool, const ChunkFunc& func);
+
+  size_t get_file_size() const { return file_size_; }
+  EdgeIndex get_num_edges() const { return num_edges_; }
+  VertexID get_max_vid() const { return max_vid_; }
+  size_t get_num_skipped_lines() const { return num_skipped_lines_; }
+
+ private:
+  // Read the lines starting in chunk `index` into `buffer`, setting
+  // [*begin, *end) to them.
+  void ReadChunk(size_t index, std::vector<char>* buffer, size_t* begin,
+                 size_t* end) const;
+
+  // Parse the lines of chunk `index` into `edges`.
+  void ParseChunk(size_t index, std::vector<char>* buffer,
+                  std::vector<Edge>* edges, VertexID* max_vid,
+                  size_t* num_skipped_lines) const;
+
+  // Returns false if [p, end) is not a line with an edge.
+  bool ParseLine(const char* p, const char* end, Edge* edge) const;
+
+  void PRead(char* buffer, size_t size, size_t offset) const;
+
+ private:
+  const std::string path_;
+  const char sep_;
+  const bool read_head_;
+  const size_t chunk_size_;
+
+  int fd_ = -1;
+  size_t file_size_ = 0;
+
+  EdgeIndex num_edges_ = 0;
+  VertexID max_vid_ = 0;
+  size_t num_skipped_lines_ = 0;
+};
+
+// @DESCRIPTION: run `func(first_edge, edges, num_edges)` in parallel over the
+// binary edge list at `path` of `num_edges` edges, read in chunks of up to
+// `chunk_edges` edges. first_edge is the index of the first edge of a chunk
+// in the file. At most one chunk per thread is in memory at once.
+void ForEachEdgeChunk(
+    const std::string& path, sics::graph::core::common::EdgeIndex num_edges,
+    size_t chunk_edges, sics::graph::core::common::ThreadPool* thread_pool,
+    const std::function<void(sics::graph::core::common::EdgeIndex, Edge*,
+                             size_t)>& func);
+
+}  // namespace sics::graph::tools::common
+
+#endif  // SICS_GRAPH_SYSTEMS_TOOLS_COMMON_EDGELIST_READER_H_
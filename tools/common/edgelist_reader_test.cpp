@@ -0,0 +1,125 @@
+#include "tools/common/edgelist_reader.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::VertexID;
+
+// The fixture for testing the streaming edge list reader.
+class EdgelistReaderTest : public ::testing::Test {
+ protected:
+  EdgelistReaderTest() : thread_pool_(4) {}
+
+  ~EdgelistReaderTest() override { std::filesystem::remove(path_); }
+
+  void WriteFile(const std::string& content) {
+    std::ofstream file(path_, std::ios::binary);
+    file << content;
+  }
+
+  std::vector<Edge> ReadAll(char sep, bool read_head, size_t chunk_size) {
+    CSVEdgeReader reader(path_, sep, read_head, chunk_size);
+    std::vector<Edge> edges;
+    reader.Read(&thread_pool_, [&edges](Edge* chunk, size_t n) {
+      edges.insert(edges.end(), chunk, chunk + n);
+    });
+    num_skipped_lines_ = reader.get_num_skipped_lines();
+    max_vid_ = reader.get_max_vid();
+    return edges;
+  }
+
+  static void ExpectEdges(const std::vector<Edge>& edges,
+                          const std::vector<std::pair<VertexID, VertexID>>&
+                              expected) {
+    ASSERT_EQ(edges.size(), expected.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+      EXPECT_EQ(edges[i].src, expected[i].first) << "edge " << i;
+      EXPECT_EQ(edges[i].dst, expected[i].second) << "edge " << i;
+    }
+  }
+
+  std::string path_ = std::filesystem::temp_directory_path() /
+                      ("edgelist_reader_test_" + std::to_string(getpid()));
+  core::common::ThreadPool thread_pool_;
+  size_t num_skipped_lines_ = 0;
+  VertexID max_vid_ = 0;
+};
+
+TEST_F(EdgelistReaderTest, ParseUIntOfAnyLength) {
+  std::string digits = "4294967295";
+  for (size_t n = 1; n <= digits.size(); n++) {
+    // Padded, so that the 8 byte path sees the separator.
+    auto s = digits.substr(0, n) + ",12345678";
+    uint64_t value = 0;
+    auto end = ParseUInt(s.data(), s.data() + s.size(), &value);
+    EXPECT_EQ(end - s.data(), n);
+    EXPECT_EQ(value, std::stoull(digits.substr(0, n)));
+  }
+  std::string s = "x1";
+  uint64_t value = 7;
+  EXPECT_EQ(ParseUInt(s.data(), s.data() + s.size(), &value), s.data());
+  EXPECT_EQ(value, 0);
+}
+
+TEST_F(EdgelistReaderTest, ChunksSplitAtLineBoundaries) {
+  std::string content;
+  std::vector<std::pair<VertexID, VertexID>> expected;
+  for (VertexID i = 0; i < 1000; i++) {
+    VertexID src = i * 7919 % 100003, dst = i * i % 1000000007;
+    content += std::to_string(src) + "," + std::to_string(dst) + "\n";
+    expected.emplace_back(src, dst);
+  }
+  WriteFile(content);
+  // Chunks shorter than a line, around a line, and larger than the file.
+  for (size_t chunk_size : {1, 3, 7, 16, 4096, 1 << 20}) {
+    ExpectEdges(ReadAll(',', false, chunk_size), expected);
+    EXPECT_EQ(num_skipped_lines_, 0);
+  }
+}
+
+TEST_F(EdgelistReaderTest, HeaderCommentsAndMalformedLines) {
+  WriteFile(
+      "src dst\n"
+      "# comment\n"
+      "1 2\r\n"
+      "\n"
+      "  3\t4  0.5\n"
+      "5\n"
+      "x 6\n"
+      "% comment\n"
+      "7 8");
+  for (size_t chunk_size : {2, 5, 1 << 20}) {
+    ExpectEdges(ReadAll(' ', true, chunk_size), {{1, 2}, {3, 4}, {7, 8}});
+    EXPECT_EQ(num_skipped_lines_, 2);
+    EXPECT_EQ(max_vid_, 8);
+  }
+}
+
+TEST_F(EdgelistReaderTest, ForEachEdgeChunkCoversAllEdges) {
+  std::vector<Edge> edges;
+  for (VertexID i = 0; i < 1001; i++) edges.emplace_back(i, i + 1);
+  {
+    std::ofstream file(path_, std::ios::binary);
+    file.write((char*)edges.data(), edges.size() * sizeof(Edge));
+  }
+  std::vector<VertexID> seen(edges.size(), 0);
+  ForEachEdgeChunk(path_, edges.size(), 10, &thread_pool_,
+                   [&seen](EdgeIndex first, Edge* chunk, size_t n) {
+                     for (size_t i = 0; i < n; i++) {
+                       EXPECT_EQ(chunk[i].src, first + i);
+                       seen[first + i]++;
+                     }
+                   });
+  for (auto count : seen) EXPECT_EQ(count, 1);
+}
+
+}  // namespace sics::graph::tools::common
@@ -0,0 +1,341 @@
+#include "tools/common/reorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <queue>
+
+#include "core/common/bitmap.h"
+#include "core/util/atomic.h"
+#include "core/util/logging.h"
+
+#ifdef TBB_FOUND
+#include <execution>
+#endif
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::Bitmap;
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::TaskPackage;
+using sics::graph::core::common::ThreadPool;
+using sics::graph::core::common::VertexID;
+using sics::graph::core::util::atomic::FetchAdd;
+using sics::graph::core::util::atomic::WriteAdd;
+
+namespace {
+
+// Run `func(begin, end)` over [0, num_items) split into one range per thread.
+template <typename Func>
+void ParallelRangeDo(EdgeIndex num_items, ThreadPool* thread_pool,
+                     const Func& func) {
+  auto parallelism = thread_pool->GetParallelism();
+  auto task_package = TaskPackage();
+  task_package.reserve(parallelism);
+  auto task_size = (num_items + parallelism - 1) / parallelism;
+  for (unsigned int i = 0; i < parallelism; i++) {
+    auto task = [&func, i, task_size, num_items]() {
+      func(std::min(num_items, i * task_size),
+           std::min(num_items, (i + 1) * task_size));
+    };
+    task_package.push_back(task);
+  }
+  thread_pool->SubmitSync(task_package);
+}
+
+}  // namespace
+
+std::vector<VertexID> CountInDegree(const Edge* edges, EdgeIndex num_edges,
+                                    VertexID num_vertices,
+                                    ThreadPool* thread_pool) {
+  std::vector<VertexID> in_degree(num_vertices, 0);
+  ParallelRangeDo(num_edges, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex j = b; j < e; j++) {
+      WriteAdd(&in_degree[edges[j].dst], (VertexID)1);
+    }
+  });
+  return in_degree;
+}
+
+std::vector<VertexID> CountDegree(const Edge* edges, EdgeIndex num_edges,
+                                  VertexID num_vertices,
+                                  ThreadPool* thread_pool) {
+  std::vector<VertexID> degree(num_vertices, 0);
+  ParallelRangeDo(num_edges, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex j = b; j < e; j++) {
+      WriteAdd(&degree[edges[j].src], (VertexID)1);
+      WriteAdd(&degree[edges[j].dst], (VertexID)1);
+    }
+  });
+  return degree;
+}
+
+void BuildAdjacency(const Edge* edges, EdgeIndex num_edges,
+                    VertexID num_vertices, bool outgoing,
+                    ThreadPool* thread_pool, Adjacency* adjacency) {
+  auto& offset = adjacency->offset;
+  auto& neighbors = adjacency->neighbors;
+  offset.assign(num_vertices + 1, 0);
+  ParallelRangeDo(num_edges, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex j = b; j < e; j++) {
+      auto v = outgoing ? edges[j].src : edges[j].dst;
+      WriteAdd(&offset[v + 1], (EdgeIndex)1);
+    }
+  });
+  for (VertexID v = 0; v < num_vertices; v++) offset[v + 1] += offset[v];
+
+  std::vector<EdgeIndex> cursor(offset.begin(), offset.end() - 1);
+  neighbors.resize(num_edges);
+  ParallelRangeDo(num_edges, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex j = b; j < e; j++) {
+      auto v = outgoing ? edges[j].src : edges[j].dst;
+      auto u = outgoing ? edges[j].dst : edges[j].src;
+      neighbors[FetchAdd(&cursor[v], (EdgeIndex)1)] = u;
+    }
+  });
+  // The fill order depends on scheduling, sort to make the result stable.
+  ParallelRangeDo(num_vertices, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex v = b; v < e; v++) {
+      std::sort(neighbors.begin() + offset[v],
+                neighbors.begin() + offset[v + 1]);
+    }
+  });
+}
+
+std::vector<VertexID> GetHotVertexPermutation(
+    const std::vector<VertexID>& in_degree, VertexID k) {
+  VertexID num_vertices = in_degree.size();
+  if (k > num_vertices) k = num_vertices;
+  std::vector<VertexID> ids(num_vertices);
+  std::iota(ids.begin(), ids.end(), 0);
+  auto hotter = [&in_degree](VertexID a, VertexID b) {
+    return in_degree[a] > in_degree[b] ||
+           (in_degree[a] == in_degree[b] && a < b);
+  };
+  std::nth_element(ids.begin(), ids.begin() + k, ids.end(), hotter);
+  std::sort(ids.begin(), ids.begin() + k, hotter);
+
+  std::vector<VertexID> new2old(num_vertices);
+  Bitmap is_hot(num_vertices);
+  for (VertexID i = 0; i < k; i++) {
+    new2old[i] = ids[i];
+    is_hot.SetBit(ids[i]);
+  }
+  VertexID next = k;
+  for (VertexID v = 0; v < num_vertices; v++) {
+    if (!is_hot.GetBit(v)) new2old[next++] = v;
+  }
+  if (k > 0) {
+    LOGF_INFO("Hot vertices: {}, in-degree from {} to {}", k,
+              in_degree[new2old[0]], in_degree[new2old[k - 1]]);
+  }
+  return new2old;
+}
+
+std::vector<VertexID> GetDegreeSortPermutation(
+    const std::vector<VertexID>& degree) {
+  std::vector<VertexID> new2old(degree.size());
+  std::iota(new2old.begin(), new2old.end(), 0);
+  auto higher = [&degree](VertexID a, VertexID b) {
+    return degree[a] > degree[b] || (degree[a] == degree[b] && a < b);
+  };
+#ifdef TBB_FOUND
+  std::sort(std::execution::par, new2old.begin(), new2old.end(), higher);
+#else
+  std::sort(new2old.begin(), new2old.end(), higher);
+#endif
+  return new2old;
+}
+
+std::vector<VertexID> GetHubClusterPermutation(
+    const std::vector<VertexID>& degree) {
+  VertexID num_vertices = degree.size();
+  std::vector<VertexID> new2old;
+  new2old.reserve(num_vertices);
+  if (num_vertices == 0) return new2old;
+  auto sum = std::accumulate(degree.begin(), degree.end(), (EdgeIndex)0);
+  auto average = (double)sum / num_vertices;
+  for (VertexID v = 0; v < num_vertices; v++) {
+    if (degree[v] > average) new2old.push_back(v);
+  }
+  LOGF_INFO("Hub cluster: {} hubs of {} vertices", new2old.size(),
+            num_vertices);
+  for (VertexID v = 0; v < num_vertices; v++) {
+    if (degree[v] <= average) new2old.push_back(v);
+  }
+  return new2old;
+}
+
+std::vector<VertexID> GetRCMPermutation(const Adjacency& out,
+                                        const Adjacency& in) {
+  VertexID num_vertices = out.offset.size() - 1;
+  std::vector<VertexID> degree(num_vertices);
+  for (VertexID v = 0; v < num_vertices; v++) {
+    degree[v] = out.GetDegree(v) + in.GetDegree(v);
+  }
+  auto lower = [&degree](VertexID a, VertexID b) {
+    return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+  };
+  // Start each component at its lowest degree vertex.
+  std::vector<VertexID> starts(num_vertices);
+  std::iota(starts.begin(), starts.end(), 0);
+  std::sort(starts.begin(), starts.end(), lower);
+
+  Bitmap visited(num_vertices);
+  std::vector<VertexID> order;
+  order.reserve(num_vertices);
+  std::vector<VertexID> frontier;
+  for (auto start : starts) {
+    if (visited.GetBit(start)) continue;
+    visited.SetBit(start);
+    // `order` doubles as the BFS queue.
+    size_t head = order.size();
+    order.push_back(start);
+    while (head < order.size()) {
+      auto u = order[head++];
+      frontier.clear();
+      for (auto* adj : {&out, &in}) {
+        auto neighbors = adj->GetNeighbors(u);
+        for (VertexID i = 0; i < adj->GetDegree(u); i++) {
+          auto v = neighbors[i];
+          if (visited.GetBit(v)) continue;
+          visited.SetBit(v);
+          frontier.push_back(v);
+        }
+      }
+      std::sort(frontier.begin(), frontier.end(), lower);
+      order.insert(order.end(), frontier.begin(), frontier.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<VertexID> GetGorderPermutation(const Adjacency& out,
+                                           const Adjacency& in,
+                                           uint32_t window) {
+  VertexID num_vertices = out.offset.size() - 1;
+  std::vector<VertexID> new2old;
+  new2old.reserve(num_vertices);
+  if (num_vertices == 0) return new2old;
+  if (window == 0) window = 1;
+  VertexID huge_degree = std::sqrt((double)num_vertices);
+
+  // Fallback order for new runs: by descending in-degree.
+  std::vector<VertexID> in_degree(num_vertices);
+  for (VertexID v = 0; v < num_vertices; v++) in_degree[v] = in.GetDegree(v);
+  auto fallback = GetDegreeSortPermutation(in_degree);
+  VertexID fallback_pos = 0;
+
+  Bitmap placed(num_vertices);
+  std::vector<uint32_t> score(num_vertices, 0);
+  // Entries are (score, -vertex), so ties pick the smaller ID. An entry is
+  // stale once the vertex is placed or its score changed.
+  std::priority_queue<std::pair<uint32_t, int64_t>> heap;
+
+  auto update = [&](VertexID v, bool increase) {
+    if (placed.GetBit(v)) return;
+    if (increase) {
+      score[v]++;
+    } else {
+      score[v]--;
+    }
+    if (score[v] > 0) heap.push({score[v], -(int64_t)v});
+  };
+  // Add (resp. remove) the contribution of `u` entering (resp. leaving) the
+  // window to the scores of its neighbors and siblings.
+  auto slide = [&](VertexID u, bool increase) {
+    for (auto* adj : {&out, &in}) {
+      auto neighbors = adj->GetNeighbors(u);
+      for (VertexID i = 0; i < adj->GetDegree(u); i++) {
+        update(neighbors[i], increase);
+      }
+    }
+    auto parents = in.GetNeighbors(u);
+    for (VertexID i = 0; i < in.GetDegree(u); i++) {
+      auto x = parents[i];
+      if (out.GetDegree(x) > huge_degree) continue;
+      auto siblings = out.GetNeighbors(x);
+      for (VertexID j = 0; j < out.GetDegree(x); j++) {
+        if (siblings[j] != u) update(siblings[j], increase);
+      }
+    }
+  };
+
+  while (new2old.size() < num_vertices) {
+    VertexID next = MAX_VERTEX_ID;
+    while (!heap.empty()) {
+      auto [s, neg_v] = heap.top();
+      heap.pop();
+      VertexID v = -neg_v;
+      if (!placed.GetBit(v) && score[v] == s) {
+        next = v;
+        break;
+      }
+    }
+    if (next == MAX_VERTEX_ID) {
+      while (placed.GetBit(fallback[fallback_pos])) fallback_pos++;
+      next = fallback[fallback_pos];
+    }
+    placed.SetBit(next);
+    new2old.push_back(next);
+    slide(next, true);
+    if (new2old.size() > window) {
+      slide(new2old[new2old.size() - window - 1], false);
+    }
+  }
+  return new2old;
+}
+
+std::vector<VertexID> GetReorderPermutation(ReorderStrategy strategy,
+                                            const Edge* edges,
+                                            EdgeIndex num_edges,
+                                            VertexID num_vertices,
+                                            ThreadPool* thread_pool,
+                                            uint32_t window) {
+  switch (strategy) {
+    case kDegreeSort:
+      return GetDegreeSortPermutation(
+          CountDegree(edges, num_edges, num_vertices, thread_pool));
+    case kHubCluster:
+      return GetHubClusterPermutation(
+          CountDegree(edges, num_edges, num_vertices, thread_pool));
+    case kRCM:
+    case kGorder: {
+      Adjacency out, in;
+      BuildAdjacency(edges, num_edges, num_vertices, true, thread_pool, &out);
+      BuildAdjacency(edges, num_edges, num_vertices, false, thread_pool, &in);
+      if (strategy == kRCM) return GetRCMPermutation(out, in);
+      return GetGorderPermutation(out, in, window);
+    }
+    default:
+      LOG_FATAL("Error reorder strategy.");
+  }
+  return {};
+}
+
+void RelabelEdges(const std::vector<VertexID>& new2old, Edge* edges,
+                  EdgeIndex num_edges, ThreadPool* thread_pool) {
+  std::vector<VertexID> old2new(new2old.size());
+  ParallelRangeDo(new2old.size(), thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex v = b; v < e; v++) old2new[new2old[v]] = v;
+  });
+  ParallelRangeDo(num_edges, thread_pool, [&](EdgeIndex b, EdgeIndex e) {
+    for (EdgeIndex j = b; j < e; j++) {
+      edges[j].src = old2new[edges[j].src];
+      edges[j].dst = old2new[edges[j].dst];
+    }
+  });
+}
+
+void WritePermutation(const std::string& path,
+                      const std::vector<VertexID>& new2old) {
+  std::ofstream out_file(path, std::ios::binary);
+  if (!out_file) LOG_FATAL("Error opening file: ", path.c_str());
+  out_file.write(reinterpret_cast<const char*>(new2old.data()),
+                 sizeof(VertexID) * new2old.size());
+  out_file.close();
+}
+
+}  // namespace sics::graph::tools::common
@@ -0,0 +1,107 @@
+#ifndef SICS_GRAPH_SYSTEMS_TOOLS_COMMON_REORDER_H_
+#define SICS_GRAPH_SYSTEMS_TOOLS_COMMON_REORDER_H_
+
+#include <string>
+#include <vector>
+
+#include "core/common/multithreading/thread_pool.h"
+#include "core/common/types.h"
+#include "tools/common/data_structures.h"
+#include "tools/common/types.h"
+
+namespace sics::graph::tools::common {
+
+// A vertex permutation is stored as `new2old`, i.e. new2old[v] is the old ID
+// of the vertex relabeled to v.
+
+// Adjacency lists of every vertex in [0, num_vertices), in CSR layout.
+struct Adjacency {
+  core::common::VertexID GetDegree(core::common::VertexID v) const {
+    return offset[v + 1] - offset[v];
+  }
+  const core::common::VertexID* GetNeighbors(core::common::VertexID v) const {
+    return neighbors.data() + offset[v];
+  }
+
+  // num_vertices + 1 entries.
+  std::vector<core::common::EdgeIndex> offset;
+  std::vector<core::common::VertexID> neighbors;
+};
+
+// @DESCRIPTION: count the in-degree of every vertex in [0, num_vertices) over
+// the edges [edges, edges + num_edges) in parallel.
+std::vector<core::common::VertexID> CountInDegree(
+    const Edge* edges, core::common::EdgeIndex num_edges,
+    core::common::VertexID num_vertices, core::common::ThreadPool* thread_pool);
+
+// @DESCRIPTION: count the in-degree plus the out-degree of every vertex in
+// [0, num_vertices) over the edges in parallel.
+std::vector<core::common::VertexID> CountDegree(
+    const Edge* edges, core::common::EdgeIndex num_edges,
+    core::common::VertexID num_vertices, core::common::ThreadPool* thread_pool);
+
+// @DESCRIPTION: build the outgoing (resp. incoming) adjacency lists of the
+// edges in parallel, with each list sorted by vertex ID.
+void BuildAdjacency(const Edge* edges, core::common::EdgeIndex num_edges,
+                    core::common::VertexID num_vertices, bool outgoing,
+                    core::common::ThreadPool* thread_pool,
+                    Adjacency* adjacency);
+
+// @DESCRIPTION: build the permutation that renumbers the `k` vertices with the
+// highest in-degree into the dense prefix [0, k), by descending in-degree. The
+// other vertices keep their relative order behind them, so the locality of
+// the original numbering is preserved.
+std::vector<core::common::VertexID> GetHotVertexPermutation(
+    const std::vector<core::common::VertexID>& in_degree,
+    core::common::VertexID k);
+
+// @DESCRIPTION: order all vertices by descending degree, ties by ID.
+std::vector<core::common::VertexID> GetDegreeSortPermutation(
+    const std::vector<core::common::VertexID>& degree);
+
+// @DESCRIPTION: move the hubs, i.e. vertices with more than the average
+// degree, in front of the other vertices. Both groups keep their relative
+// order, so unlike a full degree sort the locality inside a group survives.
+std::vector<core::common::VertexID> GetHubClusterPermutation(
+    const std::vector<core::common::VertexID>& degree);
+
+// @DESCRIPTION: Reverse Cuthill-McKee ordering over the undirected graph
+// given by both adjacencies. Each connected component is traversed in BFS
+// order from its lowest degree vertex, visiting neighbors by ascending degree,
+// and the final order is reversed. It reduces the bandwidth of the adjacency
+// matrix, so the neighbors of a vertex get close IDs.
+std::vector<core::common::VertexID> GetRCMPermutation(const Adjacency& out,
+                                                      const Adjacency& in);
+
+// @DESCRIPTION: Gorder-like greedy ordering. The next vertex is the one with
+// the highest locality score to the last `window` placed vertices, where the
+// score counts the edges to them plus the in-neighbors shared with them.
+// In-neighbors with more than sqrt(num_vertices) out edges are ignored for
+// the shared count, as in Gorder, to bound the cost of hubs. Scores live in
+// a lazy max heap; when it runs dry the highest degree unplaced vertex starts
+// a new run.
+std::vector<core::common::VertexID> GetGorderPermutation(const Adjacency& out,
+                                                         const Adjacency& in,
+                                                         uint32_t window);
+
+// @DESCRIPTION: build the permutation of `strategy` for the edges over
+// [0, num_vertices). `window` is only used by kGorder.
+std::vector<core::common::VertexID> GetReorderPermutation(
+    ReorderStrategy strategy, const Edge* edges,
+    core::common::EdgeIndex num_edges, core::common::VertexID num_vertices,
+    core::common::ThreadPool* thread_pool, uint32_t window = 5);
+
+// @DESCRIPTION: relabel the endpoints of the edges in place with the
+// permutation `new2old`, in parallel.
+void RelabelEdges(const std::vector<core::common::VertexID>& new2old,
+                  Edge* edges, core::common::EdgeIndex num_edges,
+                  core::common::ThreadPool* thread_pool);
+
+// @DESCRIPTION: write `new2old` as a binary array of VertexID, so that results
+// indexed by new IDs can be mapped back to the input IDs.
+void WritePermutation(const std::string& path,
+                      const std::vector<core::common::VertexID>& new2old);
+
+}  // namespace sics::graph::tools::common
+
+#endif  // SICS_GRAPH_SYSTEMS_TOOLS_COMMON_REORDER_H_
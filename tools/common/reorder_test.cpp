@@ -0,0 +1,89 @@
+#include "tools/common/reorder.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace sics::graph::tools::common {
+
+using sics::graph::core::common::VertexID;
+
+// The fixture for testing vertex reordering.
+class ReorderTest : public ::testing::Test {
+ protected:
+  ReorderTest() : thread_pool_(4) {}
+
+  void ExpectPermutation(std::vector<VertexID> new2old, VertexID n) {
+    ASSERT_EQ(new2old.size(), n);
+    std::sort(new2old.begin(), new2old.end());
+    for (VertexID v = 0; v < n; v++) EXPECT_EQ(new2old[v], v);
+  }
+
+  // A path 0 - 5 - 2 - 7 - 1 - 4 - 6 - 3 with scrambled IDs.
+  std::vector<Edge> ScrambledPath() {
+    std::vector<VertexID> path = {0, 5, 2, 7, 1, 4, 6, 3};
+    std::vector<Edge> edges;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+      edges.emplace_back(path[i], path[i + 1]);
+    }
+    return edges;
+  }
+
+  core::common::ThreadPool thread_pool_;
+};
+
+TEST_F(ReorderTest, AllStrategiesArePermutations) {
+  std::vector<Edge> edges = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {3, 4},
+                             {4, 0}, {5, 0}, {5, 4}, {2, 5}};
+  for (auto strategy : {kDegreeSort, kHubCluster, kRCM, kGorder}) {
+    ExpectPermutation(GetReorderPermutation(strategy, edges.data(),
+                                            edges.size(), 6, &thread_pool_),
+                      6);
+  }
+}
+
+TEST_F(ReorderTest, DegreeSortAndHubCluster) {
+  std::vector<VertexID> degree = {1, 5, 1, 4, 1, 1};
+  EXPECT_THAT(GetDegreeSortPermutation(degree),
+              ::testing::ElementsAre(1, 3, 0, 2, 4, 5));
+  EXPECT_THAT(GetHubClusterPermutation(degree),
+              ::testing::ElementsAre(1, 3, 0, 2, 4, 5));
+  // Hub clustering keeps the relative order of the hubs.
+  degree = {1, 4, 1, 5, 1, 1};
+  EXPECT_THAT(GetHubClusterPermutation(degree),
+              ::testing::ElementsAre(1, 3, 0, 2, 4, 5));
+}
+
+TEST_F(ReorderTest, HotVerticesFormAPrefix) {
+  std::vector<Edge> edges = {{0, 3}, {1, 3}, {2, 3}, {0, 2}, {1, 2}, {3, 0}};
+  auto in_degree = CountInDegree(edges.data(), edges.size(), 4, &thread_pool_);
+  EXPECT_THAT(in_degree, ::testing::ElementsAre(1, 0, 2, 3));
+  EXPECT_THAT(GetHotVertexPermutation(in_degree, 2),
+              ::testing::ElementsAre(3, 2, 0, 1));
+}
+
+TEST_F(ReorderTest, RCMRestoresPathBandwidth) {
+  auto edges = ScrambledPath();
+  auto new2old =
+      GetReorderPermutation(kRCM, edges.data(), edges.size(), 8, &thread_pool_);
+  ExpectPermutation(new2old, 8);
+  RelabelEdges(new2old, edges.data(), edges.size(), &thread_pool_);
+  for (auto& edge : edges) {
+    EXPECT_EQ(std::max(edge.src, edge.dst) - std::min(edge.src, edge.dst), 1);
+  }
+}
+
+TEST_F(ReorderTest, BuildAdjacency) {
+  std::vector<Edge> edges = {{2, 0}, {0, 1}, {0, 2}, {2, 1}};
+  Adjacency out, in;
+  BuildAdjacency(edges.data(), edges.size(), 3, true, &thread_pool_, &out);
+  BuildAdjacency(edges.data(), edges.size(), 3, false, &thread_pool_, &in);
+  EXPECT_THAT(out.offset, ::testing::ElementsAre(0, 2, 2, 4));
+  EXPECT_THAT(out.neighbors, ::testing::ElementsAre(1, 2, 0, 1));
+  EXPECT_THAT(in.offset, ::testing::ElementsAre(0, 1, 3, 4));
+  EXPECT_THAT(in.neighbors, ::testing::ElementsAre(2, 0, 2, 0));
+}
+
+}  // namespace sics::graph::tools::common
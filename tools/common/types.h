@@ -26,6 +26,8 @@ enum ConvertMode {
   kEdgelistCSV2EdgelistBin,
   kEdgelistCSV2CSRBin,
   kEdgelistBin2CSRBin,
+  kReorder,
+  kEdgelistBin2Blocks,
   kUndefinedMode
 };
 
@@ -36,9 +38,33 @@ static inline ConvertMode ConvertMode2Enum(const std::string& s) {
     return kEdgelistBin2CSRBin;
   else if (s == "edgelistcsv2bin")
     return kEdgelistCSV2CSRBin;
+  else if (s == "reorder")
+    return kReorder;
+  else if (s == "edgelistbin2blocks")
+    return kEdgelistBin2Blocks;
   return kUndefinedMode;
 };
 
+enum ReorderStrategy {
+  kDegreeSort,  // default
+  kHubCluster,
+  kRCM,
+  kGorder,
+  kUndefinedReorder
+};
+
+static inline ReorderStrategy ReorderStrategy2Enum(const std::string& s) {
+  if (s == "degreesort")
+    return kDegreeSort;
+  else if (s == "hubcluster")
+    return kHubCluster;
+  else if (s == "rcm")
+    return kRCM;
+  else if (s == "gorder")
+    return kGorder;
+  return kUndefinedReorder;
+};
+
 }  // namespace tools
 
 #endif  // SICS_GRAPH_SYSTEMS_TOOLS_TOOLS_COMMON_TYPES_H_
@@ -7,7 +7,9 @@
 // USAGE: graph-convert --convert_mode=[options] -i <input file path> -o <output
 // file path> --sep=[separator]
 
+#include <fcntl.h>
 #include <gflags/gflags.h>
+#include <unistd.h>
 #include <yaml-cpp/yaml.h>
 
 #include <filesystem>
@@ -21,8 +23,11 @@
 #include "core/data_structures/graph_metadata.h"
 #include "core/util/atomic.h"
 #include "core/util/logging.h"
+#include "tools/common/block_csr_builder.h"
 #include "tools/common/data_structures.h"
+#include "tools/common/edgelist_reader.h"
 #include "tools/common/io.h"
+#include "tools/common/reorder.h"
 #include "tools/common/yaml_config.h"
 
 using sics::graph::core::common::Bitmap;
@@ -51,10 +56,110 @@ DEFINE_string(convert_mode, "", "Conversion mode");
 DEFINE_string(sep, "", "separator to split a line of csv file.");
 DEFINE_bool(read_head, false, "whether to read header of csv.");
 DEFINE_bool(biggraph, false, "for big graphs.");
+DEFINE_uint64(read_chunk_size, 64,
+              "size in MB of the chunks the CSV file is read and parsed in, "
+              "one per thread at a time.");
 DEFINE_bool(not_reorder_vertices, false, "whether to reorder vertices.");
+DEFINE_string(reorder_strategy, "degreesort",
+              "vertex reordering strategy of the reorder mode: degreesort, "
+              "hubcluster, rcm and gorder.");
+DEFINE_uint32(gorder_window, 5, "window size of the gorder strategy.");
+DEFINE_uint32(cut_v, 500000,
+              "maximum number of vertices of a sub-block of the blocks mode.");
+DEFINE_uint32(offset_ratio, 64,
+              "one out offset every offset_ratio vertices is kept in the "
+              "index of a block.");
+DEFINE_uint64(sub_block_kb, 0,
+              "size in KB of the sub-blocks of the blocks mode, e.g. the I/O "
+              "size at which the device reaches its bandwidth. 0 cuts them "
+              "by cut_v alone.");
+DEFINE_uint64(min_sub_block_kb, 1024,
+              "size in KB the sub-blocks may shrink to, so that every thread "
+              "gets tasks_per_thread of them.");
+DEFINE_uint32(tasks_per_thread, 4, "sub-blocks per thread of a block.");
+DEFINE_uint64(memory_mb, 1024,
+              "memory in MB for the edges sorted at once by the blocks mode.");
+DEFINE_uint32(hot_vertices, 0,
+              "renumber the top-k in-degree vertices into [0, k), 0 to "
+              "disable.");
+
+// @DESCRIPTION: renumber the hot_vertices vertices with the highest in-degree
+// of a compressed binary edgelist into the dense prefix [0, hot_vertices), so
+// that the state of hubs read by pull style kernels stays in cache. vid_map.bin
+// is written to output_path, holding the input ID of every new vertex ID.
+// @PARAMETER: buffer_edges holds n_edges compressed edges over num_vertices
+// vertices, vid_map maps input IDs set in bitmap to compressed IDs.
+void RenumberHotVertices(const std::string& output_path, VertexID hot_vertices,
+                         VertexID* buffer_edges, EdgeIndex n_edges,
+                         VertexID num_vertices, const VertexID* vid_map,
+                         const Bitmap& bitmap, VertexID aligned_max_vid,
+                         sics::graph::core::common::ThreadPool* thread_pool) {
+  LOG_INFO("RenumberHotVertices");
+  auto edges = reinterpret_cast<Edge*>(buffer_edges);
+  auto in_degree = CountInDegree(edges, n_edges, num_vertices, thread_pool);
+  auto new2old = GetHotVertexPermutation(in_degree, hot_vertices);
+  RelabelEdges(new2old, edges, n_edges, thread_pool);
+
+  std::vector<VertexID> compressed2input(num_vertices);
+  for (VertexID vid = 0; vid < aligned_max_vid; vid++) {
+    if (bitmap.GetBit(vid)) compressed2input[vid_map[vid]] = vid;
+  }
+  for (VertexID vid = 0; vid < num_vertices; vid++) {
+    new2old[vid] = compressed2input[new2old[vid]];
+  }
+  WritePermutation(output_path + "vid_map.bin", new2old);
+}
+
+// @DESCRIPTION: compress the IDs set in `bitmap` into [0, count), in the
+// order of the input IDs, by ranks computed in parallel. Returns count.
+// @PARAMETER: vid_map gets the compressed ID of every input ID set in bitmap.
+VertexID CompressVertexIDs(const Bitmap& bitmap, VertexID aligned_max_vid,
+                           VertexID* vid_map,
+                           sics::graph::core::common::ThreadPool* thread_pool) {
+  auto parallelism = thread_pool->GetParallelism();
+  auto words = bitmap.GetDataBasePointer();
+  size_t num_words = aligned_max_vid >> 6;
+  size_t task_size = (num_words + parallelism - 1) / parallelism;
+  // Number of IDs set before the words of every task.
+  std::vector<VertexID> base(parallelism + 1, 0);
+  auto task_package = TaskPackage();
+  task_package.reserve(parallelism);
+  for (unsigned int i = 0; i < parallelism; i++) {
+    task_package.push_back([&, i]() {
+      auto end = std::min(num_words, (i + 1) * task_size);
+      for (size_t w = i * task_size; w < end; w++) {
+        base[i + 1] += __builtin_popcountll(words[w]);
+      }
+    });
+  }
+  thread_pool->SubmitSync(task_package);
+  for (unsigned int i = 0; i < parallelism; i++) base[i + 1] += base[i];
+  task_package.clear();
+  for (unsigned int i = 0; i < parallelism; i++) {
+    task_package.push_back([&, i]() {
+      auto rank = base[i];
+      auto end = std::min(num_words, (i + 1) * task_size);
+      for (size_t w = i * task_size; w < end; w++) {
+        for (auto word = words[w]; word != 0; word &= word - 1) {
+          vid_map[(w << 6) + __builtin_ctzll(word)] = rank++;
+        }
+      }
+    });
+  }
+  thread_pool->SubmitSync(task_package);
+  return base[parallelism];
+}
 
 // @DESCRIPTION: convert a edgelist graph from csv file to binary file. Here the
 // compression operations is default in ConvertEdgelist.
+//
+// The CSV file is streamed through CSVEdgeReader in chunks parsed in
+// parallel, and the edges other than self loops are spilled to
+// edgelist.spill.bin in output_path. The spilled edges are then read back
+// in parallel twice, to mark the IDs in use and to write them compressed to
+// edgelist.bin. Compressed IDs keep the order of the input IDs. The memory
+// used is bounded by the chunks in flight and O(max_vid), not by the number
+// of edges.
 // @PARAMETER: input_path and output_path indicates the input and output path
 // respectively, sep determines the separator for the csv file, read_head
 // indicates whether to read head.
@@ -64,108 +169,103 @@ void ConvertEdgelistCSV2EdgelistBin(const std::string& input_path,
   LOG_INFO("ConvertEdgelistCSV2EdgelistBin");
   auto parallelism = std::thread::hardware_concurrency();
   auto thread_pool = sics::graph::core::common::ThreadPool(parallelism);
-  auto task_package = TaskPackage();
-  task_package.reserve(parallelism);
+  size_t chunk_size = FLAGS_read_chunk_size << 20;
+  size_t chunk_edges = chunk_size / sizeof(Edge);
 
   if (!exists(output_path)) create_directory(output_path);
-  std::ifstream in_file(input_path);
-  if (!in_file) LOG_FATAL("File not found!");
-  std::ofstream out_data_file(output_path + "edgelist.bin");
-  std::ofstream out_meta_file(output_path + "meta.yaml");
-
-  in_file.seekg(0, std::ios::end);
-  size_t length = in_file.tellg();
-  in_file.seekg(0, std::ios::beg);
-
-  char* buff = new char[length]();
-  in_file.read(buff, length);
-  std::string content(buff, length);
-
-  EdgeIndex n_edges = count(content.begin(), content.end(), '\n');
-  auto buffer_edges = new VertexID[n_edges * 2]();
-  std::stringstream ss(content);
-  delete[] buff;
-
-  EdgeIndex index = 0;
-  VertexID max_vid = 0;
-  std::string line, vid_str;
-  if (read_head) getline(ss, line, '\n');
-  while (getline(ss, line, '\n')) {
-    if (*line.c_str() == '\0') break;
-    std::stringstream ss_line(line);
-    while (getline(ss_line, vid_str, *sep.c_str())) {
-      VertexID vid = stoll(vid_str);
-      sics::graph::core::util::atomic::WriteMax(&max_vid, vid);
-      buffer_edges[index++] = vid;
+  auto spill_path = output_path + "edgelist.spill.bin";
+  auto data_path = output_path + "edgelist.bin";
+
+  // Parse the CSV file, dropping self loops.
+  CSVEdgeReader reader(input_path, *sep.c_str(), read_head, chunk_size);
+  std::ofstream spill_file(spill_path, std::ios::binary);
+  if (!spill_file) LOG_FATAL("Open file failed: " + spill_path);
+  EdgeIndex n_edges = 0;
+  reader.Read(&thread_pool, [&](Edge* edges, size_t size) {
+    size_t kept = 0;
+    for (size_t i = 0; i < size; i++) {
+      if (edges[i].src != edges[i].dst) edges[kept++] = edges[i];
     }
-  }
-  content.clear();
-  in_file.close();
-
-  auto buffer_edges_compact = new VertexID[n_edges * 2]();
-  auto aligned_max_vid = (((max_vid + 1) >> 6) << 6) + 64;
-  auto vid_map = new VertexID[aligned_max_vid]();
+    spill_file.write(reinterpret_cast<char*>(edges), sizeof(Edge) * kept);
+    n_edges += kept;
+  });
+  spill_file.close();
+  LOGF_INFO("Read {} edges, {} without self loops", reader.get_num_edges(),
+            n_edges);
+
+  // Mark the IDs in use, and count in-degrees for hot vertex renumbering.
+  auto max_vid = reader.get_max_vid();
+  VertexID aligned_max_vid = (((max_vid + 1) >> 6) << 6) + 64;
   Bitmap bitmap(aligned_max_vid);
-  index = 0;
-  for (unsigned int i = 0; i < parallelism; i++) {
-    auto task = std::bind([&, i, parallelism]() {
-      for (EdgeIndex j = i; j < n_edges; j += parallelism) {
-        if (buffer_edges[j * 2] == buffer_edges[j * 2 + 1]) continue;
-        auto local_index = __sync_fetch_and_add(&index, 1);
-        bitmap.SetBit(local_index);
-        buffer_edges_compact[local_index * 2] = buffer_edges[j * 2];
-        buffer_edges_compact[local_index * 2 + 1] = buffer_edges[j * 2 + 1];
-      }
-    });
-    task_package.push_back(task);
-  }
-  thread_pool.SubmitSync(task_package);
-  task_package.clear();
-  auto compacted_n_edges = index;
+  bool renumber_hot = FLAGS_hot_vertices != 0 && !FLAGS_not_reorder_vertices;
+  std::vector<VertexID> in_degree(renumber_hot ? aligned_max_vid : 0, 0);
+  ForEachEdgeChunk(spill_path, n_edges, chunk_edges, &thread_pool,
+                   [&](EdgeIndex, Edge* edges, size_t size) {
+                     for (size_t i = 0; i < size; i++) {
+                       bitmap.SetBit(edges[i].src);
+                       bitmap.SetBit(edges[i].dst);
+                       if (renumber_hot) {
+                         WriteAdd(&in_degree[edges[i].dst], (VertexID)1);
+                       }
+                     }
+                   });
+  VertexID num_vertices = bitmap.Count();
 
-  bitmap.Clear();
-  VertexID compressed_vid = 0;
-  for (index = 0; index < n_edges * 2; index++) {
-    if (!bitmap.GetBit(buffer_edges_compact[index])) {
-      bitmap.SetBit(buffer_edges_compact[index]);
-      vid_map[buffer_edges_compact[index]] = compressed_vid++;
+  YAML::Node node;
+  node["EdgelistBin"]["num_vertices"] = num_vertices;
+  node["EdgelistBin"]["num_edges"] = n_edges;
+  if (FLAGS_not_reorder_vertices) {
+    std::filesystem::rename(spill_path, data_path);
+    node["EdgelistBin"]["max_vid"] = max_vid;
+  } else {
+    std::vector<VertexID> vid_map(aligned_max_vid);
+    CompressVertexIDs(bitmap, aligned_max_vid, vid_map.data(), &thread_pool);
+    if (renumber_hot) {
+      LOG_INFO("RenumberHotVertices");
+      std::vector<VertexID> compressed_in_degree(num_vertices);
+      std::vector<VertexID> compressed2input(num_vertices);
+      for (VertexID vid = 0; vid < aligned_max_vid; vid++) {
+        if (!bitmap.GetBit(vid)) continue;
+        compressed_in_degree[vid_map[vid]] = in_degree[vid];
+        compressed2input[vid_map[vid]] = vid;
+      }
+      auto new2old =
+          GetHotVertexPermutation(compressed_in_degree, FLAGS_hot_vertices);
+      std::vector<VertexID> old2new(num_vertices);
+      for (VertexID vid = 0; vid < num_vertices; vid++) {
+        old2new[new2old[vid]] = vid;
+        new2old[vid] = compressed2input[new2old[vid]];
+      }
+      for (VertexID vid = 0; vid < aligned_max_vid; vid++) {
+        if (bitmap.GetBit(vid)) vid_map[vid] = old2new[vid_map[vid]];
+      }
+      WritePermutation(output_path + "vid_map.bin", new2old);
     }
-  }
 
-  auto buffer_edges_minimized_max_vid = new VertexID[n_edges * 2]();
-  // Compress vid and buffer graph.
-  for (unsigned int i = 0; i < parallelism; i++) {
-    auto task = std::bind([&, i, parallelism]() {
-      for (EdgeIndex j = i; j < n_edges * 2; j += parallelism) {
-        buffer_edges_minimized_max_vid[j] = vid_map[buffer_edges_compact[j]];
-      }
-    });
-    task_package.push_back(task);
+    // Write the compressed edges at the offsets of the spilled ones.
+    int out_fd = open(data_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) LOG_FATAL("Open file failed: " + data_path);
+    ForEachEdgeChunk(
+        spill_path, n_edges, chunk_edges, &thread_pool,
+        [&](EdgeIndex first, Edge* edges, size_t size) {
+          for (size_t i = 0; i < size; i++) {
+            edges[i].src = vid_map[edges[i].src];
+            edges[i].dst = vid_map[edges[i].dst];
+          }
+          auto bytes = sizeof(Edge) * size;
+          if (pwrite(out_fd, edges, bytes, sizeof(Edge) * first) !=
+              (ssize_t)bytes) {
+            LOG_FATAL("Write file failed: " + data_path);
+          }
+        });
+    close(out_fd);
+    std::filesystem::remove(spill_path);
+    node["EdgelistBin"]["max_vid"] = num_vertices - 1;
   }
-  thread_pool.SubmitSync(task_package);
-  task_package.clear();
-
-  // Write binary edgelist
-  if (FLAGS_not_reorder_vertices)
-    out_data_file.write(reinterpret_cast<char*>(buffer_edges),
-                        sizeof(VertexID) * 2 * compacted_n_edges);
-  else
-    out_data_file.write(reinterpret_cast<char*>(buffer_edges_minimized_max_vid),
-                        sizeof(VertexID) * 2 * compacted_n_edges);
-  delete[] vid_map;
-  delete[] buffer_edges;
-  delete[] buffer_edges_minimized_max_vid;
-  delete[] buffer_edges_compact;
 
   // Write Meta date.
-  YAML::Node node;
-  node["EdgelistBin"]["num_vertices"] = bitmap.Count();
-  node["EdgelistBin"]["num_edges"] = compacted_n_edges;
-  node["EdgelistBin"]["max_vid"] = compressed_vid - 1;
+  std::ofstream out_meta_file(output_path + "meta.yaml");
   out_meta_file << node << std::endl;
-
-  // delete bitmap;
-  out_data_file.close();
   out_meta_file.close();
 }
 
@@ -255,6 +355,12 @@ void BigGraphConvertEdgelistCSV2EdgelistBin(const std::string& input_path,
   thread_pool.SubmitSync(task_package);
   task_package.clear();
 
+  if (FLAGS_hot_vertices != 0 && !FLAGS_not_reorder_vertices)
+    RenumberHotVertices(output_path, FLAGS_hot_vertices,
+                        buffer_edges_minimized_max_vid, compacted_n_edges,
+                        compressed_vid, vid_map, bitmap, aligned_max_vid,
+                        &thread_pool);
+
   // Write binary edgelist
   if (FLAGS_not_reorder_vertices)
     out_data_file.write(reinterpret_cast<char*>(buffer_edges),
@@ -326,6 +432,86 @@ void ConvertEdgelistBin2CSRBin(const std::string& input_path,
                                        store_strategy);
 }
 
+// @DESCRIPTION: relabel a binary edgelist graph for cache locality and convert
+// it to binary CSR.
+// @PARAMETER: input_path and output_path indicates the input and output path
+// respectively. reorder_strategy selects the vertex ordering, store_strategy
+// is the same as in ConvertEdgelistBin2CSRBin. permutation.bin is written to
+// output_path, holding the input ID of every new vertex ID.
+void ReorderEdgelistBin2CSRBin(const std::string& input_path,
+                               const std::string& output_path,
+                               const ReorderStrategy reorder_strategy,
+                               const StoreStrategy store_strategy) {
+  LOG_INFO("ReorderEdgelistBin2CSRBin");
+  if (reorder_strategy == kUndefinedReorder)
+    LOG_FATAL("Error reorder strategy.");
+  auto parallelism = std::thread::hardware_concurrency();
+  auto thread_pool = sics::graph::core::common::ThreadPool(parallelism);
+
+  YAML::Node node = YAML::LoadFile(input_path + "meta.yaml");
+  EdgelistMetadata edgelist_metadata = {
+      node["EdgelistBin"]["num_vertices"].as<VertexID>(),
+      node["EdgelistBin"]["num_edges"].as<EdgeIndex>(),
+      node["EdgelistBin"]["max_vid"].as<VertexID>()};
+
+  auto buffer_edges = new Edge[edgelist_metadata.num_edges]();
+  std::ifstream in_file(input_path + "edgelist.bin");
+  if (!in_file) LOG_FATAL("Open file failed: " + input_path + "edgelist.bin");
+  in_file.read(reinterpret_cast<char*>(buffer_edges),
+               sizeof(Edge) * edgelist_metadata.num_edges);
+  in_file.close();
+  Edges edges(edgelist_metadata, buffer_edges);
+
+  // The permutation covers the whole ID space, so that on uncompressed IDs
+  // the graph and the permutation count the same vertices.
+  auto num_vertices = edgelist_metadata.max_vid + 1;
+  auto new2old = GetReorderPermutation(
+      reorder_strategy, edges.get_base_ptr(), edgelist_metadata.num_edges,
+      num_vertices, &thread_pool, FLAGS_gorder_window);
+  RelabelEdges(new2old, edges.get_base_ptr(), edgelist_metadata.num_edges,
+               &thread_pool);
+  edges.SortBySrc();
+
+  GraphMetadata graph_metadata;
+  graph_metadata.set_num_vertices(num_vertices);
+  graph_metadata.set_num_edges(edgelist_metadata.num_edges);
+  graph_metadata.set_max_vid(edgelist_metadata.max_vid);
+  graph_metadata.set_min_vid(0);
+  graph_metadata.set_num_subgraphs(1);
+
+  // Write the csr graph to disk
+  GraphFormatConverter graph_format_converter(output_path);
+  std::vector<Edges> edge_buckets;
+  edge_buckets.push_back(edges);
+  graph_format_converter.WriteSubgraph(edge_buckets, graph_metadata,
+                                       store_strategy);
+  WritePermutation(output_path + "permutation.bin", new2old);
+}
+
+// @DESCRIPTION: convert a binary edgelist graph to the block CSR layout of
+// the out-of-core engine, in external memory. See BuildBlockCSR.
+// @PARAMETER: input_path and output_path indicates the input and output path
+// respectively. The graph is cut into n_blocks blocks of about the same number
+// of edges, and sub-blocks of at most cut_v vertices, sized by a
+// SubBlockCostModel if sub_block_kb is set.
+void ConvertEdgelistBin2Blocks(const std::string& input_path,
+                               const std::string& output_path,
+                               uint32_t n_blocks) {
+  auto parallelism = std::thread::hardware_concurrency();
+  auto thread_pool = sics::graph::core::common::ThreadPool(parallelism);
+  BlockCSROptions options;
+  options.num_blocks = n_blocks;
+  options.cut_v = FLAGS_cut_v;
+  options.offset_ratio = FLAGS_offset_ratio;
+  options.sub_block_model.target_bytes = FLAGS_sub_block_kb << 10;
+  options.sub_block_model.min_bytes = FLAGS_min_sub_block_kb << 10;
+  options.sub_block_model.parallelism = parallelism;
+  options.sub_block_model.tasks_per_thread = FLAGS_tasks_per_thread;
+  options.memory_budget = FLAGS_memory_mb << 20;
+  options.chunk_size = FLAGS_read_chunk_size << 20;
+  BuildBlockCSR(input_path, output_path, options, &thread_pool);
+}
+
 int main(int argc, char** argv) {
   gflags::SetUsageMessage(
       "\n USAGE: graph-convert --convert_mode=[options] -i <input file path> "
@@ -336,7 +522,14 @@ int main(int argc, char** argv) {
       "\t edgelistcsv2csrbin:   - Convert edge list of txt format to binary "
       "csr\n"
       "\t edgelistbin2csrbin:   - Convert edge list of bin format to binary "
-      "csr\n");
+      "csr\n"
+      "\t reorder:   - Relabel a binary edge list for locality with "
+      "--reorder_strategy=[degreesort|hubcluster|rcm|gorder] and convert it "
+      "to binary csr\n"
+      "\t edgelistbin2blocks:   - Convert edge list of bin format to the "
+      "block csr of the out-of-core engine, in external memory\n"
+      " Use --hot_vertices=k with edgelistcsv2edgelistbin to renumber the "
+      "top-k in-degree vertices into [0, k).\n");
 
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   if (FLAGS_i == "" || FLAGS_o == "")
@@ -346,6 +539,10 @@ int main(int argc, char** argv) {
     case kEdgelistCSV2EdgelistBin:
       if (FLAGS_sep == "")
         LOG_FATAL("CSV separator is not empty. Use -sep [e.g. \",\"].");
+      // Hot vertices are renumbered after the IDs are compressed.
+      if (FLAGS_hot_vertices != 0 && FLAGS_not_reorder_vertices)
+        LOG_FATAL("--hot_vertices requires compressed vertex IDs, remove "
+                  "--not_reorder_vertices.");
       if (FLAGS_biggraph)
         BigGraphConvertEdgelistCSV2EdgelistBin(FLAGS_i, FLAGS_o, FLAGS_sep,
                                                FLAGS_n_edges, FLAGS_read_head);
@@ -360,6 +557,14 @@ int main(int argc, char** argv) {
       ConvertEdgelistBin2CSRBin(FLAGS_i, FLAGS_o,
                                 StoreStrategy2Enum(FLAGS_store_strategy));
       break;
+    case kReorder:
+      ReorderEdgelistBin2CSRBin(FLAGS_i, FLAGS_o,
+                                ReorderStrategy2Enum(FLAGS_reorder_strategy),
+                                StoreStrategy2Enum(FLAGS_store_strategy));
+      break;
+    case kEdgelistBin2Blocks:
+      ConvertEdgelistBin2Blocks(FLAGS_i, FLAGS_o, FLAGS_n_partitions);
+      break;
     default:
       LOG_FATAL("Error convert mode.");
   }
@@ -9,6 +9,7 @@
 #include "tools/graph_partitioner/partitioner/csr_based_planar_vertexcut.h"
 #include "tools/graph_partitioner/partitioner/hash_based_edgecut.h"
 #include "tools/graph_partitioner/partitioner/hash_based_vertexcut.h"
+#include "tools/graph_partitioner/partitioner/hybrid_cut.h"
 #include "tools/graph_partitioner/partitioner/two_dimensional_vertexcut.h"
 
 using sics::graph::tools::common::StoreStrategy2Enum;
@@ -22,6 +23,8 @@ using TwoDimensionalVertexCutPartitioner =
     sics::graph::tools::partitioner::TwoDimensionalVertexCutPartitioner;
 using BFSBasedEdgeCutPartitioner =
     sics::graph::tools::partitioner::BFSBasedEdgeCutPartitioner;
+using HybridCutPartitioner =
+    sics::graph::tools::partitioner::HybridCutPartitioner;
 
 enum Partitioner {
   kHashEdgeCut,  // default
@@ -61,6 +64,9 @@ DEFINE_string(store_strategy, "unconstrained",
               "graph-systems adopted three strategies to store edges: "
               "kUnconstrained, incoming, and outgoing.");
 DEFINE_bool(biggraph, false, "for big graphs.");
+DEFINE_uint32(hybrid_threshold, 100,
+              "degree above which the hybrid cut spreads the edges of a "
+              "vertex.");
 
 int main(int argc, char** argv) {
   gflags::SetUsageMessage(
@@ -115,9 +121,13 @@ int main(int argc, char** argv) {
       vertexcut_partitioner.RunPartitioner();
       break;
     }
-    case kHybridCut:
-      // TODO (hsaioko): Add HyrbidCut partitioner.
+    case kHybridCut: {
+      HybridCutPartitioner hybrid_cut_partitioner(
+          FLAGS_i, FLAGS_o, StoreStrategy2Enum(FLAGS_store_strategy),
+          FLAGS_n_partitions, FLAGS_hybrid_threshold);
+      hybrid_cut_partitioner.RunPartitioner();
       break;
+    }
     // TODO (bai-wenchao): BFSBasedEdgeCutPartitioner should able to deside the
     // number of partitions by itself (i.e., the only input is the memory
     // constraint).
@@ -0,0 +1,172 @@
+#include "tools/graph_partitioner/partitioner/hybrid_cut.h"
+
+#include <folly/hash/Hash.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/common/bitmap.h"
+#include "core/common/multithreading/thread_pool.h"
+#include "core/common/types.h"
+#include "core/util/atomic.h"
+#include "core/util/logging.h"
+#include "tools/common/data_structures.h"
+#include "tools/common/io.h"
+
+namespace sics::graph::tools::partitioner {
+
+using folly::hash::fnv64_append_byte;
+using sics::graph::core::common::Bitmap;
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::TaskPackage;
+using sics::graph::core::common::VertexID;
+using sics::graph::core::data_structures::GraphMetadata;
+using sics::graph::core::util::atomic::WriteAdd;
+using sics::graph::core::util::atomic::WriteMax;
+using sics::graph::core::util::atomic::WriteMin;
+using sics::graph::tools::common::Edge;
+using sics::graph::tools::common::EdgelistMetadata;
+using sics::graph::tools::common::Edges;
+using sics::graph::tools::common::GraphFormatConverter;
+using sics::graph::tools::common::kIncomingOnly;
+
+VertexID HybridCutPartitioner::GetBucketID(VertexID vid,
+                                           VertexID n_bucket) const {
+  return fnv64_append_byte(vid, 3) % n_bucket;
+}
+
+void HybridCutPartitioner::RunPartitioner() {
+  LOG_INFO("RunPartitioner");
+  auto parallelism = std::thread::hardware_concurrency();
+  auto thread_pool = sics::graph::core::common::ThreadPool(parallelism);
+  auto task_package = TaskPackage();
+  task_package.reserve(parallelism);
+
+  // Load Yaml node (Edgelist metadata).
+  YAML::Node input_node;
+  input_node = YAML::LoadFile(input_path_ + "meta.yaml");
+  auto edgelist_metadata = input_node["EdgelistBin"].as<EdgelistMetadata>();
+  auto num_edges = edgelist_metadata.num_edges;
+
+  // Create Edgelist Graph.
+  auto aligned_max_vid = (((edgelist_metadata.max_vid + 1) >> 6) << 6) + 64;
+  Bitmap vertices_visited(aligned_max_vid);
+  auto buffer_edges = new Edge[num_edges]();
+  std::ifstream input_stream(input_path_ + "edgelist.bin", std::ios::binary);
+  if (!input_stream.is_open()) LOG_FATAL("Cannot open edgelist.bin");
+  input_stream.read(reinterpret_cast<char*>(buffer_edges),
+                    sizeof(Edge) * num_edges);
+  input_stream.close();
+  Edges edges(edgelist_metadata, buffer_edges);
+
+  // Each thread works on a contiguous range of the edges, so that the edges
+  // of a bucket keep the order of the input.
+  EdgeIndex range = (num_edges + parallelism - 1) / parallelism;
+  auto for_each_range = [&](auto&& func) {
+    for (unsigned int i = 0; i < parallelism; i++) {
+      EdgeIndex begin = std::min(num_edges, i * range);
+      EdgeIndex end = std::min(num_edges, begin + range);
+      task_package.push_back(
+          [&func, i, begin, end]() { func(i, begin, end); });
+    }
+    thread_pool.SubmitSync(task_package);
+    task_package.clear();
+  };
+  bool by_dst = store_strategy_ == kIncomingOnly;
+  auto master = [by_dst](const Edge& e) { return by_dst ? e.dst : e.src; };
+  auto mirror = [by_dst](const Edge& e) { return by_dst ? e.src : e.dst; };
+
+  // Degree of the master endpoint of every edge.
+  auto degree = new VertexID[aligned_max_vid]();
+  VertexID max_vid = 0, min_vid = MAX_VERTEX_ID;
+  for_each_range([&](unsigned int, EdgeIndex begin, EdgeIndex end) {
+    VertexID local_max = 0, local_min = MAX_VERTEX_ID;
+    for (EdgeIndex j = begin; j < end; j++) {
+      auto e = edges.get_edge_by_index(j);
+      vertices_visited.SetBit(e.src);
+      vertices_visited.SetBit(e.dst);
+      WriteAdd(degree + master(e), (VertexID)1);
+      local_max = std::max({local_max, e.src, e.dst});
+      local_min = std::min({local_min, e.src, e.dst});
+    }
+    WriteMax(&max_vid, local_max);
+    WriteMin(&min_vid, local_min);
+  });
+
+  auto get_bucket = [&](const Edge& e) {
+    auto v = degree[master(e)] > threshold_ ? mirror(e) : master(e);
+    return GetBucketID(v, n_partitions_);
+  };
+
+  // Count the edges of every bucket per thread, and the vertices the buckets
+  // hold.
+  std::vector<std::vector<EdgeIndex>> count(
+      parallelism, std::vector<EdgeIndex>(n_partitions_, 0));
+  std::vector<Bitmap> bitmap_vec;
+  bitmap_vec.resize(n_partitions_, aligned_max_vid);
+  auto max_vid_per_bucket = new VertexID[n_partitions_]();
+  for_each_range([&](unsigned int i, EdgeIndex begin, EdgeIndex end) {
+    for (EdgeIndex j = begin; j < end; j++) {
+      auto e = edges.get_edge_by_index(j);
+      auto bid = get_bucket(e);
+      count[i][bid]++;
+      bitmap_vec.at(bid).SetBit(e.src);
+      bitmap_vec.at(bid).SetBit(e.dst);
+      WriteMax(max_vid_per_bucket + bid, std::max(e.src, e.dst));
+    }
+  });
+
+  // Turn the counts into the offsets each thread writes its edges at.
+  std::vector<Edges> edge_buckets;
+  edge_buckets.reserve(n_partitions_);
+  for (GraphID bid = 0; bid < n_partitions_; bid++) {
+    EdgeIndex size = 0;
+    for (unsigned int i = 0; i < parallelism; i++) {
+      auto c = count[i][bid];
+      count[i][bid] = size;
+      size += c;
+    }
+    EdgelistMetadata bucket_metadata = {
+        (VertexID)bitmap_vec.at(bid).Count(), size, max_vid_per_bucket[bid]};
+    edge_buckets.emplace_back(Edges(bucket_metadata));
+  }
+  delete[] max_vid_per_bucket;
+
+  for_each_range([&](unsigned int i, EdgeIndex begin, EdgeIndex end) {
+    for (EdgeIndex j = begin; j < end; j++) {
+      auto e = edges.get_edge_by_index(j);
+      auto bid = get_bucket(e);
+      edge_buckets[bid].get_base_ptr()[count[i][bid]++] = e;
+    }
+  });
+
+  VertexID num_hubs = 0;
+  for (VertexID v = 0; v < aligned_max_vid; v++) {
+    if (degree[v] > threshold_) num_hubs++;
+  }
+  delete[] degree;
+  size_t num_replicas = 0;
+  for (auto& bitmap : bitmap_vec) num_replicas += bitmap.Count();
+  auto num_vertices = vertices_visited.Count();
+  LOGF_INFO("Hybrid cut: {} hubs of degree > {}, replication factor {}",
+            num_hubs, threshold_,
+            num_vertices == 0 ? 0.0 : (double)num_replicas / num_vertices);
+
+  // Write the subgraphs to disk
+  GraphFormatConverter graph_format_converter(output_path_);
+  GraphMetadata graph_metadata;
+  graph_metadata.set_num_vertices(num_vertices);
+  graph_metadata.set_num_edges(num_edges);
+  graph_metadata.set_num_subgraphs(n_partitions_);
+  graph_metadata.set_max_vid(max_vid);
+  graph_metadata.set_min_vid(min_vid);
+
+  LOG_INFO("Writing the subgraphs to disk");
+  graph_format_converter.WriteSubgraph(edge_buckets, graph_metadata,
+                                       store_strategy_);
+  LOG_INFO("Finished writing the subgraphs to disk");
+}
+
+}  // namespace sics::graph::tools::partitioner
@@ -0,0 +1,57 @@
+#ifndef SICS_GRAPH_SYSTEMS_TOOLS_HYBRID_CUT_PARTITIONER_H_
+#define SICS_GRAPH_SYSTEMS_TOOLS_HYBRID_CUT_PARTITIONER_H_
+
+#include "core/common/types.h"
+#include "tools/graph_partitioner/partitioner/partitioner_base.h"
+
+namespace sics::graph::tools::partitioner {
+
+// @DESCRIPTION Hybrid-cut partitioning differentiates low-degree and
+// high-degree vertices of a power-law graph. The edges of a low-degree vertex
+// are all placed in the bucket of the vertex, as an edge-cut would do, so that
+// the vertex is not replicated. The edges of a high-degree vertex (a hub, whose
+// degree exceeds threshold) are spread over the buckets of their other
+// endpoints, as a vertex-cut would do, so that hubs do not unbalance the
+// buckets and are replicated at most n_partitions times, while the low-degree
+// vertices around them are not.
+//
+// The degree is the out degree and the bucket is the one of the source, or the
+// in degree and the destination for kIncomingOnly. Subgraphs are written as
+// the other vertex-cut partitioners write them, with the border vertices
+// shared by several subgraphs.
+// @EXAMPLE
+//  HybridCutPartitioner hybrid_cut_partitioner(
+//     FLAGS_i, FLAGS_o, StoreStrategy2Enum(FLAGS_store_strategy),
+//     FLAGS_n_partitions, FLAGS_hybrid_threshold);
+//  hybrid_cut_partitioner.RunPartitioner();
+// @REFERENCE
+// Rong Chen, Jiaxin Shi, Yanzhe Chen, and Haibo Chen. 2015. PowerLyra:
+// Differentiated Graph Computation and Partitioning on Skewed Graphs. In
+// EuroSys '15.
+class HybridCutPartitioner : public PartitionerBase {
+ private:
+  using StoreStrategy = sics::graph::tools::common::StoreStrategy;
+  using VertexID = sics::graph::core::common::VertexID;
+  using GraphID = sics::graph::core::common::GraphID;
+
+ public:
+  HybridCutPartitioner(const std::string& input_path,
+                       const std::string& output_path,
+                       StoreStrategy store_strategy, GraphID n_partitions,
+                       VertexID threshold = 100)
+      : PartitionerBase(input_path, output_path, store_strategy),
+        n_partitions_(n_partitions),
+        threshold_(threshold) {}
+
+  void RunPartitioner() override;
+
+ private:
+  GraphID n_partitions_;
+  VertexID threshold_;
+
+  VertexID GetBucketID(VertexID vid, VertexID n_bucket) const;
+};
+
+}  // namespace sics::graph::tools::partitioner
+
+#endif  // SICS_GRAPH_SYSTEMS_TOOLS_HYBRID_CUT_PARTITIONER_H_
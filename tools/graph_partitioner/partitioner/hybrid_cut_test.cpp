@@ -0,0 +1,106 @@
+#include "tools/graph_partitioner/partitioner/hybrid_cut.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "core/common/types.h"
+#include "tools/common/data_structures.h"
+#include "tools/common/types.h"
+
+namespace sics::graph::tools::partitioner {
+
+using sics::graph::core::common::EdgeIndex;
+using sics::graph::core::common::GraphID;
+using sics::graph::core::common::VertexID;
+using sics::graph::tools::common::Edge;
+
+// The fixture for testing the hybrid-cut partitioner.
+class HybridCutTest : public ::testing::Test {
+ protected:
+  HybridCutTest() {
+    std::filesystem::create_directories(input_path_);
+    std::filesystem::create_directories(output_path_ + "dependency_matrix");
+  }
+
+  ~HybridCutTest() override { std::filesystem::remove_all(root_); }
+
+  void WriteEdgelist(const std::vector<Edge>& edges, VertexID max_vid) {
+    std::ofstream data(input_path_ + "edgelist.bin", std::ios::binary);
+    data.write((char*)edges.data(), edges.size() * sizeof(Edge));
+    YAML::Node node;
+    node["EdgelistBin"]["num_vertices"] = max_vid + 1;
+    node["EdgelistBin"]["num_edges"] = edges.size();
+    node["EdgelistBin"]["max_vid"] = max_vid;
+    std::ofstream meta(input_path_ + "meta.yaml");
+    meta << node << std::endl;
+  }
+
+  // Out degree of every vertex in every subgraph written.
+  std::vector<std::vector<VertexID>> ReadOutDegrees(VertexID num_vertices) {
+    auto meta = YAML::LoadFile(output_path_ + "meta.yaml")["GraphMetadata"];
+    std::vector<std::vector<VertexID>> out_degrees;
+    for (auto subgraph : meta["subgraphs"]) {
+      auto gid = subgraph["gid"].as<GraphID>();
+      auto n = subgraph["num_vertices"].as<VertexID>();
+      std::vector<VertexID> ids(n), degree(n);
+      std::ifstream file(output_path_ + "graphs/" + std::to_string(gid) +
+                             ".bin",
+                         std::ios::binary);
+      file.read((char*)ids.data(), n * sizeof(VertexID));
+      file.read((char*)degree.data(), n * sizeof(VertexID));
+      EXPECT_TRUE(file.good());
+      out_degrees.emplace_back(num_vertices, 0);
+      for (VertexID i = 0; i < n; i++) out_degrees.back()[ids[i]] = degree[i];
+    }
+    return out_degrees;
+  }
+
+  std::string root_ = std::filesystem::temp_directory_path().string() +
+                      "/hybrid_cut_test_" + std::to_string(getpid());
+  std::string input_path_ = root_ + "/in/";
+  std::string output_path_ = root_ + "/out/";
+};
+
+TEST_F(HybridCutTest, HubsAreSpreadAndOthersKept) {
+  // Vertex 0 is a hub pointing to every other vertex, which point to the
+  // next two.
+  VertexID num_vertices = 64;
+  std::vector<Edge> edges;
+  for (VertexID v = 1; v < num_vertices; v++) {
+    edges.emplace_back(0, v);
+    edges.emplace_back(v, (v + 1) % num_vertices);
+    edges.emplace_back(v, (v + 2) % num_vertices);
+  }
+  WriteEdgelist(edges, num_vertices - 1);
+
+  HybridCutPartitioner partitioner(input_path_, output_path_,
+                                   common::kOutgoingOnly, 4, 8);
+  partitioner.RunPartitioner();
+
+  auto out_degrees = ReadOutDegrees(num_vertices);
+  ASSERT_EQ(out_degrees.size(), 4);
+  EdgeIndex num_edges = 0;
+  GraphID hub_subgraphs = 0;
+  for (auto& degree : out_degrees) {
+    for (auto d : degree) num_edges += d;
+    if (degree[0] > 0) hub_subgraphs++;
+  }
+  EXPECT_EQ(num_edges, edges.size());
+  EXPECT_GT(hub_subgraphs, 1);
+  for (VertexID v = 1; v < num_vertices; v++) {
+    GraphID owners = 0;
+    for (auto& degree : out_degrees) {
+      if (degree[v] == 0) continue;
+      owners++;
+      EXPECT_EQ(degree[v], 2);
+    }
+    EXPECT_EQ(owners, 1);
+  }
+}
+
+}  // namespace sics::graph::tools::partitioner